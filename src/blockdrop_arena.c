@@ -0,0 +1,146 @@
+//==============================================================================
+//
+// Title:       blockdrop_arena.c
+// Purpose:     Bump arena for search scratch state.
+//
+//              An arena takes all of its memory in one allocation when it is
+//              created and never grows, so memory stays bounded and nothing is
+//              allocated or freed while a search runs. An allocation that does
+//              not fit returns NULL and is counted as failed.
+//
+//              The arena hands out memory by moving one offset forward.
+//              ArenaMark() remembers the offset and ArenaRelease() moves it
+//              back, which frees everything allocated since in one step, e.g.
+//              the scratch of a search node when it returns.
+//
+//              It takes no locks: every thread owns its own arena.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_arena.h"
+
+//==============================================================================
+// Constants
+
+#define ALIGN_UP(size)          (((size) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+//==============================================================================
+// Types
+
+struct arenaData
+{
+    char *base;
+    char *memory;               // As returned by malloc (), base is aligned within it
+    size_t size;
+    size_t used;
+    size_t high_water;
+    long long failed;
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void *ArenaAlloc (arenaData *arena, size_t size)
+{
+    void *object = NULL;
+
+    size = ALIGN_UP (size);
+    if (size > arena->size - arena->used)
+    {
+        arena->failed++;
+        return NULL;
+    }
+
+    object = arena->base + arena->used;
+    arena->used += size;
+    if (arena->used > arena->high_water)
+    {
+        arena->high_water = arena->used;
+    }
+
+    return object;
+
+}  // End of ArenaAlloc()
+
+
+int ArenaCreate (size_t size, arenaData **arena)
+{
+    arenaData *newArena = NULL;
+
+    *arena = NULL;
+
+    newArena = calloc (1, sizeof (arenaData));
+    if (newArena == NULL)
+    {
+        return -1;
+    }
+
+    newArena->size = ALIGN_UP (size);
+    newArena->memory = malloc (newArena->size + ARENA_ALIGNMENT);
+    if (newArena->memory == NULL)
+    {
+        free (newArena);
+        return -1;
+    }
+    newArena->base = (char *)ALIGN_UP ((uintptr_t)newArena->memory);
+
+    *arena = newArena;
+
+    return 0;
+
+}  // End of ArenaCreate()
+
+
+void ArenaDiscard (arenaData *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    free (arena->memory);
+    free (arena);
+
+}  // End of ArenaDiscard()
+
+
+void ArenaGetStats (const arenaData *arena, arenaStats *stats)
+{
+    stats->size = arena->size;
+    stats->used = arena->used;
+    stats->high_water = arena->high_water;
+    stats->failed = arena->failed;
+
+}  // End of ArenaGetStats()
+
+
+size_t ArenaMark (const arenaData *arena)
+{
+    return arena->used;
+
+}  // End of ArenaMark()
+
+
+void ArenaRelease (arenaData *arena, size_t mark)
+{
+    // Marks taken after this one are released along with it
+    if (mark < arena->used)
+    {
+        arena->used = mark;
+    }
+
+}  // End of ArenaRelease()
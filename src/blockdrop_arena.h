@@ -0,0 +1,62 @@
+//==============================================================================
+//
+// Title:       blockdrop_arena.h
+// Purpose:     Bump arena for search scratch state.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_arena_H__
+#define __blockdrop_arena_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define ARENA_ALIGNMENT         16      // Bytes, every allocation starts on a multiple
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    size_t size;                // Bytes
+    size_t used;
+    size_t high_water;          // Most bytes in use at once since ArenaCreate()
+    long long failed;           // Allocations that did not fit
+} arenaStats;
+
+typedef struct arenaData arenaData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void *ArenaAlloc (arenaData *arena, size_t size);
+
+int ArenaCreate (size_t size, arenaData **arena);
+
+void ArenaDiscard (arenaData *arena);
+
+void ArenaGetStats (const arenaData *arena, arenaStats *stats);
+
+size_t ArenaMark (const arenaData *arena);
+
+void ArenaRelease (arenaData *arena, size_t mark);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_arena_H__ */
@@ -0,0 +1,606 @@
+//==============================================================================
+//
+// Title:       blockdrop_bench.c
+// Purpose:     Micro-benchmarks of the engine hot paths.
+//
+//              Every benchmark repeats one engine call over a set of
+//              BENCH_NUM_POSITIONS positions taken from greedy games, so the
+//              branches see real boards instead of one that is learned after
+//              a few calls. A sample is calibrated to config->sample_seconds,
+//              warm-up samples run first, and the thread can be pinned to one
+//              processor at a raised priority to keep other work off it.
+//
+//              Times come from QueryPerformanceCounter(). Cycles come from the
+//              time stamp counter where the compiler exposes it, otherwise
+//              they are reported as 0.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_bench.h"
+#include "blockdrop_arena.h"
+#include "blockdrop_columns.h"
+
+//==============================================================================
+// Constants
+
+#define BENCH_NUM_POSITIONS     256     // Power of two
+#define BENCH_MAX_ITERATIONS    (1LL << 30)
+
+#if (defined (__clang__) || defined (__GNUC__)) && (defined (__x86_64__) || defined (__i386__))
+    #define READ_CYCLES()       __builtin_ia32_rdtsc ()
+    #define HAVE_CYCLES         1
+#else
+    #define READ_CYCLES()       0ULL
+    #define HAVE_CYCLES         0
+#endif
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    boardData boards[BENCH_NUM_POSITIONS];
+    pieceData pieces[BENCH_NUM_POSITIONS];          // Spawned block on each board
+    columnData columns[BENCH_NUM_POSITIONS];        // Column view of each board
+    gameData games[BENCH_NUM_POSITIONS];
+    boardData clears[NUM_SQUARES_PER_BLOCK][BENCH_NUM_POSITIONS];   // A vertical I clears 1 to 4 lines
+    pieceData rotations[BENCH_NUM_POSITIONS];       // Current rotation benchmark
+    arenaData *arena;                               // Scratch board, see BenchArena()
+    volatile unsigned long long sink;               // Keeps results from being optimized away
+} benchContext;
+
+typedef void (*benchFunction) (benchContext *context, long long iterations, int arg);
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void BenchArena (benchContext *context, long long iterations, int arg);
+
+static void BenchColumnsDropDistance (benchContext *context, long long iterations, int arg);
+
+static void BenchColumnsEvaluate (benchContext *context, long long iterations, int arg);
+
+static void BenchDropDistance (benchContext *context, long long iterations, int arg);
+
+static void BenchEvaluate (benchContext *context, long long iterations, int arg);
+
+static void BenchHash (benchContext *context, long long iterations, int arg);
+
+static void BenchLineClear (benchContext *context, long long iterations, int arg);
+
+static void BenchRotate (benchContext *context, long long iterations, int arg);
+
+static void BenchSpawn (benchContext *context, long long iterations, int arg);
+
+static void BenchTranslate (benchContext *context, long long iterations, int arg);
+
+static void BenchTranspose (benchContext *context, long long iterations, int arg);
+
+static int CompareDoubles (const void *a, const void *b);
+
+static double Percentile (const double sorted[], int count, double fraction);
+
+static void PreparePositions (benchContext *context);
+
+static void RunBenchmark (const benchConfig *config, benchContext *context, const char *name, benchFunction function,
+                          int arg, benchResult *result);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void BenchDefaultConfig (benchConfig *config)
+{
+    memset (config, 0, sizeof (benchConfig));
+
+    config->num_samples = 101;
+    config->warmup_samples = 10;
+    config->sample_seconds = 0.0002;
+    config->cpu = 0;
+
+}  // End of BenchDefaultConfig()
+
+
+int BenchRunAll (const benchConfig *config, benchResult results[], int max_results)
+{
+    benchContext *context = NULL;
+    int direction = 0;
+    int ii = 0;  // Loop iterator
+    char name[BENCH_NAME_SIZE] = "\0";
+    int numResults = 0;
+    int orientation = 0;
+    HANDLE thread = GetCurrentThread ();
+    DWORD_PTR oldAffinity = 0;
+    int oldPriority = GetThreadPriority (thread);
+    pieceData piece = {0};
+    int type_index = 0;
+
+    if ((config->num_samples < 1) || (config->num_samples > BENCH_MAX_SAMPLES) || (config->sample_seconds <= 0.0))
+    {
+        return -1;
+    }
+
+    context = calloc (1, sizeof (benchContext));
+    if (context == NULL)
+    {
+        return -1;
+    }
+    PreparePositions (context);
+
+    if (config->cpu >= 0)
+    {
+        oldAffinity = SetThreadAffinityMask (thread, (DWORD_PTR)1 << config->cpu);
+        SetThreadPriority (thread, THREAD_PRIORITY_HIGHEST);
+    }
+
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "spawn", BenchSpawn, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "translate", BenchTranslate, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "drop_distance", BenchDropDistance, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "columns_drop_distance", BenchColumnsDropDistance, 0, &results[numResults++]);
+    }
+
+    for (ii=1; (ii <= NUM_SQUARES_PER_BLOCK) && (numResults < max_results); ii++)
+    {
+        sprintf (name, "line_clear_%d", ii);
+        RunBenchmark (config, context, name, BenchLineClear, ii, &results[numResults++]);
+    }
+
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "board_hash", BenchHash, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "board_evaluate", BenchEvaluate, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "columns_evaluate", BenchColumnsEvaluate, 0, &results[numResults++]);
+    }
+    if (numResults < max_results)
+    {
+        RunBenchmark (config, context, "columns_transpose", BenchTranspose, 0, &results[numResults++]);
+    }
+
+    // A scratch board the way search code gets one, for comparison with the calls above
+    if ((numResults < max_results) && (ArenaCreate (sizeof (boardData), &context->arena) == 0))
+    {
+        RunBenchmark (config, context, "arena_board", BenchArena, 0, &results[numResults++]);
+    }
+
+    // Every distinct orientation of every block, both ways, high on each board
+    for (type_index=0; type_index<NUM_BLOCKS_TYPES; type_index++)
+    {
+        PieceSpawn (type_index, &piece);
+        for (orientation=0; orientation<NUM_ORIENTATIONS; orientation++)
+        {
+            for (direction=ROTATE_CW; (direction <= ROTATE_CCW) && (numResults < max_results); direction++)
+            {
+                for (ii=0; ii<BENCH_NUM_POSITIONS; ii++)
+                {
+                    context->rotations[ii] = piece;
+                }
+
+                sprintf (name, "rotate_%c%d_%s", PieceBlockType (type_index), orientation + 1,
+                         (direction == ROTATE_CW) ? "cw" : "ccw");
+                RunBenchmark (config, context, name, BenchRotate, direction, &results[numResults++]);
+            }
+
+            // Orientations repeat once the rotation comes back to the spawn one
+            if ((PieceRotateShape (&piece, ROTATE_CW) == 0) || (piece.orientation == 0))
+            {
+                break;
+            }
+        }
+    }
+
+    if (config->cpu >= 0)
+    {
+        SetThreadPriority (thread, oldPriority);
+        if (oldAffinity != 0)
+        {
+            SetThreadAffinityMask (thread, oldAffinity);
+        }
+    }
+
+    ArenaDiscard (context->arena);
+    free (context);
+
+    return numResults;
+
+}  // End of BenchRunAll()
+
+
+int BenchWriteJson (const char *path, const benchConfig *config, const benchResult results[], int num_results)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf (file, "{\n");
+    fprintf (file, "  \"timer\": \"QueryPerformanceCounter\",\n");
+    fprintf (file, "  \"cycles\": %s,\n", HAVE_CYCLES ? "true" : "false");
+    fprintf (file, "  \"cpu\": %d,\n", config->cpu);
+    fprintf (file, "  \"samples\": %d,\n", config->num_samples);
+    fprintf (file, "  \"benchmarks\": [\n");
+
+    for (ii=0; ii<num_results; ii++)
+    {
+        fprintf (file, "    {\"name\": \"%s\", \"iterations\": %lld, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+                 "\"q1_ns\": %.3f, \"q3_ns\": %.3f, \"iqr_ns\": %.3f, \"median_cycles\": %.1f}%s\n",
+                 results[ii].name, results[ii].iterations, results[ii].median_ns, results[ii].p99_ns,
+                 results[ii].q1_ns, results[ii].q3_ns, results[ii].iqr_ns, results[ii].median_cycles,
+                 (ii < num_results - 1) ? "," : "");
+    }
+
+    fprintf (file, "  ]\n");
+    fprintf (file, "}\n");
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of BenchWriteJson()
+
+
+static void BenchArena (benchContext *context, long long iterations, int arg)
+{
+    boardData *board = NULL;
+    long long ii = 0;  // Loop iterator
+    size_t mark = 0;
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        mark = ArenaMark (context->arena);
+        board = ArenaAlloc (context->arena, sizeof (boardData));
+        *board = context->boards[ii & (BENCH_NUM_POSITIONS - 1)];
+        sum += board->rows[GRID_NUM_ROWS - 1];
+        ArenaRelease (context->arena, mark);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchArena()
+
+
+static void BenchColumnsDropDistance (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    int index = 0;
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        index = (int)(ii & (BENCH_NUM_POSITIONS - 1));
+        sum += ColumnsDropDistance (&context->columns[index], &context->pieces[index]);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchColumnsDropDistance()
+
+
+static void BenchColumnsEvaluate (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    double sum = 0.0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        sum += ColumnsEvaluate (&context->columns[ii & (BENCH_NUM_POSITIONS - 1)], 0, &g_defaultWeights);
+    }
+
+    context->sink += (unsigned long long)sum;
+
+}  // End of BenchColumnsEvaluate()
+
+
+static void BenchDropDistance (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    int index = 0;
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        index = (int)(ii & (BENCH_NUM_POSITIONS - 1));
+        sum += PieceDropDistance (&context->boards[index], &context->pieces[index]);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchDropDistance()
+
+
+static void BenchEvaluate (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    double sum = 0.0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        sum += BoardEvaluate (&context->boards[ii & (BENCH_NUM_POSITIONS - 1)], 0, &g_defaultWeights);
+    }
+
+    context->sink += (unsigned long long)sum;
+
+}  // End of BenchEvaluate()
+
+
+static void BenchHash (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        sum += BoardHash (&context->boards[ii & (BENCH_NUM_POSITIONS - 1)]);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchHash()
+
+
+static void BenchLineClear (benchContext *context, long long iterations, int arg)
+{
+    boardData board = {0};
+    long long ii = 0;  // Loop iterator
+    pieceData piece = {0, 1, GRID_NUM_COLS - 1, GRID_NUM_ROWS - NUM_SQUARES_PER_BLOCK};  // Vertical I
+    unsigned long long sum = 0;
+
+    // Includes copying the board, the lock changes it
+    for (ii=0; ii<iterations; ii++)
+    {
+        board = context->clears[arg-1][ii & (BENCH_NUM_POSITIONS - 1)];
+        sum += BoardLockPiece (&board, &piece);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchLineClear()
+
+
+static void BenchRotate (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    int index = 0;
+    pieceData piece = {0};
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        index = (int)(ii & (BENCH_NUM_POSITIONS - 1));
+        piece = context->rotations[index];
+        sum += PieceRotate (&context->boards[index], &piece, arg);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchRotate()
+
+
+static void BenchSpawn (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        sum += GameSpawnPiece (&context->games[ii & (BENCH_NUM_POSITIONS - 1)], FIRST_BLOCK_NO);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchSpawn()
+
+
+static void BenchTranslate (benchContext *context, long long iterations, int arg)
+{
+    long long ii = 0;  // Loop iterator
+    int index = 0;
+    pieceData piece = {0};
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        index = (int)(ii & (BENCH_NUM_POSITIONS - 1));
+        piece = context->pieces[index];
+        sum += PieceMove (&context->boards[index], &piece, (ii & 1) ? 1 : -1, 0);
+    }
+
+    context->sink += sum;
+
+}  // End of BenchTranslate()
+
+
+static void BenchTranspose (benchContext *context, long long iterations, int arg)
+{
+    columnData columns;
+    long long ii = 0;  // Loop iterator
+    unsigned long long sum = 0;
+
+    for (ii=0; ii<iterations; ii++)
+    {
+        ColumnsFromBoard (&context->boards[ii & (BENCH_NUM_POSITIONS - 1)], &columns);
+        sum += columns.cols[ii % GRID_NUM_COLS];
+    }
+
+    context->sink += sum;
+
+}  // End of BenchTranspose()
+
+
+static int CompareDoubles (const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+
+}  // End of CompareDoubles()
+
+
+static double Percentile (const double sorted[], int count, double fraction)
+{
+    int index = 0;
+    double position = fraction * (count - 1);
+
+    // Linear between the two closest ranks
+    index = (int)position;
+    if (index >= count - 1)
+    {
+        return sorted[count-1];
+    }
+
+    return sorted[index] + (position - index) * (sorted[index+1] - sorted[index]);
+
+}  // End of Percentile()
+
+
+static void PreparePositions (benchContext *context)
+{
+    gameData game;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    int numPieces = 0;
+    placementData placement = {0};
+    rngData rng;
+    unsigned short row = 0;
+
+    RngSeed (&rng, 1);
+
+    // Greedy games stopped after a random number of blocks
+    for (ii=0; ii<BENCH_NUM_POSITIONS; ii++)
+    {
+        GameReset (&game, ii + 1);
+        numPieces = RngRange (&rng, 80);
+        for (jj=0; (jj < numPieces) && (game.game_status == GAME_RUN); jj++)
+        {
+            ChooseGreedyPlacement (&game.board, game.piece.type_index, &g_defaultWeights, &placement);
+            GamePlace (&game, &placement);
+        }
+
+        if (game.game_status != GAME_RUN)
+        {
+            GameReset (&game, ii + 1);
+        }
+
+        context->games[ii] = game;
+        context->boards[ii] = game.board;
+        context->pieces[ii] = game.piece;
+        ColumnsFromBoard (&game.board, &context->columns[ii]);
+    }
+
+    // Bottom rows full but for the last column, the rows above that the I
+    // also reaches keep at least one more hole
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        for (jj=0; jj<BENCH_NUM_POSITIONS; jj++)
+        {
+            for (kk=0; kk<NUM_SQUARES_PER_BLOCK; kk++)
+            {
+                row = (unsigned short)(FULL_ROW_MASK & ~(1 << (GRID_NUM_COLS - 1)));
+                if (kk >= ii + 1)
+                {
+                    row &= (unsigned short)(RngNext (&rng) & ~(1 << RngRange (&rng, GRID_NUM_COLS - 1)));
+                }
+                context->clears[ii][jj].rows[GRID_NUM_ROWS-1-kk] = row;
+            }
+        }
+    }
+
+}  // End of PreparePositions()
+
+
+static void RunBenchmark (const benchConfig *config, benchContext *context, const char *name, benchFunction function,
+                          int arg, benchResult *result)
+{
+    LARGE_INTEGER end;
+    unsigned long long endCycles = 0;
+    LARGE_INTEGER frequency;
+    int ii = 0;  // Loop iterator
+    long long iterations = 1;
+    double seconds = 0.0;
+    double sorted[BENCH_MAX_SAMPLES];
+    LARGE_INTEGER start;
+    unsigned long long startCycles = 0;
+    double cycles[BENCH_MAX_SAMPLES];
+
+    memset (result, 0, sizeof (benchResult));
+    strncpy (result->name, name, BENCH_NAME_SIZE - 1);
+    QueryPerformanceFrequency (&frequency);
+
+    // Double the iterations until one sample is long enough to time
+    while (iterations < BENCH_MAX_ITERATIONS)
+    {
+        QueryPerformanceCounter (&start);
+        function (context, iterations, arg);
+        QueryPerformanceCounter (&end);
+
+        seconds = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+        if (seconds >= config->sample_seconds)
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    for (ii=0; ii<config->warmup_samples; ii++)
+    {
+        function (context, iterations, arg);
+    }
+
+    for (ii=0; ii<config->num_samples; ii++)
+    {
+        QueryPerformanceCounter (&start);
+        startCycles = READ_CYCLES ();
+        function (context, iterations, arg);
+        endCycles = READ_CYCLES ();
+        QueryPerformanceCounter (&end);
+
+        result->samples_ns[ii] = (double)(end.QuadPart - start.QuadPart) * 1e9 / frequency.QuadPart / iterations;
+        cycles[ii] = (double)(endCycles - startCycles) / iterations;
+    }
+
+    result->iterations = iterations;
+    result->num_samples = config->num_samples;
+
+    memcpy (sorted, result->samples_ns, config->num_samples * sizeof (double));
+    qsort (sorted, config->num_samples, sizeof (double), CompareDoubles);
+    result->median_ns = Percentile (sorted, config->num_samples, 0.5);
+    result->p99_ns = Percentile (sorted, config->num_samples, 0.99);
+    result->q1_ns = Percentile (sorted, config->num_samples, 0.25);
+    result->q3_ns = Percentile (sorted, config->num_samples, 0.75);
+    result->iqr_ns = result->q3_ns - result->q1_ns;
+
+    qsort (cycles, config->num_samples, sizeof (double), CompareDoubles);
+    result->median_cycles = Percentile (cycles, config->num_samples, 0.5);
+
+}  // End of RunBenchmark()
@@ -0,0 +1,70 @@
+//==============================================================================
+//
+// Title:       blockdrop_bench.h
+// Purpose:     Micro-benchmarks of the engine hot paths.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_bench_H__
+#define __blockdrop_bench_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define BENCH_MAX_SAMPLES       512
+#define BENCH_MAX_RESULTS       64
+#define BENCH_NAME_SIZE         32
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_samples;            // Timed samples per benchmark
+    int warmup_samples;         // Samples run and thrown away first
+    double sample_seconds;      // Length each sample is calibrated to
+    int cpu;                    // Processor the thread is pinned to, -1 to leave it
+} benchConfig;
+
+typedef struct
+{
+    char name[BENCH_NAME_SIZE];
+    long long iterations;                   // Operations per sample
+    int num_samples;
+    double median_ns;                       // Per operation
+    double p99_ns;
+    double q1_ns;
+    double q3_ns;
+    double iqr_ns;
+    double median_cycles;                   // Per operation, 0 without a cycle counter
+    double samples_ns[BENCH_MAX_SAMPLES];   // Per operation, in run order
+} benchResult;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void BenchDefaultConfig (benchConfig *config);
+
+int BenchRunAll (const benchConfig *config, benchResult results[], int max_results);
+
+int BenchWriteJson (const char *path, const benchConfig *config, const benchResult results[], int num_results);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_bench_H__ */
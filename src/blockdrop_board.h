@@ -0,0 +1,141 @@
+//==============================================================================
+//
+// Title:       blockdrop_board.h
+// Purpose:     Board functions instantiated once per row mask type.
+//
+//              Included with these macros defined, and therefore without an
+//              include guard:
+//
+//                  BOARD_ROW           Unsigned type of a row mask
+//                  BOARD_TYPE          Board type, with a rows[] member
+//                  BOARD_NAME(name)    Name of the generated function
+//                  BOARD_LINKAGE       Storage class of the functions
+//                  BOARD_COLS(board)   Columns of the board
+//                  BOARD_ROWS(board)   Rows of the board
+//                  BOARD_FULL(board)   Mask of a full row
+//                  BOARD_MAX_COLS      Most columns any board has
+//
+//              blockdrop_engine.c instantiates it with unsigned short rows and
+//              the fixed GRID_NUM_COLS by GRID_NUM_ROWS size, which are the
+//              engine functions of the same names. blockdrop_variant_board.h
+//              instantiates it for the other board sizes, with the size taken
+//              from the board. The file including it supplies BitCount().
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+BOARD_LINKAGE int BOARD_NAME (BoardClearLines) (BOARD_TYPE *board)
+{
+    int ii = 0;  // Loop iterator
+    int numLineClears = 0;
+    int row = BOARD_ROWS (board) - 1;
+
+    // Compact the non-full rows towards the bottom
+    for (ii=BOARD_ROWS (board)-1; ii>=0; ii--)
+    {
+        if (board->rows[ii] == BOARD_FULL (board))
+        {
+            numLineClears++;
+        }
+        else
+        {
+            board->rows[row] = board->rows[ii];
+            row--;
+        }
+    }
+
+    // Blank the rows dropped in at the top
+    for (ii=row; ii>=0; ii--)
+    {
+        board->rows[ii] = 0;
+    }
+
+    return numLineClears;
+
+}  // End of BoardClearLines()
+
+
+BOARD_LINKAGE double BOARD_NAME (BoardEvaluate) (const BOARD_TYPE *board, int lines_cleared,
+                                                 const weightData *weights)
+{
+    int bumpiness = 0;
+    int heights[BOARD_MAX_COLS] = {0};
+    int holes = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    BOARD_ROW newColumns = 0;
+    BOARD_ROW seen = 0;  // Columns with a filled cell at or above the current row
+    int totalHeight = 0;
+
+    for (ii=0; ii<BOARD_ROWS (board); ii++)
+    {
+        // Empty cells below a filled cell are holes
+        holes += BitCount ((BOARD_ROW)(seen & ~board->rows[ii]));
+
+        newColumns = (BOARD_ROW)(board->rows[ii] & ~seen);
+        for (jj=0; newColumns != 0; jj++)
+        {
+            if (newColumns & ((BOARD_ROW)1 << jj))
+            {
+                heights[jj] = BOARD_ROWS (board) - ii;
+                newColumns &= (BOARD_ROW)~((BOARD_ROW)1 << jj);
+            }
+        }
+        seen |= board->rows[ii];
+    }
+
+    for (ii=0; ii<BOARD_COLS (board); ii++)
+    {
+        totalHeight += heights[ii];
+        if (ii > 0)
+        {
+            bumpiness += abs (heights[ii] - heights[ii-1]);
+        }
+    }
+
+    return (weights->height * totalHeight) + (weights->lines * lines_cleared) +
+           (weights->holes * holes) + (weights->bumpiness * bumpiness);
+
+}  // End of BoardEvaluate()
+
+
+BOARD_LINKAGE int BOARD_NAME (BoardLockPiece) (BOARD_TYPE *board, const pieceData *piece)
+{
+    const pieceShape *shape = &g_pieceShapes[piece->type_index][piece->orientation];
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<shape->height; ii++)
+    {
+        board->rows[piece->y+ii] |= (BOARD_ROW)((BOARD_ROW)shape->mask[ii] << piece->x);
+    }
+
+    return BOARD_NAME (BoardClearLines) (board);
+
+}  // End of BoardLockPiece()
+
+
+BOARD_LINKAGE int BOARD_NAME (PieceFits) (const BOARD_TYPE *board, const pieceData *piece)
+{
+    const pieceShape *shape = &g_pieceShapes[piece->type_index][piece->orientation];
+    int ii = 0;  // Loop iterator
+
+    // Check for grid edge clearances
+    if ((piece->x < 0) || (piece->x + shape->width > BOARD_COLS (board)) ||
+        (piece->y < 0) || (piece->y + shape->height > BOARD_ROWS (board)))
+    {
+        return 0;
+    }
+
+    // Check for clearances around other blocks
+    for (ii=0; ii<shape->height; ii++)
+    {
+        if (board->rows[piece->y+ii] & ((BOARD_ROW)shape->mask[ii] << piece->x))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+
+}  // End of PieceFits()
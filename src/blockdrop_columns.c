@@ -0,0 +1,245 @@
+//==============================================================================
+//
+// Title:       blockdrop_columns.c
+// Purpose:     Column mask view of a board for vertical queries.
+//
+//              Row masks make horizontal questions cheap (does a block fit, is
+//              a row full), but column heights, holes and drop distances scan
+//              the board row by row. A columnData keeps one mask per column
+//              instead, where a column height is a count of leading zeros, its
+//              holes are the height less the filled cells, and the distance a
+//              block can drop is found per block column from the highest
+//              filled cell below it.
+//
+//              ColumnsFromBoard() transposes a row mask board as a 16 by 32
+//              bit matrix, the rows 16 apart sharing a word, with four rounds
+//              of block swaps instead of a test per cell. After that the view
+//              is kept up to date by ColumnsLockPiece(), which also clears the
+//              full rows, i.e. the rows set in every column, without going
+//              back to the row masks.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_columns.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int BitCount (unsigned int value);
+
+static int BitLength (unsigned int value);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int ColumnsClearLines (columnData *columns)
+{
+    unsigned int below = 0;
+    int bit = 0;
+    unsigned int full = ~0u;
+    int ii = 0;  // Loop iterator
+    int numLineClears = 0;
+
+    // A row is full when every column has it
+    for (ii=0; ii<GRID_NUM_COLS; ii++)
+    {
+        full &= columns->cols[ii];
+    }
+
+    // Highest row first, so the full rows below it keep their bits
+    while (full != 0)
+    {
+        bit = BitLength (full) - 1;
+        below = (1u << bit) - 1;
+        for (ii=0; ii<GRID_NUM_COLS; ii++)
+        {
+            columns->cols[ii] = (columns->cols[ii] & below) | ((columns->cols[ii] >> 1) & ~below);
+        }
+        full &= below;
+        numLineClears++;
+    }
+
+    return numLineClears;
+
+}  // End of ColumnsClearLines()
+
+
+int ColumnsDropDistance (const columnData *columns, const pieceData *piece)
+{
+    int bit = 0;
+    int distance = GRID_NUM_ROWS;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int landing = 0;
+    const pieceShape *shape = &g_pieceShapes[piece->type_index][piece->orientation];
+
+    for (jj=0; jj<shape->width; jj++)
+    {
+        // Lowest cell of the block in this column
+        ii = shape->height - 1;
+        while ((shape->mask[ii] & (1 << jj)) == 0)
+        {
+            ii--;
+        }
+
+        // Rows between that cell and the highest filled cell below it
+        bit = GRID_NUM_ROWS - 1 - (piece->y + ii);
+        landing = bit - BitLength (columns->cols[piece->x+jj] & ((1u << bit) - 1));
+        if (landing < distance)
+        {
+            distance = landing;
+        }
+    }
+
+    return distance;
+
+}  // End of ColumnsDropDistance()
+
+
+double ColumnsEvaluate (const columnData *columns, int lines_cleared, const weightData *weights)
+{
+    int bumpiness = 0;
+    int height = 0;
+    int holes = 0;
+    int ii = 0;  // Loop iterator
+    int lastHeight = 0;
+    int totalHeight = 0;
+
+    // Same features as BoardEvaluate()
+    for (ii=0; ii<GRID_NUM_COLS; ii++)
+    {
+        height = BitLength (columns->cols[ii]);
+        totalHeight += height;
+        holes += height - BitCount (columns->cols[ii]);
+        if (ii > 0)
+        {
+            bumpiness += abs (height - lastHeight);
+        }
+        lastHeight = height;
+    }
+
+    return (weights->height * totalHeight) + (weights->lines * lines_cleared) +
+           (weights->holes * holes) + (weights->bumpiness * bumpiness);
+
+}  // End of ColumnsEvaluate()
+
+
+void ColumnsFromBoard (const boardData *board, columnData *columns)
+{
+    unsigned int bits[16] = {0};  // Row bits in the low half, the rows 16 further down in the high half
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    unsigned int mask = 0x00FF00FFu;
+    int shift = 0;
+    unsigned int swap = 0;
+
+    // Bottom row first, so row y lands in bit GRID_NUM_ROWS - 1 - y
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        bits[ii & 15] |= (unsigned int)board->rows[GRID_NUM_ROWS-1-ii] << (ii & 16);
+    }
+
+    // Transpose both 16 by 16 halves at once, swapping the off diagonal 8, 4, 2 and 1 bit blocks
+    for (shift=8; shift>0; shift>>=1)
+    {
+        for (ii=0; ii<16; ii=(ii+shift+1)&~shift)
+        {
+            jj = ii + shift;
+            swap = ((bits[ii] >> shift) ^ bits[jj]) & mask;
+            bits[jj] ^= swap;
+            bits[ii] ^= swap << shift;
+        }
+        mask ^= mask << (shift >> 1);
+    }
+
+    for (ii=0; ii<GRID_NUM_COLS; ii++)
+    {
+        columns->cols[ii] = bits[ii];
+    }
+
+}  // End of ColumnsFromBoard()
+
+
+int ColumnsHeight (const columnData *columns, int column)
+{
+    return BitLength (columns->cols[column]);
+
+}  // End of ColumnsHeight()
+
+
+int ColumnsLockPiece (columnData *columns, const pieceData *piece)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    const pieceShape *shape = &g_pieceShapes[piece->type_index][piece->orientation];
+
+    for (ii=0; ii<shape->height; ii++)
+    {
+        for (jj=0; jj<shape->width; jj++)
+        {
+            if (shape->mask[ii] & (1 << jj))
+            {
+                columns->cols[piece->x+jj] |= 1u << (GRID_NUM_ROWS - 1 - (piece->y + ii));
+            }
+        }
+    }
+
+    return ColumnsClearLines (columns);
+
+}  // End of ColumnsLockPiece()
+
+
+static int BitCount (unsigned int value)
+{
+#if defined (__clang__) || defined (__GNUC__)
+    return __builtin_popcount (value);
+#else
+    int count = 0;
+
+    while (value != 0)
+    {
+        value &= value - 1;
+        count++;
+    }
+
+    return count;
+#endif
+
+}  // End of BitCount()
+
+
+static int BitLength (unsigned int value)
+{
+#if defined (__clang__) || defined (__GNUC__)
+    // Count leading zeros is undefined for 0
+    return (value != 0) ? 32 - __builtin_clz (value) : 0;
+#else
+    int length = 0;
+
+    while (value != 0)
+    {
+        value >>= 1;
+        length++;
+    }
+
+    return length;
+#endif
+
+}  // End of BitLength()
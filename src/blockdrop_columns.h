@@ -0,0 +1,66 @@
+//==============================================================================
+//
+// Title:       blockdrop_columns.h
+// Purpose:     Column mask view of a board for vertical queries.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_columns_H__
+#define __blockdrop_columns_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#if GRID_NUM_ROWS > 32
+    #error "Column masks hold up to 32 rows"
+#endif
+
+#if GRID_NUM_COLS > 16
+    #error "ColumnsFromBoard() transposes up to 16 columns"
+#endif
+
+//==============================================================================
+// Types
+
+// Bit (GRID_NUM_ROWS - 1 - y) of a column mask is set when row y of that
+// column is filled, so the bottom row is bit 0 and the height of a column is
+// the index of its highest set bit plus one.
+typedef struct
+{
+    unsigned int cols[GRID_NUM_COLS];
+} columnData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int ColumnsClearLines (columnData *columns);
+
+int ColumnsDropDistance (const columnData *columns, const pieceData *piece);
+
+double ColumnsEvaluate (const columnData *columns, int lines_cleared, const weightData *weights);
+
+void ColumnsFromBoard (const boardData *board, columnData *columns);
+
+int ColumnsHeight (const columnData *columns, int column);
+
+int ColumnsLockPiece (columnData *columns, const pieceData *piece);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_columns_H__ */
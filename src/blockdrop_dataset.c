@@ -0,0 +1,802 @@
+//==============================================================================
+//
+// Title:       blockdrop_dataset.c
+// Purpose:     Self-play records written to fixed size binary shards.
+//
+//              DatasetGenerate() plays seeded headless games on a thread pool
+//              and appends one 32 byte record per placement once each game is
+//              over and its outcome is known. Appends fill one of two buffers;
+//              a full buffer is handed to a single writer thread while the
+//              other one fills, so the players only wait when the disk falls
+//              a whole buffer behind.
+//
+//              Compressed shards XOR each record with the previous one, which
+//              leaves mostly zero bytes since consecutive boards of a game
+//              differ by a few cells, and then run length encode the zeros.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_dataset.h"
+
+//==============================================================================
+// Constants
+
+#define BUFFER_RECORDS          65536                       // 2 MB per buffer
+#define MAX_ENCODED_SIZE(size)  (2 * (size) + 16)           // A single zero takes two bytes
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    datasetRecord *records;
+    int num_records;
+} datasetBuffer;
+
+struct datasetWriter
+{
+    char prefix[MAX_PATHNAME_LEN];
+    int shard_records;
+    int flags;
+    CmtThreadLockHandle lock;           // Serializes appends
+    CmtThreadPoolHandle pool;           // One thread that writes full buffers
+    CmtThreadFunctionID write_id;       // 0 when no write is pending
+    datasetBuffer buffers[2];
+    int filling;                        // Buffer being filled
+    int writing;                        // Buffer handed to the writer thread
+    int status;                         // First write error
+
+    // Only used by the thread that writes
+    FILE *file;
+    datasetHeader header;
+    int shard_index;
+    unsigned char *encoded;
+    datasetStats stats;
+};
+
+typedef struct
+{
+    const datasetConfig *config;
+    datasetWriter *writer;
+    volatile LONG next_game;
+    volatile LONG status;
+} datasetJob;
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int CloseShard (datasetWriter *writer);
+
+static int CVICALLBACK DatasetWorker (void *functionData);
+
+static int DecodeBlock (const unsigned char *data, int size, unsigned char *raw, int raw_size);
+
+static int EncodeBlock (const datasetRecord records[], int num_records, unsigned char *data);
+
+static int OpenShard (datasetWriter *writer);
+
+static int SwapBuffers (datasetWriter *writer);
+
+static int WriteRecords (datasetWriter *writer, const datasetRecord records[], int num_records);
+
+static int CVICALLBACK WriterThread (void *functionData);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void DatasetDefaultConfig (datasetConfig *config)
+{
+    memset (config, 0, sizeof (datasetConfig));
+
+    config->prefix = "dataset";
+    config->num_games = 1000;
+    config->policy = DATASET_POLICY_GREEDY;
+    config->max_pieces = DATASET_DEFAULT_MAX_PIECES;
+    config->shard_records = DATASET_DEFAULT_SHARD_RECORDS;
+    config->seed = 1;
+    config->weights = g_defaultWeights;
+
+}  // End of DatasetDefaultConfig()
+
+
+int DatasetGenerate (const datasetConfig *config, datasetStats *stats)
+{
+    int ii = 0;  // Loop iterator
+    datasetJob job = {0};
+    int numThreads = config->num_threads;
+    CmtThreadPoolHandle pool = 0;
+    double start = Timer ();
+    void *workerData[DATASET_MAX_THREADS] = {NULL};
+
+    memset (stats, 0, sizeof (datasetStats));
+
+    if ((config->num_games < 1) || (config->max_pieces < 1) ||
+        (DatasetWriterOpen (config->prefix, config->shard_records, config->flags, &job.writer) != 0))
+    {
+        return -1;
+    }
+    job.config = config;
+
+    if (numThreads <= 0)
+    {
+        numThreads = GetNumProcessors ();
+    }
+    if (numThreads > DATASET_MAX_THREADS)
+    {
+        numThreads = DATASET_MAX_THREADS;
+    }
+
+    if (CmtNewThreadPool (numThreads, &pool) < 0)
+    {
+        DatasetWriterClose (job.writer, stats);
+        return -1;
+    }
+
+    // Every worker takes games from the shared job
+    for (ii=0; ii<numThreads; ii++)
+    {
+        workerData[ii] = &job;
+    }
+    if (ThreadPoolRun (pool, DatasetWorker, workerData, numThreads) != 0)
+    {
+        job.status = -1;
+    }
+
+    CmtDiscardThreadPool (pool);
+
+    if (DatasetWriterClose (job.writer, stats) != 0)
+    {
+        job.status = -1;
+    }
+
+    stats->games = config->num_games;
+    stats->seconds = Timer () - start;
+
+    return job.status;
+
+}  // End of DatasetGenerate()
+
+
+int DatasetPackRecord (const boardData *board, const pieceData *placed, int lines, int outcome,
+                       datasetRecord *record)
+{
+    int bit = 0;
+    int ii = 0;  // Loop iterator
+
+    memset (record, 0, sizeof (datasetRecord));
+
+    if (outcome > DATASET_MAX_OUTCOME)
+    {
+        outcome = DATASET_MAX_OUTCOME;
+    }
+
+    // Ten bits per row start on an even bit, so every row fits in two bytes
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        bit = ii * GRID_NUM_COLS;
+        record->bytes[bit/8] |= (unsigned char)(board->rows[ii] << (bit % 8));
+        record->bytes[bit/8+1] |= (unsigned char)(board->rows[ii] >> (8 - bit % 8));
+    }
+
+    record->bytes[29] = (unsigned char)(placed->type_index | (placed->orientation << 3) | (lines << 5));
+    record->bytes[30] = (unsigned char)(placed->x | ((outcome & 0x0F) << 4));
+    record->bytes[31] = (unsigned char)(outcome >> 4);
+
+    return 0;
+
+}  // End of DatasetPackRecord()
+
+
+int DatasetReadShard (const char *path, int (*callback) (const datasetRecord *record, void *data), void *data)
+{
+    unsigned int blockSizes[2] = {0};
+    unsigned char *encoded = NULL;
+    FILE *file = NULL;
+    datasetHeader header;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numRead = 0;
+    datasetRecord previous = {0};
+    datasetRecord *records = NULL;
+    int status = 0;
+
+    file = fopen (path, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fread (&header, sizeof (header), 1, file) != 1) || (header.magic != DATASET_MAGIC) ||
+        (header.version != DATASET_VERSION) || (header.record_size != DATASET_RECORD_SIZE))
+    {
+        fclose (file);
+        return -1;
+    }
+
+    records = malloc (BUFFER_RECORDS * sizeof (datasetRecord));
+    encoded = malloc (MAX_ENCODED_SIZE (BUFFER_RECORDS * sizeof (datasetRecord)));
+
+    while ((status == 0) && (records != NULL) && (encoded != NULL) && (numRead < (int)header.num_records))
+    {
+        if (header.flags & DATASET_COMPRESSED)
+        {
+            // Blocks are never bigger than one writer buffer
+            if ((fread (blockSizes, sizeof (blockSizes), 1, file) != 1) ||
+                (blockSizes[0] > BUFFER_RECORDS * sizeof (datasetRecord)) ||
+                (blockSizes[0] % sizeof (datasetRecord) != 0) ||
+                (blockSizes[1] > MAX_ENCODED_SIZE (BUFFER_RECORDS * sizeof (datasetRecord))) ||
+                (fread (encoded, 1, blockSizes[1], file) != blockSizes[1]) ||
+                (DecodeBlock (encoded, blockSizes[1], (unsigned char *)records, blockSizes[0]) != 0))
+            {
+                status = -1;
+                break;
+            }
+
+            for (ii=0; ii<(int)(blockSizes[0] / sizeof (datasetRecord)); ii++)
+            {
+                for (jj=0; jj<DATASET_RECORD_SIZE; jj++)
+                {
+                    records[ii].bytes[jj] ^= previous.bytes[jj];
+                }
+                previous = records[ii];
+
+                if ((status == 0) && (callback (&records[ii], data) != 0))
+                {
+                    status = -1;
+                }
+                numRead++;
+            }
+            memset (&previous, 0, sizeof (previous));
+        }
+        else
+        {
+            jj = (int)header.num_records - numRead;
+            if (jj > BUFFER_RECORDS)
+            {
+                jj = BUFFER_RECORDS;
+            }
+
+            if (fread (records, sizeof (datasetRecord), jj, file) != (size_t)jj)
+            {
+                status = -1;
+                break;
+            }
+
+            for (ii=0; (ii<jj) && (status == 0); ii++)
+            {
+                status = (callback (&records[ii], data) == 0) ? 0 : -1;
+            }
+            numRead += jj;
+        }
+    }
+
+    if ((records == NULL) || (encoded == NULL))
+    {
+        status = -1;
+    }
+
+    free (records);
+    free (encoded);
+    fclose (file);
+
+    return (status == 0) ? numRead : -1;
+
+}  // End of DatasetReadShard()
+
+
+int DatasetUnpackRecord (const datasetRecord *record, boardData *board, pieceData *placed, int *lines,
+                         int *outcome)
+{
+    int bit = 0;
+    int ii = 0;  // Loop iterator
+    unsigned int value = 0;
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        bit = ii * GRID_NUM_COLS;
+        value = record->bytes[bit/8] | (record->bytes[bit/8+1] << 8);
+        board->rows[ii] = (unsigned short)((value >> (bit % 8)) & FULL_ROW_MASK);
+    }
+
+    placed->type_index = record->bytes[29] & 0x07;
+    placed->orientation = (record->bytes[29] >> 3) & 0x03;
+    placed->x = record->bytes[30] & 0x0F;
+    placed->y = 0;
+    *lines = record->bytes[29] >> 5;
+    *outcome = (record->bytes[30] >> 4) | (record->bytes[31] << 4);
+
+    if ((placed->type_index >= NUM_BLOCKS_TYPES) || (placed->orientation >= NUM_ORIENTATIONS))
+    {
+        return -1;
+    }
+
+    // The drop row is not stored, the block falls from the first row it fits in
+    while ((placed->y < GRID_NUM_ROWS) && (PieceFits (board, placed) == 0))
+    {
+        placed->y++;
+    }
+    if (placed->y == GRID_NUM_ROWS)
+    {
+        return -1;
+    }
+    placed->y += PieceDropDistance (board, placed);
+
+    return 0;
+
+}  // End of DatasetUnpackRecord()
+
+
+int DatasetWriterAppend (datasetWriter *writer, const datasetRecord records[], int num_records)
+{
+    datasetBuffer *buffer = NULL;
+    int count = 0;
+    int gotLock = 0;
+    int status = 0;
+
+    CmtGetLockEx (writer->lock, 0, CMT_WAIT_FOREVER, &gotLock);
+
+    while ((num_records > 0) && (status == 0))
+    {
+        buffer = &writer->buffers[writer->filling];
+
+        count = BUFFER_RECORDS - buffer->num_records;
+        if (count > num_records)
+        {
+            count = num_records;
+        }
+
+        memcpy (&buffer->records[buffer->num_records], records, count * sizeof (datasetRecord));
+        buffer->num_records += count;
+        records += count;
+        num_records -= count;
+
+        if (buffer->num_records == BUFFER_RECORDS)
+        {
+            status = SwapBuffers (writer);
+        }
+    }
+
+    CmtReleaseLock (writer->lock);
+
+    return status;
+
+}  // End of DatasetWriterAppend()
+
+
+int DatasetWriterClose (datasetWriter *writer, datasetStats *stats)
+{
+    int status = 0;
+
+    // Finish the pending write, then write the rest from this thread
+    if (writer->write_id != 0)
+    {
+        CmtWaitForThreadPoolFunctionCompletion (writer->pool, writer->write_id, 0);
+        CmtReleaseThreadPoolFunctionID (writer->pool, writer->write_id);
+    }
+
+    if (writer->status == 0)
+    {
+        writer->status = WriteRecords (writer, writer->buffers[writer->filling].records,
+                                       writer->buffers[writer->filling].num_records);
+    }
+    if (CloseShard (writer) != 0)
+    {
+        writer->status = -1;
+    }
+
+    status = writer->status;
+    if (stats != NULL)
+    {
+        stats->records = writer->stats.records;
+        stats->bytes = writer->stats.bytes;
+        stats->shards = writer->stats.shards;
+    }
+
+    CmtDiscardThreadPool (writer->pool);
+    CmtDiscardLock (writer->lock);
+    free (writer->buffers[0].records);
+    free (writer->buffers[1].records);
+    free (writer->encoded);
+    free (writer);
+
+    return status;
+
+}  // End of DatasetWriterClose()
+
+
+int DatasetWriterOpen (const char *prefix, int shard_records, int flags, datasetWriter **writer)
+{
+    datasetWriter *newWriter = NULL;
+
+    *writer = NULL;
+
+    if ((shard_records < 1) || (strlen (prefix) + 16 > MAX_PATHNAME_LEN))
+    {
+        return -1;
+    }
+
+    newWriter = calloc (1, sizeof (datasetWriter));
+    if (newWriter == NULL)
+    {
+        return -1;
+    }
+
+    strcpy (newWriter->prefix, prefix);
+    newWriter->shard_records = shard_records;
+    newWriter->flags = flags;
+    newWriter->buffers[0].records = malloc (BUFFER_RECORDS * sizeof (datasetRecord));
+    newWriter->buffers[1].records = malloc (BUFFER_RECORDS * sizeof (datasetRecord));
+    newWriter->encoded = malloc (MAX_ENCODED_SIZE (BUFFER_RECORDS * sizeof (datasetRecord)));
+
+    if ((newWriter->buffers[0].records == NULL) || (newWriter->buffers[1].records == NULL) ||
+        (newWriter->encoded == NULL) || (CmtNewLock (NULL, 0, &newWriter->lock) < 0))
+    {
+        free (newWriter->buffers[0].records);
+        free (newWriter->buffers[1].records);
+        free (newWriter->encoded);
+        free (newWriter);
+        return -1;
+    }
+
+    if (CmtNewThreadPool (1, &newWriter->pool) < 0)
+    {
+        newWriter->pool = 0;
+        DatasetWriterClose (newWriter, NULL);
+        return -1;
+    }
+
+    *writer = newWriter;
+
+    return 0;
+
+}  // End of DatasetWriterOpen()
+
+
+static int CloseShard (datasetWriter *writer)
+{
+    int status = 0;
+
+    if (writer->file == NULL)
+    {
+        return 0;
+    }
+
+    // The header is written again now that the counts are known
+    if ((fseek (writer->file, 0, SEEK_SET) != 0) ||
+        (fwrite (&writer->header, sizeof (datasetHeader), 1, writer->file) != 1) ||
+        (fseek (writer->file, 0, SEEK_END) != 0))
+    {
+        status = -1;
+    }
+
+    writer->stats.bytes += ftell (writer->file);
+    writer->stats.shards++;
+
+    if (fclose (writer->file) != 0)
+    {
+        status = -1;
+    }
+    writer->file = NULL;
+
+    return status;
+
+}  // End of CloseShard()
+
+
+static int CVICALLBACK DatasetWorker (void *functionData)
+{
+    datasetJob *job = (datasetJob *)functionData;
+    const datasetConfig *config = job->config;
+    int futureLines = 0;
+    gameData game;
+    int gameIndex = 0;
+    int ii = 0;  // Loop iterator
+    int lines = 0;
+    int numPieces = 0;
+    int numPlacements = 0;
+    placementData placement = {0};
+    placementData placements[MAX_PLACEMENTS];
+    rngData policyRng;
+    datasetRecord *records = NULL;
+
+    records = malloc (config->max_pieces * sizeof (datasetRecord));
+    if (records == NULL)
+    {
+        InterlockedExchangeAdd (&job->status, -1);
+        return -1;
+    }
+
+    for (gameIndex=InterlockedIncrement (&job->next_game) - 1; gameIndex < config->num_games;
+         gameIndex=InterlockedIncrement (&job->next_game) - 1)
+    {
+        // Same block sequence for every policy, the random policy has its own generator
+        GameReset (&game, config->seed + gameIndex);
+        RngSeed (&policyRng, ~(config->seed + gameIndex));
+        numPieces = 0;
+
+        while ((game.game_status != GAME_END) && (numPieces < config->max_pieces))
+        {
+            if (config->policy == DATASET_POLICY_RANDOM)
+            {
+                numPlacements = EnumeratePlacements (&game.board, game.piece.type_index, placements);
+                if (numPlacements > 0)
+                {
+                    placement = placements[RngRange (&policyRng, numPlacements)];
+                }
+            }
+            else
+            {
+                numPlacements = ChooseGreedyPlacement (&game.board, game.piece.type_index, &config->weights,
+                                                       &placement);
+            }
+
+            if (numPlacements == 0)
+            {
+                break;
+            }
+
+            game.piece.orientation = placement.orientation;
+            game.piece.x = placement.x;
+            game.piece.y = placement.y;
+            DatasetPackRecord (&game.board, &game.piece, 0, 0, &records[numPieces]);
+
+            lines = GamePlace (&game, &placement);
+            records[numPieces].bytes[29] |= (unsigned char)(lines << 5);
+            numPieces++;
+        }
+
+        // Outcome is the lines cleared after each placement, counted from the end
+        futureLines = 0;
+        for (ii=numPieces-1; ii>=0; ii--)
+        {
+            records[ii].bytes[30] |= (unsigned char)((futureLines & 0x0F) << 4);
+            records[ii].bytes[31] = (unsigned char)(futureLines >> 4);
+
+            futureLines += records[ii].bytes[29] >> 5;
+            if (futureLines > DATASET_MAX_OUTCOME)
+            {
+                futureLines = DATASET_MAX_OUTCOME;
+            }
+        }
+
+        if (DatasetWriterAppend (job->writer, records, numPieces) != 0)
+        {
+            InterlockedExchangeAdd (&job->status, -1);
+            break;
+        }
+    }
+
+    free (records);
+
+    return 0;
+
+}  // End of DatasetWorker()
+
+
+static int DecodeBlock (const unsigned char *data, int size, unsigned char *raw, int raw_size)
+{
+    int ii = 0;  // Loop iterator
+    int length = 0;
+
+    // A zero byte is followed by the length of the run of zeros
+    for (ii=0; ii<size; ii++)
+    {
+        if (data[ii] != 0)
+        {
+            if (length >= raw_size)
+            {
+                return -1;
+            }
+            raw[length++] = data[ii];
+        }
+        else
+        {
+            if ((ii + 1 >= size) || (length + data[ii+1] > raw_size))
+            {
+                return -1;
+            }
+            memset (raw + length, 0, data[ii+1]);
+            length += data[++ii];
+        }
+    }
+
+    return (length == raw_size) ? 0 : -1;
+
+}  // End of DecodeBlock()
+
+
+static int EncodeBlock (const datasetRecord records[], int num_records, unsigned char *data)
+{
+    unsigned char delta = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int length = 0;
+    int run = 0;
+
+    for (ii=0; ii<num_records; ii++)
+    {
+        for (jj=0; jj<DATASET_RECORD_SIZE; jj++)
+        {
+            delta = records[ii].bytes[jj];
+            if (ii > 0)
+            {
+                delta ^= records[ii-1].bytes[jj];
+            }
+
+            if (delta == 0)
+            {
+                run++;
+                if (run == 255)
+                {
+                    data[length++] = 0;
+                    data[length++] = 255;
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0)
+            {
+                data[length++] = 0;
+                data[length++] = (unsigned char)run;
+                run = 0;
+            }
+            data[length++] = delta;
+        }
+    }
+
+    if (run > 0)
+    {
+        data[length++] = 0;
+        data[length++] = (unsigned char)run;
+    }
+
+    return length;
+
+}  // End of EncodeBlock()
+
+
+static int OpenShard (datasetWriter *writer)
+{
+    int length = 0;
+    char path[MAX_PATHNAME_LEN] = "\0";
+
+    // A prefix too long for the shard number is an error rather than a truncated name
+    length = snprintf (path, sizeof (path), "%s_%05d.bds", writer->prefix, writer->shard_index);
+    if ((length < 0) || (length >= (int)sizeof (path)))
+    {
+        return -1;
+    }
+
+    writer->file = fopen (path, "wb");
+    if (writer->file == NULL)
+    {
+        return -1;
+    }
+
+    writer->shard_index++;
+
+    memset (&writer->header, 0, sizeof (datasetHeader));
+    writer->header.magic = DATASET_MAGIC;
+    writer->header.version = DATASET_VERSION;
+    writer->header.record_size = DATASET_RECORD_SIZE;
+    writer->header.flags = (unsigned int)writer->flags;
+
+    return (fwrite (&writer->header, sizeof (datasetHeader), 1, writer->file) == 1) ? 0 : -1;
+
+}  // End of OpenShard()
+
+
+static int SwapBuffers (datasetWriter *writer)
+{
+    // Wait for the previous buffer, which keeps at most one write in flight
+    if (writer->write_id != 0)
+    {
+        CmtWaitForThreadPoolFunctionCompletion (writer->pool, writer->write_id, 0);
+        CmtReleaseThreadPoolFunctionID (writer->pool, writer->write_id);
+        writer->write_id = 0;
+    }
+
+    if (writer->status != 0)
+    {
+        return -1;
+    }
+
+    writer->writing = writer->filling;
+    if (CmtScheduleThreadPoolFunction (writer->pool, WriterThread, writer, &writer->write_id) < 0)
+    {
+        // No thread took it, so write it from this one. Nothing else is
+        // writing, the previous buffer was waited for above.
+        writer->write_id = 0;
+        if (WriteRecords (writer, writer->buffers[writer->writing].records,
+                          writer->buffers[writer->writing].num_records) != 0)
+        {
+            writer->status = -1;
+            return -1;
+        }
+    }
+
+    writer->filling ^= 1;
+    writer->buffers[writer->filling].num_records = 0;
+
+    return 0;
+
+}  // End of SwapBuffers()
+
+
+static int WriteRecords (datasetWriter *writer, const datasetRecord records[], int num_records)
+{
+    unsigned int blockSizes[2] = {0};
+    int count = 0;
+
+    while (num_records > 0)
+    {
+        if ((writer->file == NULL) && (OpenShard (writer) != 0))
+        {
+            return -1;
+        }
+
+        // Blocks end at shard boundaries
+        count = writer->shard_records - (int)writer->header.num_records;
+        if (count > num_records)
+        {
+            count = num_records;
+        }
+
+        if (writer->flags & DATASET_COMPRESSED)
+        {
+            blockSizes[0] = count * sizeof (datasetRecord);
+            blockSizes[1] = EncodeBlock (records, count, writer->encoded);
+            if ((fwrite (blockSizes, sizeof (blockSizes), 1, writer->file) != 1) ||
+                (fwrite (writer->encoded, 1, blockSizes[1], writer->file) != blockSizes[1]))
+            {
+                return -1;
+            }
+            writer->header.num_blocks++;
+        }
+        else if (fwrite (records, sizeof (datasetRecord), count, writer->file) != (size_t)count)
+        {
+            return -1;
+        }
+
+        writer->header.num_records += count;
+        writer->stats.records += count;
+        records += count;
+        num_records -= count;
+
+        if (((int)writer->header.num_records == writer->shard_records) && (CloseShard (writer) != 0))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+
+}  // End of WriteRecords()
+
+
+static int CVICALLBACK WriterThread (void *functionData)
+{
+    datasetWriter *writer = (datasetWriter *)functionData;
+    const datasetBuffer *buffer = &writer->buffers[writer->writing];
+
+    // Runs while the other buffer fills
+    if (WriteRecords (writer, buffer->records, buffer->num_records) != 0)
+    {
+        writer->status = -1;
+    }
+
+    return 0;
+
+}  // End of WriterThread()
@@ -0,0 +1,119 @@
+//==============================================================================
+//
+// Title:       blockdrop_dataset.h
+// Purpose:     Self-play records written to fixed size binary shards.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_dataset_H__
+#define __blockdrop_dataset_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define DATASET_MAGIC           0x53444442  // "BDDS"
+#define DATASET_VERSION         1
+#define DATASET_BOARD_BYTES     ((GRID_NUM_ROWS * GRID_NUM_COLS + 7) / 8)  // 10 bits per row
+#define DATASET_RECORD_SIZE     32
+#define DATASET_HEADER_SIZE     64
+#define DATASET_MAX_OUTCOME     4095
+#define DATASET_MAX_THREADS     64
+
+#define DATASET_DEFAULT_SHARD_RECORDS   (1 << 20)   // 32 MB shards
+#define DATASET_DEFAULT_MAX_PIECES      1000
+
+// Shard flags
+#define DATASET_COMPRESSED      0x1
+
+// Policies
+#define DATASET_POLICY_GREEDY   0
+#define DATASET_POLICY_RANDOM   1
+
+//==============================================================================
+// Types
+
+// Bytes 0 to 28:  board before the placement, bit (row * 10 + column), LSB first
+// Byte 29:        block type index (bits 0-2), orientation (bits 3-4), lines cleared (bits 5-7)
+// Bytes 30 to 31: column (bits 0-3), lines cleared by the rest of the game (bits 4-15)
+typedef struct
+{
+    unsigned char bytes[DATASET_RECORD_SIZE];
+} datasetRecord;
+
+// Little endian, followed by the records. Compressed shards hold blocks of
+// {raw bytes, compressed bytes, data}, see DatasetWriterAppend().
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int record_size;
+    unsigned int flags;
+    unsigned int num_records;
+    unsigned int num_blocks;
+    unsigned char reserved[DATASET_HEADER_SIZE - 24];
+} datasetHeader;
+
+typedef struct
+{
+    const char *prefix;         // Shards are <prefix>_00000.bds, <prefix>_00001.bds, ...
+    int num_games;
+    int num_threads;            // 0 uses one thread per processor
+    int policy;                 // DATASET_POLICY_
+    int max_pieces;             // Blocks per game before it is stopped
+    int shard_records;
+    int flags;                  // DATASET_COMPRESSED
+    unsigned long long seed;    // Game n uses seed + n
+    weightData weights;         // Greedy policy
+} datasetConfig;
+
+typedef struct
+{
+    long long games;
+    long long records;
+    long long bytes;            // Written to disk, including headers
+    int shards;
+    double seconds;
+} datasetStats;
+
+typedef struct datasetWriter datasetWriter;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void DatasetDefaultConfig (datasetConfig *config);
+
+int DatasetGenerate (const datasetConfig *config, datasetStats *stats);
+
+int DatasetPackRecord (const boardData *board, const pieceData *placed, int lines, int outcome,
+                       datasetRecord *record);
+
+int DatasetReadShard (const char *path, int (*callback) (const datasetRecord *record, void *data), void *data);
+
+int DatasetUnpackRecord (const datasetRecord *record, boardData *board, pieceData *placed, int *lines,
+                         int *outcome);
+
+int DatasetWriterAppend (datasetWriter *writer, const datasetRecord records[], int num_records);
+
+int DatasetWriterClose (datasetWriter *writer, datasetStats *stats);
+
+int DatasetWriterOpen (const char *prefix, int shard_records, int flags, datasetWriter **writer);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_dataset_H__ */
@@ -0,0 +1,621 @@
+//==============================================================================
+//
+// Title:       blockdrop_engine.c
+// Purpose:     Headless model of the block drop game for bots and tools.
+//
+//              The board is stored as one bit mask per row and pieces as a
+//              shape index plus a bounding box position, so nothing here
+//              touches the user interface. A move or rotation lands in place
+//              when every cell of the block ends up inside the grid and off
+//              the stack, and is rejected otherwise (no wall kicks). The I, S
+//              and Z blocks toggle between two orientations.
+//
+//              The callbacks CB_BtnMoveLeft(), CB_BtnMoveRight(),
+//              CB_BtnRotateCW() and CB_BtnRotateCCW() instead check only the
+//              cells each branch is written to check. Where a branch misses
+//              one, the two disagree, as the T rotations out of orientation 1
+//              did, so blockdrop_fuzz.c compares the engine with a reference
+//              model that copies those branch checks.
+//
+//              BoardClearLines(), BoardEvaluate(), BoardLockPiece() and
+//              PieceFits() are generated from blockdrop_board.h at the fixed
+//              grid size, the template the board size variants of
+//              blockdrop_variant.c are generated from as well.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+#include "blockdrop_columns.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int dx;
+    int dy;
+} shiftData;
+
+//==============================================================================
+// Static global variables
+
+// Same order as the blocks[] array in SpawnBlock()
+static const char blockTypes[NUM_BLOCKS_TYPES] = {BLOCK_I, BLOCK_J, BLOCK_L, BLOCK_O,
+                                                  BLOCK_T, BLOCK_S, BLOCK_Z};
+
+static const int numOrientations[NUM_BLOCKS_TYPES] = {2, 4, 4, 1, 4, 2, 2};
+
+// Bounding box of each block as placed by SpawnBlock()
+static const shiftData spawnPositions[NUM_BLOCKS_TYPES] =
+{
+    {3, 3}, {3, 1}, {3, 1}, {4, 0}, {3, 0}, {3, 1}, {3, 1}
+};
+
+// Bounding box shift for a clockwise rotation out of each orientation
+static const shiftData cwShifts[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    { {2, -3}, {-2, 3}, {2, -3}, {-2, 3} },  // I
+    { {1, -1}, {-1, 1}, {1, -1}, {-1, 1} },  // J
+    { {1, -1}, {-1, 1}, {1, -1}, {-1, 1} },  // L
+    { {0, 0},  {0, 0},  {0, 0},  {0, 0} },   // O
+    { {1, 0},  {-1, 1}, {0, -1}, {0, 0} },   // T
+    { {0, -1}, {0, 1},  {0, -1}, {0, 1} },   // S
+    { {1, -1}, {-1, 1}, {1, -1}, {-1, 1} }   // Z
+};
+
+//==============================================================================
+// Static functions
+
+static int BitCount (unsigned int value);
+
+//==============================================================================
+// Global variables
+
+// Row masks per block and orientation, relative to the bounding box
+const pieceShape g_pieceShapes[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    // I
+    { {{0xF, 0x0, 0x0, 0x0}, 4, 1},
+      {{0x1, 0x1, 0x1, 0x1}, 1, 4},
+      {{0xF, 0x0, 0x0, 0x0}, 4, 1},
+      {{0x1, 0x1, 0x1, 0x1}, 1, 4} },
+    // J
+    { {{0x1, 0x7, 0x0, 0x0}, 3, 2},
+      {{0x3, 0x1, 0x1, 0x0}, 2, 3},
+      {{0x7, 0x4, 0x0, 0x0}, 3, 2},
+      {{0x2, 0x2, 0x3, 0x0}, 2, 3} },
+    // L
+    { {{0x4, 0x7, 0x0, 0x0}, 3, 2},
+      {{0x1, 0x1, 0x3, 0x0}, 2, 3},
+      {{0x7, 0x1, 0x0, 0x0}, 3, 2},
+      {{0x3, 0x2, 0x2, 0x0}, 2, 3} },
+    // O
+    { {{0x3, 0x3, 0x0, 0x0}, 2, 2},
+      {{0x3, 0x3, 0x0, 0x0}, 2, 2},
+      {{0x3, 0x3, 0x0, 0x0}, 2, 2},
+      {{0x3, 0x3, 0x0, 0x0}, 2, 2} },
+    // T
+    { {{0x2, 0x7, 0x0, 0x0}, 3, 2},
+      {{0x1, 0x3, 0x1, 0x0}, 2, 3},
+      {{0x7, 0x2, 0x0, 0x0}, 3, 2},
+      {{0x2, 0x3, 0x2, 0x0}, 2, 3} },
+    // S
+    { {{0x6, 0x3, 0x0, 0x0}, 3, 2},
+      {{0x1, 0x3, 0x2, 0x0}, 2, 3},
+      {{0x6, 0x3, 0x0, 0x0}, 3, 2},
+      {{0x1, 0x3, 0x2, 0x0}, 2, 3} },
+    // Z
+    { {{0x3, 0x6, 0x0, 0x0}, 3, 2},
+      {{0x2, 0x3, 0x1, 0x0}, 2, 3},
+      {{0x3, 0x6, 0x0, 0x0}, 3, 2},
+      {{0x2, 0x3, 0x1, 0x0}, 2, 3} }
+};
+
+const weightData g_defaultWeights = {WEIGHT_HEIGHT, WEIGHT_LINES, WEIGHT_HOLES, WEIGHT_BUMPINESS};
+
+//==============================================================================
+// Global functions
+
+// BoardClearLines(), BoardEvaluate(), BoardLockPiece() and PieceFits(), see blockdrop_board.h
+
+#define BOARD_ROW               unsigned short
+#define BOARD_TYPE              boardData
+#define BOARD_NAME(name)        name
+#define BOARD_LINKAGE
+#define BOARD_COLS(board)       GRID_NUM_COLS
+#define BOARD_ROWS(board)       GRID_NUM_ROWS
+#define BOARD_FULL(board)       FULL_ROW_MASK
+#define BOARD_MAX_COLS          GRID_NUM_COLS
+#include "blockdrop_board.h"
+#undef BOARD_ROW
+#undef BOARD_TYPE
+#undef BOARD_NAME
+#undef BOARD_LINKAGE
+#undef BOARD_COLS
+#undef BOARD_ROWS
+#undef BOARD_FULL
+#undef BOARD_MAX_COLS
+
+
+int BoardFormat (const boardData *board, char text[BOARD_TEXT_SIZE])
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int length = 0;
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            text[length++] = (board->rows[ii] & (1 << jj)) ? '#' : '.';
+        }
+        text[length++] = '\n';
+    }
+    text[length] = '\0';
+
+    return length;
+
+}  // End of BoardFormat()
+
+
+unsigned long long BoardHash (const boardData *board)
+{
+    unsigned long long hash = 0x9E3779B97F4A7C15ULL;
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        hash = (hash ^ board->rows[ii]) * 0xFF51AFD7ED558CCDULL;
+    }
+
+    return hash ^ (hash >> 32);
+
+}  // End of BoardHash()
+
+
+int BoardParse (boardData *board, const char *text)
+{
+    int column = 0;
+    int ii = 0;  // Loop iterator
+    int numRows = 0;
+    unsigned short rows[GRID_NUM_ROWS] = {0};
+
+    // Rows are listed top to bottom and aligned to the bottom of the grid
+    for (ii=0; text[ii] != '\0'; ii++)
+    {
+        if ((text[ii] == '\n') || (text[ii] == '/'))
+        {
+            if (column > 0)
+            {
+                if (column != GRID_NUM_COLS)
+                {
+                    return -1;
+                }
+                numRows++;
+                column = 0;
+            }
+            continue;
+        }
+
+        if (text[ii] == '\r')
+        {
+            continue;
+        }
+
+        if (column == 0)
+        {
+            if (numRows == GRID_NUM_ROWS)
+            {
+                return -1;
+            }
+            rows[numRows] = 0;
+        }
+        if (column >= GRID_NUM_COLS)
+        {
+            return -1;
+        }
+
+        if ((text[ii] != '.') && (text[ii] != ' '))
+        {
+            rows[numRows] |= (unsigned short)(1 << column);
+        }
+        column++;
+    }
+
+    if (column > 0)
+    {
+        if (column != GRID_NUM_COLS)
+        {
+            return -1;
+        }
+        numRows++;
+    }
+
+    memset (board, 0, sizeof (boardData));
+    for (ii=0; ii<numRows; ii++)
+    {
+        board->rows[GRID_NUM_ROWS-numRows+ii] = rows[ii];
+    }
+
+    return 0;
+
+}  // End of BoardParse()
+
+
+int ChooseGreedyPlacement (const boardData *board, int type_index, const weightData *weights,
+                           placementData *best)
+{
+    columnData after = {0};
+    double bestScore = 0.0;
+    columnData columns = {0};
+    int ii = 0;  // Loop iterator
+    int linesCleared = 0;
+    int numPlacements = 0;
+    pieceData piece = {0};
+    placementData placements[MAX_PLACEMENTS];
+    double score = 0.0;
+
+    numPlacements = EnumeratePlacements (board, type_index, placements);
+
+    // Heights and holes of every candidate come from the column view
+    ColumnsFromBoard (board, &columns);
+
+    for (ii=0; ii<numPlacements; ii++)
+    {
+        piece.type_index = type_index;
+        piece.orientation = placements[ii].orientation;
+        piece.x = placements[ii].x;
+        piece.y = placements[ii].y;
+
+        after = columns;
+        linesCleared = ColumnsLockPiece (&after, &piece);
+        score = ColumnsEvaluate (&after, linesCleared, weights);
+
+        if ((ii == 0) || (score > bestScore))
+        {
+            bestScore = score;
+            *best = placements[ii];
+        }
+    }
+
+    return numPlacements;
+
+}  // End of ChooseGreedyPlacement()
+
+
+int EnumeratePlacements (const boardData *board, int type_index, placementData placements[])
+{
+    columnData columns = {0};
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numPlacements = 0;
+    pieceData piece = {0};
+    int top = 0;
+
+    ColumnsFromBoard (board, &columns);
+
+    // Rotate at the spawn row, then shift and drop straight down
+    PieceSpawn (type_index, &piece);
+
+    for (ii=0; ii<numOrientations[type_index]; ii++)
+    {
+        top = (piece.y < 0) ? 0 : piece.y;
+
+        for (jj=0; jj<=GRID_NUM_COLS-g_pieceShapes[type_index][ii].width; jj++)
+        {
+            placements[numPlacements].orientation = ii;
+            placements[numPlacements].x = jj;
+            placements[numPlacements].y = top;
+
+            piece.orientation = ii;
+            piece.x = jj;
+            piece.y = top;
+            if (PieceFits (board, &piece) == 0)
+            {
+                continue;
+            }
+
+            placements[numPlacements].y += ColumnsDropDistance (&columns, &piece);
+            numPlacements++;
+        }
+
+        // Geometry of the next orientation, ignoring collisions
+        PieceSpawn (type_index, &piece);
+        for (jj=0; jj<=ii; jj++)
+        {
+            piece.x += cwShifts[type_index][jj].dx;
+            piece.y += cwShifts[type_index][jj].dy;
+        }
+    }
+
+    return numPlacements;
+
+}  // End of EnumeratePlacements()
+
+
+int GamePlace (gameData *game, const placementData *placement)
+{
+    int numLineClears = 0;
+
+    game->piece.orientation = placement->orientation;
+    game->piece.x = placement->x;
+    game->piece.y = placement->y;
+
+    if (PieceFits (&game->board, &game->piece) == 0)
+    {
+        return -1;
+    }
+
+    numLineClears = BoardLockPiece (&game->board, &game->piece);
+
+    // Same level progression as CheckForLineClears()
+    game->lines += numLineClears;
+    game->level = (game->lines / 10) + 1;
+
+    GameSpawnPiece (game, FIRST_BLOCK_NO);
+
+    return numLineClears;
+
+}  // End of GamePlace()
+
+
+int GameReset (gameData *game, unsigned long long seed)
+{
+    memset (game, 0, sizeof (gameData));
+
+    RngSeed (&game->rng, seed);
+    game->level = 1;
+
+    return GameSpawnPiece (game, FIRST_BLOCK_YES);
+
+}  // End of GameReset()
+
+
+int GameSpawnPiece (gameData *game, int first_block)
+{
+    int block_index = 0;
+
+    // Avoid S and Z blocks on the first block
+    if (first_block == FIRST_BLOCK_YES)
+    {
+        block_index = RngRange (&game->rng, NUM_BLOCKS_TYPES - 2);
+    }
+    else
+    {
+        block_index = RngRange (&game->rng, NUM_BLOCKS_TYPES);
+    }
+
+    PieceSpawn (block_index, &game->piece);
+    game->pieces++;
+
+    // Game ends when the new block overlaps the stack
+    if (PieceFits (&game->board, &game->piece) == 0)
+    {
+        game->game_status = GAME_END;
+    }
+    else
+    {
+        game->game_status = GAME_RUN;
+    }
+
+    return game->game_status;
+
+}  // End of GameSpawnPiece()
+
+
+int GetNumProcessors (void)
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo (&info);
+
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+
+}  // End of GetNumProcessors()
+
+
+char PieceBlockType (int type_index)
+{
+    return blockTypes[type_index];
+
+}  // End of PieceBlockType()
+
+
+int PieceDropDistance (const boardData *board, const pieceData *piece)
+{
+    int distance = 0;
+    pieceData test = *piece;
+
+    test.y++;
+    while (PieceFits (board, &test) == 1)
+    {
+        distance++;
+        test.y++;
+    }
+
+    return distance;
+
+}  // End of PieceDropDistance()
+
+
+int PieceMove (const boardData *board, pieceData *piece, int dx, int dy)
+{
+    pieceData test = *piece;
+
+    test.x += dx;
+    test.y += dy;
+    if (PieceFits (board, &test) == 0)
+    {
+        return 0;
+    }
+
+    *piece = test;
+
+    return 1;
+
+}  // End of PieceMove()
+
+
+int PieceRotate (const boardData *board, pieceData *piece, int direction)
+{
+    pieceData test = *piece;
+
+    if ((PieceRotateShape (&test, direction) == 0) ||
+        (PieceFits (board, &test) == 0))
+    {
+        return 0;
+    }
+
+    *piece = test;
+
+    return 1;
+
+}  // End of PieceRotate()
+
+
+int PieceRotateShape (pieceData *piece, int direction)
+{
+    int count = numOrientations[piece->type_index];
+
+    // Same orientation for every rotation
+    if (count == 1)
+    {
+        return 0;
+    }
+
+    // Two orientation blocks toggle in either direction, see CB_BtnRotate()
+    if ((direction == ROTATE_CW) || (count == 2))
+    {
+        piece->x += cwShifts[piece->type_index][piece->orientation].dx;
+        piece->y += cwShifts[piece->type_index][piece->orientation].dy;
+        piece->orientation = (piece->orientation + 1) % count;
+    }
+    else
+    {
+        piece->orientation = (piece->orientation + count - 1) % count;
+        piece->x -= cwShifts[piece->type_index][piece->orientation].dx;
+        piece->y -= cwShifts[piece->type_index][piece->orientation].dy;
+    }
+
+    return 1;
+
+}  // End of PieceRotateShape()
+
+
+int PieceSpawn (int type_index, pieceData *piece)
+{
+    piece->type_index = type_index;
+    piece->orientation = ORIENTATION_1 - 1;
+    piece->x = spawnPositions[type_index].dx;
+    piece->y = spawnPositions[type_index].dy;
+
+    return 0;
+
+}  // End of PieceSpawn()
+
+
+int PieceTypeIndex (char type)
+{
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<NUM_BLOCKS_TYPES; ii++)
+    {
+        if (blockTypes[ii] == type)
+        {
+            return ii;
+        }
+    }
+
+    return -1;
+
+}  // End of PieceTypeIndex()
+
+
+unsigned int RngNext (rngData *rng)
+{
+    // xorshift64*
+    rng->state ^= rng->state >> 12;
+    rng->state ^= rng->state << 25;
+    rng->state ^= rng->state >> 27;
+
+    return (unsigned int)((rng->state * 2685821657736338717ULL) >> 32);
+
+}  // End of RngNext()
+
+
+int RngRange (rngData *rng, int range)
+{
+    return (int)(((unsigned long long)RngNext (rng) * (unsigned int)range) >> 32);
+
+}  // End of RngRange()
+
+
+void RngSeed (rngData *rng, unsigned long long seed)
+{
+    // splitmix64 scramble so that small or zero seeds are usable
+    seed += 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+
+    rng->state = (seed != 0) ? seed : 1;
+
+}  // End of RngSeed()
+
+
+int ThreadPoolRun (CmtThreadPoolHandle pool, ThreadFunctionPtr function, void *data[], int num_calls)
+{
+    CmtThreadFunctionID functionIds[THREAD_POOL_MAX_CALLS] = {0};
+    int ii = 0;  // Loop iterator
+    int numScheduled = 0;
+    int status = 0;
+
+    if ((num_calls < 0) || (num_calls > THREAD_POOL_MAX_CALLS))
+    {
+        return -1;
+    }
+
+    for (ii=0; ii<num_calls; ii++)
+    {
+        if (CmtScheduleThreadPoolFunction (pool, function, data[ii], &functionIds[ii]) < 0)
+        {
+            status = -1;
+            break;
+        }
+        numScheduled++;
+    }
+
+    // No events are processed while waiting, so no callback can reach the
+    // state the functions share before they all return
+    for (ii=0; ii<numScheduled; ii++)
+    {
+        CmtWaitForThreadPoolFunctionCompletion (pool, functionIds[ii], 0);
+        CmtReleaseThreadPoolFunctionID (pool, functionIds[ii]);
+    }
+
+    return status;
+
+}  // End of ThreadPoolRun()
+
+
+static int BitCount (unsigned int value)
+{
+    int count = 0;
+
+    while (value != 0)
+    {
+        value &= value - 1;
+        count++;
+    }
+
+    return count;
+
+}  // End of BitCount()
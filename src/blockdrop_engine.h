@@ -0,0 +1,161 @@
+//==============================================================================
+//
+// Title:       blockdrop_engine.h
+// Purpose:     Headless model of the block drop game for bots and tools.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_engine_H__
+#define __blockdrop_engine_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "cvi_blockdrop.h"
+#include "blockdrop_weights.h"
+
+//==============================================================================
+// Constants
+
+// Board geometry
+#define FULL_ROW_MASK           ((1 << GRID_NUM_COLS) - 1)
+#define NUM_ORIENTATIONS        4
+#define MAX_PLACEMENTS          (NUM_ORIENTATIONS * GRID_NUM_COLS)
+
+// Board text, one line per row with '.' for empty and '#' for filled cells
+#define BOARD_TEXT_SIZE         (GRID_NUM_ROWS * (GRID_NUM_COLS + 1) + 1)
+
+// Rotation directions
+#define ROTATE_CW               0
+#define ROTATE_CCW              1
+
+// Functions ThreadPoolRun() schedules at once
+#define THREAD_POOL_MAX_CALLS   256
+
+//==============================================================================
+// Types
+
+// Coordinates are 0-based: x is the column (0 = left), y is the row (0 = top).
+// Bit x of a row mask is set when column x of that row is filled.
+
+typedef struct
+{
+    unsigned short rows[GRID_NUM_ROWS];
+} boardData;
+
+typedef struct
+{
+    int type_index;   // Index into the spawn table, see SpawnBlock()
+    int orientation;  // 0 to NUM_ORIENTATIONS-1, i.e. ORIENTATION_1 - 1
+    int x;            // Left column of the bounding box
+    int y;            // Top row of the bounding box
+} pieceData;
+
+typedef struct
+{
+    unsigned short mask[NUM_SQUARES_PER_BLOCK];  // Row masks of the bounding box
+    int width;
+    int height;
+} pieceShape;
+
+typedef struct
+{
+    unsigned long long state;
+} rngData;
+
+typedef struct
+{
+    int orientation;
+    int x;
+    int y;
+} placementData;
+
+typedef struct
+{
+    double height;
+    double lines;
+    double holes;
+    double bumpiness;
+} weightData;
+
+typedef struct
+{
+    boardData board;
+    pieceData piece;
+    rngData rng;
+    int game_status;
+    int level;
+    int lines;
+    int pieces;
+} gameData;
+
+//==============================================================================
+// External variables
+
+extern const pieceShape g_pieceShapes[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS];
+
+extern const weightData g_defaultWeights;
+
+//==============================================================================
+// Global functions
+
+int BoardClearLines (boardData *board);
+
+int BoardFormat (const boardData *board, char text[BOARD_TEXT_SIZE]);
+
+double BoardEvaluate (const boardData *board, int lines_cleared, const weightData *weights);
+
+unsigned long long BoardHash (const boardData *board);
+
+int BoardLockPiece (boardData *board, const pieceData *piece);
+
+int BoardParse (boardData *board, const char *text);
+
+int ChooseGreedyPlacement (const boardData *board, int type_index, const weightData *weights,
+                           placementData *best);
+
+int EnumeratePlacements (const boardData *board, int type_index, placementData placements[]);
+
+int GamePlace (gameData *game, const placementData *placement);
+
+int GameReset (gameData *game, unsigned long long seed);
+
+int GameSpawnPiece (gameData *game, int first_block);
+
+int GetNumProcessors (void);
+
+char PieceBlockType (int type_index);
+
+int PieceDropDistance (const boardData *board, const pieceData *piece);
+
+int PieceFits (const boardData *board, const pieceData *piece);
+
+int PieceMove (const boardData *board, pieceData *piece, int dx, int dy);
+
+int PieceRotate (const boardData *board, pieceData *piece, int direction);
+
+int PieceRotateShape (pieceData *piece, int direction);
+
+int PieceSpawn (int type_index, pieceData *piece);
+
+int PieceTypeIndex (char type);
+
+unsigned int RngNext (rngData *rng);
+
+int RngRange (rngData *rng, int range);
+
+void RngSeed (rngData *rng, unsigned long long seed);
+
+int ThreadPoolRun (CmtThreadPoolHandle pool, ThreadFunctionPtr function, void *data[], int num_calls);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_engine_H__ */
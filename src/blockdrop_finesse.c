@@ -0,0 +1,323 @@
+//==============================================================================
+//
+// Title:       blockdrop_finesse.c
+// Purpose:     Minimum key presses for every placement and replay analysis.
+//
+//              A key press is a move left or right or a rotation, the same
+//              inputs as CB_BtnMoveLeft(), CB_BtnMoveRight() and CB_BtnRotate().
+//              Moving down is free since gravity drops the block anyway, and
+//              presses are assumed to be quicker than gravity.
+//
+//              FinesseBuildTable() searches the empty board once for every
+//              block type. Blocks on the empty board are never slower to place,
+//              so when the table presses still work on a real board they are
+//              also the minimum there. Only placements the table path cannot
+//              reach, such as tucks under overhangs, need ReachSearchEx().
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_finesse.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int ApplyInput (const boardData *board, pieceData *piece, char input);
+
+static int SearchMinimum (const boardData *board, const pieceData *target, char inputs[], int max_inputs);
+
+static int TableAnswers (const boardData *board, const pieceData *target);
+
+//==============================================================================
+// Global variables
+
+finesseEntry g_finesseTable[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS][GRID_NUM_COLS];
+
+//==============================================================================
+// Global functions
+
+int FinesseAnalyzeLine (finesseStats *stats, const char *line)
+{
+    int type_index = 0;
+
+    while ((*line == ' ') || (*line == '\t'))
+    {
+        line++;
+    }
+
+    if (*line == '#')
+    {
+        return 0;
+    }
+
+    // A blank line ends the replay
+    if ((*line == '\0') || (*line == '\r') || (*line == '\n'))
+    {
+        stats->in_replay = 0;
+        return 0;
+    }
+
+    // Each line is a block type followed by the inputs used to place it
+    if (stats->in_replay == 0)
+    {
+        memset (&stats->board, 0, sizeof (boardData));
+        stats->in_replay = 1;
+        stats->replays++;
+    }
+
+    type_index = PieceTypeIndex (line[0]);
+    if (type_index < 0)
+    {
+        stats->errors++;
+        return -1;
+    }
+
+    return FinesseAnalyzePiece (stats, type_index, line + 1, (int)strcspn (line + 1, "\r\n"));
+
+}  // End of FinesseAnalyzeLine()
+
+
+int FinesseAnalyzePiece (finesseStats *stats, int type_index, const char inputs[], int num_inputs)
+{
+    int ii = 0;  // Loop iterator
+    int minimum = 0;
+    pieceData piece = {0};
+    int presses = 0;
+
+    PieceSpawn (type_index, &piece);
+    if (PieceFits (&stats->board, &piece) == 0)
+    {
+        stats->errors++;
+        return -1;
+    }
+
+    // Presses that do nothing still count
+    for (ii=0; ii<num_inputs; ii++)
+    {
+        if ((inputs[ii] == INPUT_LEFT) || (inputs[ii] == INPUT_RIGHT) ||
+            (inputs[ii] == INPUT_CW) || (inputs[ii] == INPUT_CCW))
+        {
+            presses++;
+        }
+        ApplyInput (&stats->board, &piece, inputs[ii]);
+    }
+    piece.y += PieceDropDistance (&stats->board, &piece);
+
+    if (TableAnswers (&stats->board, &piece))
+    {
+        minimum = g_finesseTable[type_index][piece.orientation][piece.x].presses;
+    }
+    else
+    {
+        stats->searches++;
+        minimum = SearchMinimum (&stats->board, &piece, NULL, 0);
+    }
+
+    if (minimum < 0)
+    {
+        stats->errors++;
+        return -1;
+    }
+
+    stats->pieces++;
+    stats->presses += presses;
+    stats->minimum += minimum;
+    if (presses > minimum)
+    {
+        stats->faults++;
+    }
+
+    BoardLockPiece (&stats->board, &piece);
+
+    return presses - minimum;
+
+}  // End of FinesseAnalyzePiece()
+
+
+int FinesseBuildTable (void)
+{
+    boardData board = {0};
+    finesseEntry *entry = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    pieceData piece = {0};
+    int presses = 0;
+    pieceData start = {0};
+    reachData reach;
+
+    for (ii=0; ii<NUM_BLOCKS_TYPES; ii++)
+    {
+        for (jj=0; jj<NUM_ORIENTATIONS; jj++)
+        {
+            for (kk=0; kk<GRID_NUM_COLS; kk++)
+            {
+                g_finesseTable[ii][jj][kk].presses = -1;
+                g_finesseTable[ii][jj][kk].inputs[0] = '\0';
+            }
+        }
+    }
+
+    // Every lock on the empty board is on the floor, one per orientation and column
+    for (ii=0; ii<NUM_BLOCKS_TYPES; ii++)
+    {
+        PieceSpawn (ii, &start);
+        ReachSearchEx (&board, &start, REACH_FREE_DROPS, &reach);
+
+        for (jj=0; jj<reach.num_locks; jj++)
+        {
+            ReachLockPiece (&reach, jj, &piece);
+            entry = &g_finesseTable[ii][piece.orientation][piece.x];
+
+            presses = SearchMinimum (&board, &piece, entry->inputs, FINESSE_MAX_INPUTS);
+            if (presses < 0)
+            {
+                return -1;
+            }
+            entry->presses = presses;
+        }
+    }
+
+    return 0;
+
+}  // End of FinesseBuildTable()
+
+
+int FinesseMinimum (const boardData *board, const pieceData *target, char inputs[], int max_inputs)
+{
+    const finesseEntry *entry = NULL;
+
+    if (TableAnswers (board, target))
+    {
+        entry = &g_finesseTable[target->type_index][target->orientation][target->x];
+        if ((inputs != NULL) && (max_inputs > (int)strlen (entry->inputs)))
+        {
+            strcpy (inputs, entry->inputs);
+        }
+        return entry->presses;
+    }
+
+    return SearchMinimum (board, target, inputs, max_inputs);
+
+}  // End of FinesseMinimum()
+
+
+void FinesseReset (finesseStats *stats)
+{
+    memset (stats, 0, sizeof (finesseStats));
+
+}  // End of FinesseReset()
+
+
+static int ApplyInput (const boardData *board, pieceData *piece, char input)
+{
+    switch (input)
+    {
+        case INPUT_LEFT:
+            return PieceMove (board, piece, -1, 0);
+        case INPUT_RIGHT:
+            return PieceMove (board, piece, 1, 0);
+        case INPUT_DOWN:
+            return PieceMove (board, piece, 0, 1);
+        case INPUT_CW:
+            return PieceRotate (board, piece, ROTATE_CW);
+        case INPUT_CCW:
+            return PieceRotate (board, piece, ROTATE_CCW);
+    }
+
+    return 0;
+
+}  // End of ApplyInput()
+
+
+static int SearchMinimum (const boardData *board, const pieceData *target, char inputs[], int max_inputs)
+{
+    int ii = 0;  // Loop iterator
+    int length = 0;
+    int presses = 0;
+    pieceData piece = {0};
+    reachData reach;
+    char sequence[REACH_NUM_STATES];
+
+    PieceSpawn (target->type_index, &piece);
+    ReachSearchEx (board, &piece, REACH_FREE_DROPS, &reach);
+
+    for (ii=0; ii<reach.num_locks; ii++)
+    {
+        ReachLockPiece (&reach, ii, &piece);
+        if ((piece.orientation == target->orientation) && (piece.x == target->x) && (piece.y == target->y))
+        {
+            break;
+        }
+    }
+
+    if (ii == reach.num_locks)
+    {
+        return -1;
+    }
+
+    length = ReachInputSequence (&reach, ii, sequence, REACH_NUM_STATES);
+
+    // Gravity takes care of the drops after the last press
+    while ((length > 0) && (sequence[length-1] == INPUT_DOWN))
+    {
+        length--;
+    }
+
+    for (ii=0; ii<length; ii++)
+    {
+        if (sequence[ii] != INPUT_DOWN)
+        {
+            presses++;
+        }
+    }
+
+    if ((inputs != NULL) && (max_inputs > length))
+    {
+        memcpy (inputs, sequence, length);
+        inputs[length] = '\0';
+    }
+
+    return presses;
+
+}  // End of SearchMinimum()
+
+
+static int TableAnswers (const boardData *board, const pieceData *target)
+{
+    const finesseEntry *entry = &g_finesseTable[target->type_index][target->orientation][target->x];
+    int ii = 0;  // Loop iterator
+    pieceData piece = {0};
+
+    if (entry->presses < 0)
+    {
+        return 0;
+    }
+
+    PieceSpawn (target->type_index, &piece);
+    for (ii=0; entry->inputs[ii] != '\0'; ii++)
+    {
+        if (ApplyInput (board, &piece, entry->inputs[ii]) == 0)
+        {
+            return 0;
+        }
+    }
+
+    // Same orientation and column, then it must land on the same row
+    return (piece.x == target->x) && (piece.orientation == target->orientation) &&
+           (piece.y + PieceDropDistance (board, &piece) == target->y);
+
+}  // End of TableAnswers()
@@ -0,0 +1,71 @@
+//==============================================================================
+//
+// Title:       blockdrop_finesse.h
+// Purpose:     Minimum key presses for every placement and replay analysis.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_finesse_H__
+#define __blockdrop_finesse_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_reach.h"
+
+//==============================================================================
+// Constants
+
+#define FINESSE_MAX_INPUTS      64
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int presses;                        // -1 when the placement does not exist
+    char inputs[FINESSE_MAX_INPUTS];    // Key presses from the spawn position
+} finesseEntry;
+
+typedef struct
+{
+    boardData board;        // Stack of the replay being analyzed
+    int in_replay;
+    long long replays;
+    long long pieces;
+    long long presses;      // Left, right and rotate presses made
+    long long minimum;      // Fewest presses for the same placements
+    long long faults;       // Pieces placed with more presses than needed
+    long long searches;     // Pieces the empty board table could not answer
+    long long errors;       // Unknown block types and blocks that did not fit
+} finesseStats;
+
+//==============================================================================
+// External variables
+
+extern finesseEntry g_finesseTable[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS][GRID_NUM_COLS];
+
+//==============================================================================
+// Global functions
+
+int FinesseAnalyzeLine (finesseStats *stats, const char *line);
+
+int FinesseAnalyzePiece (finesseStats *stats, int type_index, const char inputs[], int num_inputs);
+
+int FinesseBuildTable (void);
+
+int FinesseMinimum (const boardData *board, const pieceData *target, char inputs[], int max_inputs);
+
+void FinesseReset (finesseStats *stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_finesse_H__ */
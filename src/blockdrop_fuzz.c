@@ -0,0 +1,891 @@
+//==============================================================================
+//
+// Title:       blockdrop_fuzz.c
+// Purpose:     Differential fuzzing of the engine against a cell by cell
+//              reference model of the user interface callbacks.
+//
+//              The reference model keeps the grid as one byte per cell and the
+//              active block as the four cells of block.position[], and moves
+//              them the way AdvanceBlock(), CB_BtnMoveLeft(), CB_BtnMoveRight(),
+//              CB_BtnRotate() and CheckForLineClears() do: every cell is moved
+//              on its own and checked against the grid edges and the stack.
+//              The rotation and spawn tables below are the position updates
+//              written out in CB_BtnRotateCW(), CB_BtnRotateCCW() and
+//              SpawnBlock(), so nothing is shared with the bit mask shapes and
+//              shift tables of the engine except the block generator.
+//
+//              A rotation makes exactly the checks of its branch in the
+//              callbacks, copied into the guard tables, and not a test of every
+//              cell it moves into. A cell outside the grid reads as empty, as
+//              GetTableCellAttribute() fails there and leaves the color white,
+//              so a branch that misses a check shows up as a mismatch.
+//
+//              A fuzz input is FUZZ_SEED_SIZE bytes of generator seed followed
+//              by one byte per tick, each mapped to one of the inputs the user
+//              interface has (none, left, right, clockwise, counterclockwise)
+//              and followed by gravity, as in the scenario harness. Both models
+//              run side by side and are compared after every tick.
+//
+//              Built with BLOCKDROP_LIBFUZZER defined, the module also exports
+//              the libFuzzer entry point, which aborts on the first mismatch.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_fuzz.h"
+
+//==============================================================================
+// Constants
+
+#define FUZZ_NUM_INPUTS         5
+#define FUZZ_MAX_GUARD_CELLS    3
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int dx;
+    int dy;
+} referenceShift;
+
+typedef struct
+{
+    int orientation;                                // ORIENTATION_ after the rotation, 0 for none
+    referenceShift cells[NUM_SQUARES_PER_BLOCK];    // Added to each of block.position[]
+} referenceRotation;
+
+typedef struct
+{
+    int index;                                      // block.position[] the cell is next to
+    int dx;
+    int dy;
+} referenceCell;
+
+// Written as in the callbacks, with 1-based table cells: the rotation is stopped
+// when block.position[edge] is in one of cols or on row, or any cell is filled.
+typedef struct
+{
+    int edge;                                       // block.position[] checked against the grid edges
+    int cols[FUZZ_MAX_GUARD_CELLS];                 // 0 when unused
+    int row;                                        // 0 when unused
+    int num_cells;
+    referenceCell cells[FUZZ_MAX_GUARD_CELLS];
+} referenceGuard;
+
+typedef struct
+{
+    unsigned char grid[GRID_NUM_ROWS][GRID_NUM_COLS];  // Stack only, nonzero when filled
+    int type_index;
+    int orientation;                                // ORIENTATION_
+    int x[NUM_SQUARES_PER_BLOCK];                   // Active block cells, 0-based
+    int y[NUM_SQUARES_PER_BLOCK];
+    int lines;
+    int level;
+    int game_status;
+    rngData rng;
+    char pieces[SCENARIO_MAX_PIECES + 1];           // Blocks spawned so far, for replays
+    int num_pieces;
+} referenceGame;
+
+//==============================================================================
+// Static global variables
+
+static const char fuzzInputs[FUZZ_NUM_INPUTS] = {SCENARIO_INPUT_NONE, SCENARIO_INPUT_LEFT, SCENARIO_INPUT_RIGHT,
+                                                 SCENARIO_INPUT_CW, SCENARIO_INPUT_CCW};
+
+// Cells of each block as placed by SpawnBlock(), in block.position[] order
+static const referenceShift spawnCells[NUM_BLOCKS_TYPES][NUM_SQUARES_PER_BLOCK] =
+{
+    {{6, 3}, {3, 3}, {4, 3}, {5, 3}},  // I
+    {{3, 2}, {3, 1}, {5, 2}, {4, 2}},  // J
+    {{4, 2}, {3, 2}, {5, 2}, {5, 1}},  // L
+    {{4, 0}, {4, 1}, {5, 0}, {5, 1}},  // O
+    {{4, 0}, {3, 1}, {4, 1}, {5, 1}},  // T
+    {{5, 1}, {3, 2}, {4, 1}, {4, 2}},  // S
+    {{3, 1}, {5, 2}, {4, 1}, {4, 2}}   // Z
+};
+
+// Position updates out of each orientation in CB_BtnRotateCW()
+static const referenceRotation cwRotations[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    {  // I
+        {2, {{-1, -3}, {2, -2}, {1, -1}, {0, 0}}},
+        {1, {{1, 3}, {-2, 2}, {-1, 1}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // J
+        {2, {{2, -2}, {1, 0}, {-1, -2}, {0, 0}}},
+        {3, {{0, 2}, {0, 0}, {1, 1}, {-1, -1}}},
+        {4, {{0, -2}, {1, 0}, {0, 1}, {1, 1}}},
+        {1, {{-2, 2}, {-2, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // L
+        {2, {{0, -2}, {1, -1}, {-1, 0}, {0, 1}}},
+        {3, {{-1, 1}, {0, 0}, {-1, 0}, {0, -1}}},
+        {4, {{2, -1}, {0, -1}, {2, 0}, {0, 0}}},
+        {1, {{-1, 2}, {-1, 2}, {0, 0}, {0, 0}}}
+    },
+    {  // O
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // T
+        {2, {{0, 0}, {1, 1}, {0, 0}, {0, 0}}},
+        {3, {{-1, 1}, {0, 0}, {0, 0}, {0, 0}}},
+        {4, {{0, 0}, {0, 0}, {0, 0}, {-1, -1}}},
+        {1, {{1, -1}, {-1, -1}, {0, 0}, {1, 1}}}
+    },
+    {  // S
+        {2, {{-2, -1}, {0, -1}, {0, 0}, {0, 0}}},
+        {1, {{2, 1}, {0, 1}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // Z
+        {2, {{2, -1}, {0, -1}, {0, 0}, {0, 0}}},
+        {1, {{-2, 1}, {0, 1}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    }
+};
+
+// Checks made before each rotation in CB_BtnRotateCW()
+static const referenceGuard cwGuards[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    {  // I
+        {0, {0}, 0, 3, {{3, 0, -1}, {3, 0, -2}, {3, 0, -3}}},
+        {3, {1, 2, GRID_NUM_COLS}, 0, 3, {{3, -2, 0}, {3, -1, 0}, {3, 1, 0}}},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // J
+        {0, {0}, 0, 3, {{3, 0, -1}, {3, 0, -2}, {3, 1, -2}}},
+        {3, {1}, 0, 3, {{1, -1, 0}, {1, 1, 0}, {1, 1, 1}}},
+        {0, {0}, 0, 2, {{2, 0, -1}, {0, -1, 0}}},
+        {3, {1}, 0, 2, {{3, -1, 0}, {3, -1, -1}}}
+    },
+    {  // L
+        {0, {0}, 0, 2, {{0, 0, -1}, {0, 0, -2}}},
+        {2, {1}, 0, 3, {{1, -1, 0}, {1, 1, 0}, {1, -1, 1}}},
+        {0, {0}, 0, 3, {{3, 0, -1}, {3, 0, 1}, {3, -1, -1}}},
+        {1, {1}, 0, 2, {{2, -1, 0}, {2, -2, 0}}}
+    },
+    {  // O
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // T
+        {2, {0}, GRID_NUM_ROWS, 1, {{2, 0, 1}}},
+        {2, {1}, 0, 1, {{2, -1, 0}}},
+        {0, {0}, 0, 1, {{2, 0, -1}}},
+        {2, {GRID_NUM_COLS}, 0, 1, {{2, 1, 0}}}
+    },
+    {  // S
+        {0, {0}, 0, 2, {{2, -1, 0}, {2, -1, -1}}},
+        {2, {GRID_NUM_COLS}, 0, 2, {{2, 1, 0}, {3, -1, 0}}},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // Z
+        {0, {0}, 0, 2, {{2, 1, 0}, {2, 1, -1}}},
+        {2, {1}, 0, 2, {{2, -1, 0}, {3, 1, 0}}},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    }
+};
+
+// Position updates out of each orientation in CB_BtnRotateCCW()
+static const referenceRotation ccwRotations[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    {  // I
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // J
+        {4, {{2, -2}, {2, 0}, {0, 0}, {0, 0}}},
+        {1, {{-2, 2}, {-1, 0}, {1, 2}, {0, 0}}},
+        {2, {{0, -2}, {0, 0}, {-1, -1}, {1, 1}}},
+        {3, {{0, 2}, {-1, 0}, {0, -1}, {-1, -1}}}
+    },
+    {  // L
+        {4, {{1, -2}, {1, -2}, {0, 0}, {0, 0}}},
+        {1, {{0, 2}, {-1, 1}, {1, 0}, {0, -1}}},
+        {2, {{1, -1}, {0, 0}, {1, 0}, {0, 1}}},
+        {3, {{-2, 1}, {0, 1}, {-2, 0}, {0, 0}}}
+    },
+    {  // O
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // T
+        {4, {{-1, 1}, {1, 1}, {0, 0}, {-1, -1}}},
+        {1, {{0, 0}, {-1, -1}, {0, 0}, {0, 0}}},
+        {2, {{1, -1}, {0, 0}, {0, 0}, {0, 0}}},
+        {3, {{0, 0}, {0, 0}, {0, 0}, {1, 1}}}
+    },
+    {  // S
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    },
+    {  // Z
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+        {0, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}
+    }
+};
+
+// Checks made before each rotation in CB_BtnRotateCCW()
+static const referenceGuard ccwGuards[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS] =
+{
+    {  // I
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // J
+        {0, {0}, 0, 2, {{2, 0, -1}, {2, 0, -2}}},
+        {3, {1}, 0, 3, {{3, 1, 0}, {3, -1, 0}, {3, -1, -1}}},
+        {0, {0}, 0, 3, {{1, 0, -1}, {1, 0, 1}, {1, 1, -1}}},
+        {3, {1}, 0, 2, {{1, -1, 0}, {1, -2, 0}}}
+    },
+    {  // L
+        {0, {0}, 0, 2, {{3, 0, -1}, {3, -1, -1}}},
+        {1, {1}, 0, 2, {{2, -1, 0}, {3, 0, -1}}},
+        {0, {0}, 0, 3, {{1, 0, -1}, {1, 0, 1}, {1, 1, 1}}},
+        {2, {2}, 0, 3, {{3, -1, 0}, {3, -2, 0}, {3, -2, 1}}}
+    },
+    {  // O
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // T
+        {2, {0}, GRID_NUM_ROWS, 1, {{2, 0, 1}}},
+        {2, {1}, 0, 1, {{2, -1, 0}}},
+        {0, {0}, 0, 1, {{2, 0, -1}}},
+        {2, {GRID_NUM_COLS}, 0, 1, {{2, 1, 0}}}
+    },
+    {  // S
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    },
+    {  // Z
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0},
+        {0, {0}, 0, 0}
+    }
+};
+
+//==============================================================================
+// Static functions
+
+static void DrawEngine (const gameData *game, boardData *stack, boardData *piece);
+
+static void DrawReference (const referenceGame *ref, boardData *stack, boardData *piece);
+
+static void EngineStep (gameData *game, char input);
+
+static unsigned long long ReadSeed (const unsigned char *data, size_t size);
+
+static int ReferenceAdvance (referenceGame *ref);
+
+static int ReferenceClearLines (referenceGame *ref);
+
+static int ReferenceFilled (const referenceGame *ref, int x, int y);
+
+static int ReferenceMove (referenceGame *ref, int dx);
+
+static void ReferenceReset (referenceGame *ref, unsigned long long seed);
+
+static int ReferenceRotate (referenceGame *ref, int direction);
+
+static int ReferenceSpawn (referenceGame *ref, int first_block);
+
+static void ReferenceStep (referenceGame *ref, char input);
+
+static void WriteRows (FILE *file, const boardData *stack, const boardData *piece);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int FuzzCompare (const unsigned char *data, size_t size, fuzzReport *report)
+{
+    boardData engineStack = {0};
+    boardData enginePiece = {0};
+    gameData game;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    char input = SCENARIO_INPUT_NONE;
+    int numTicks = (size > FUZZ_SEED_SIZE) ? (int)(size - FUZZ_SEED_SIZE) : 0;
+    referenceGame ref;
+    boardData referenceStack = {0};
+    boardData referencePiece = {0};
+    unsigned long long seed = ReadSeed (data, size);
+
+    memset (report, 0, sizeof (fuzzReport));
+    report->tick = -1;
+
+    if (numTicks > FUZZ_MAX_TICKS)
+    {
+        numTicks = FUZZ_MAX_TICKS;
+    }
+
+    GameReset (&game, seed);
+    ReferenceReset (&ref, seed);
+
+    // Tick 0 is the first spawn, then one tick per input byte
+    for (ii=0; ii<=numTicks; ii++)
+    {
+        if (ii > 0)
+        {
+            input = fuzzInputs[data[FUZZ_SEED_SIZE+ii-1] % FUZZ_NUM_INPUTS];
+            EngineStep (&game, input);
+            ReferenceStep (&ref, input);
+        }
+
+        DrawEngine (&game, &engineStack, &enginePiece);
+        DrawReference (&ref, &referenceStack, &referencePiece);
+
+        report->num_ticks = ii;
+        report->engine_lines = game.lines;
+        report->reference_lines = ref.lines;
+        report->engine_status = game.game_status;
+        report->reference_status = ref.game_status;
+        for (jj=0; jj<GRID_NUM_ROWS; jj++)
+        {
+            report->engine.rows[jj] = engineStack.rows[jj] | enginePiece.rows[jj];
+            report->reference.rows[jj] = referenceStack.rows[jj] | referencePiece.rows[jj];
+        }
+
+        if ((memcmp (&engineStack, &referenceStack, sizeof (boardData)) != 0) ||
+            (memcmp (&enginePiece, &referencePiece, sizeof (boardData)) != 0) ||
+            (game.lines != ref.lines) || (game.level != ref.level) || (game.game_status != ref.game_status))
+        {
+            report->tick = ii;
+            return 0;
+        }
+
+        if (game.game_status == GAME_END)
+        {
+            break;
+        }
+    }
+
+    return 1;
+
+}  // End of FuzzCompare()
+
+
+int FuzzMinimize (unsigned char *data, size_t *size)
+{
+    size_t chunk = 0;
+    size_t ii = 0;  // Loop iterator
+    fuzzReport report;
+    unsigned char saved = 0;
+    unsigned char *trial = NULL;
+
+    if (FuzzCompare (data, *size, &report) != 0)
+    {
+        return -1;
+    }
+
+    trial = malloc (*size);
+    if (trial == NULL)
+    {
+        return -1;
+    }
+
+    // Nothing after the first mismatch matters
+    *size = FUZZ_SEED_SIZE + report.tick;
+
+    // Remove ever smaller runs of inputs while the models still disagree
+    for (chunk=(*size - FUZZ_SEED_SIZE) / 2; chunk>=1; chunk/=2)
+    {
+        ii = FUZZ_SEED_SIZE;
+        while (ii + chunk <= *size)
+        {
+            memcpy (trial, data, ii);
+            memcpy (trial + ii, data + ii + chunk, *size - ii - chunk);
+
+            if (FuzzCompare (trial, *size - chunk, &report) == 0)
+            {
+                memcpy (data, trial, *size - chunk);
+                *size = FUZZ_SEED_SIZE + report.tick;
+            }
+            else
+            {
+                ii += chunk;
+            }
+        }
+    }
+
+    // Then turn what is left into no input where possible
+    for (ii=FUZZ_SEED_SIZE; ii<*size; ii++)
+    {
+        saved = data[ii];
+        data[ii] = 0;
+        if (FuzzCompare (data, *size, &report) != 0)
+        {
+            data[ii] = saved;
+        }
+    }
+
+    free (trial);
+
+    return 0;
+
+}  // End of FuzzMinimize()
+
+
+int FuzzWriteScenario (const char *path, const unsigned char *data, size_t size)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    char inputs[FUZZ_MAX_TICKS + 1] = "\0";
+    int numTicks = (size > FUZZ_SEED_SIZE) ? (int)(size - FUZZ_SEED_SIZE) : 0;
+    boardData piece = {0};
+    referenceGame ref;
+    unsigned long long seed = ReadSeed (data, size);
+    boardData stack = {0};
+
+    if (numTicks > SCENARIO_MAX_INPUTS)
+    {
+        return -1;
+    }
+
+    // The reference model decides what the scenario expects
+    ReferenceReset (&ref, seed);
+    for (ii=0; (ii < numTicks) && (ref.game_status == GAME_RUN); ii++)
+    {
+        inputs[ii] = fuzzInputs[data[FUZZ_SEED_SIZE+ii] % FUZZ_NUM_INPUTS];
+        ReferenceStep (&ref, inputs[ii]);
+    }
+    inputs[ii] = '\0';
+
+    if (ref.num_pieces > SCENARIO_MAX_PIECES)
+    {
+        return -1;
+    }
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    DrawReference (&ref, &stack, &piece);
+
+    fprintf (file, "; Fuzz input, expected state from the reference model\n");
+    fprintf (file, "scenario fuzz %016llX\n", seed);
+    fprintf (file, "pieces   %s\n", ref.pieces);
+    fprintf (file, "inputs   %s\n", inputs);
+    WriteRows (file, &stack, &piece);
+    fprintf (file, "lines    %d\n", ref.lines);
+    fprintf (file, "level    %d\n", ref.level);
+
+    fclose (file);
+
+    return 0;
+
+}  // End of FuzzWriteScenario()
+
+
+#ifdef BLOCKDROP_LIBFUZZER
+int LLVMFuzzerTestOneInput (const unsigned char *data, size_t size)
+{
+    fuzzReport report;
+
+    if (FuzzCompare (data, size, &report) == 0)
+    {
+        abort ();
+    }
+
+    return 0;
+
+}  // End of LLVMFuzzerTestOneInput()
+#endif
+
+
+static void DrawEngine (const gameData *game, boardData *stack, boardData *piece)
+{
+    *stack = game->board;
+    memset (piece, 0, sizeof (boardData));
+
+    if (game->game_status == GAME_RUN)
+    {
+        BoardLockPiece (piece, &game->piece);
+    }
+
+}  // End of DrawEngine()
+
+
+static void DrawReference (const referenceGame *ref, boardData *stack, boardData *piece)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+
+    memset (stack, 0, sizeof (boardData));
+    memset (piece, 0, sizeof (boardData));
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            if (ref->grid[ii][jj])
+            {
+                stack->rows[ii] |= (unsigned short)(1 << jj);
+            }
+        }
+    }
+
+    for (ii=0; (ref->game_status == GAME_RUN) && (ii < NUM_SQUARES_PER_BLOCK); ii++)
+    {
+        // A cell rotated out of the grid is not drawn
+        if ((ref->y[ii] >= 0) && (ref->y[ii] < GRID_NUM_ROWS))
+        {
+            piece->rows[ref->y[ii]] |= (unsigned short)(1 << ref->x[ii]);
+        }
+    }
+
+}  // End of DrawReference()
+
+
+static void EngineStep (gameData *game, char input)
+{
+    placementData placement = {0};
+
+    switch (input)
+    {
+        case SCENARIO_INPUT_LEFT:
+            PieceMove (&game->board, &game->piece, -1, 0);
+            break;
+        case SCENARIO_INPUT_RIGHT:
+            PieceMove (&game->board, &game->piece, 1, 0);
+            break;
+        case SCENARIO_INPUT_CW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CW);
+            break;
+        case SCENARIO_INPUT_CCW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CCW);
+            break;
+    }
+
+    if (PieceMove (&game->board, &game->piece, 0, 1) == 1)
+    {
+        return;
+    }
+
+    placement.orientation = game->piece.orientation;
+    placement.x = game->piece.x;
+    placement.y = game->piece.y;
+    GamePlace (game, &placement);
+
+}  // End of EngineStep()
+
+
+static unsigned long long ReadSeed (const unsigned char *data, size_t size)
+{
+    int ii = 0;  // Loop iterator
+    unsigned long long seed = 0;
+
+    // Little endian, missing bytes are zero
+    for (ii=0; (ii < FUZZ_SEED_SIZE) && ((size_t)ii < size); ii++)
+    {
+        seed |= (unsigned long long)data[ii] << (8 * ii);
+    }
+
+    return seed;
+
+}  // End of ReadSeed()
+
+
+static int ReferenceAdvance (referenceGame *ref)
+{
+    int ii = 0;  // Loop iterator
+
+    // Same stop conditions as AdvanceBlock(): the grid bottom or another block
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        if ((ref->y[ii] + 1 == GRID_NUM_ROWS) || ReferenceFilled (ref, ref->x[ii], ref->y[ii] + 1))
+        {
+            break;
+        }
+    }
+
+    if (ii == NUM_SQUARES_PER_BLOCK)
+    {
+        for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+        {
+            ref->y[ii]++;
+        }
+        return 0;
+    }
+
+    // Stop the active block, leaving out cells outside the grid as SetTableCellAttribute() does
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        if ((ref->y[ii] >= 0) && (ref->y[ii] < GRID_NUM_ROWS))
+        {
+            ref->grid[ref->y[ii]][ref->x[ii]] = 1;
+        }
+    }
+
+    ReferenceClearLines (ref);
+
+    return ReferenceSpawn (ref, FIRST_BLOCK_NO);
+
+}  // End of ReferenceAdvance()
+
+
+static int ReferenceClearLines (referenceGame *ref)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numFilled = 0;
+    int numLineClears = 0;
+    int row = 0;
+
+    // Each solid row is cleared by dropping every row above it down one
+    for (row=0; row<GRID_NUM_ROWS; row++)
+    {
+        numFilled = 0;
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            numFilled += (ref->grid[row][jj] != 0);
+        }
+        if (numFilled < GRID_NUM_COLS)
+        {
+            continue;
+        }
+
+        for (ii=row; ii>0; ii--)
+        {
+            memcpy (ref->grid[ii], ref->grid[ii-1], GRID_NUM_COLS);
+        }
+        memset (ref->grid[0], 0, GRID_NUM_COLS);
+        numLineClears++;
+    }
+
+    ref->lines += numLineClears;
+    ref->level = (ref->lines / 10) + 1;
+
+    return numLineClears;
+
+}  // End of ReferenceClearLines()
+
+
+static int ReferenceFilled (const referenceGame *ref, int x, int y)
+{
+    // GetTableCellAttribute() fails outside the grid and leaves the color white
+    if ((x < 0) || (x >= GRID_NUM_COLS) || (y < 0) || (y >= GRID_NUM_ROWS))
+    {
+        return 0;
+    }
+
+    return ref->grid[y][x] != 0;
+
+}  // End of ReferenceFilled()
+
+
+static int ReferenceMove (referenceGame *ref, int dx)
+{
+    int ii = 0;  // Loop iterator
+
+    // Stop movement at the edge of the grid or next to other blocks
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        if ((ref->x[ii] + dx < 0) || (ref->x[ii] + dx >= GRID_NUM_COLS) ||
+            ReferenceFilled (ref, ref->x[ii] + dx, ref->y[ii]))
+        {
+            return 0;
+        }
+    }
+
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        ref->x[ii] += dx;
+    }
+
+    return 1;
+
+}  // End of ReferenceMove()
+
+
+static void ReferenceReset (referenceGame *ref, unsigned long long seed)
+{
+    memset (ref, 0, sizeof (referenceGame));
+
+    RngSeed (&ref->rng, seed);
+    ref->level = 1;
+
+    ReferenceSpawn (ref, FIRST_BLOCK_YES);
+
+}  // End of ReferenceReset()
+
+
+static int ReferenceRotate (referenceGame *ref, int direction)
+{
+    const referenceCell *cell = NULL;
+    const referenceGuard *guard = NULL;
+    int ii = 0;  // Loop iterator
+    const referenceRotation *rotation = NULL;
+
+    // CB_BtnRotate() sends the single rotation blocks clockwise either way
+    if ((direction == ROTATE_CW) || (ccwRotations[ref->type_index][ref->orientation-1].orientation == 0))
+    {
+        rotation = &cwRotations[ref->type_index][ref->orientation-1];
+        guard = &cwGuards[ref->type_index][ref->orientation-1];
+    }
+    else
+    {
+        rotation = &ccwRotations[ref->type_index][ref->orientation-1];
+        guard = &ccwGuards[ref->type_index][ref->orientation-1];
+    }
+
+    if (rotation->orientation == 0)
+    {
+        return 0;
+    }
+
+    // Check for grid edge clearances
+    for (ii=0; ii<FUZZ_MAX_GUARD_CELLS; ii++)
+    {
+        if ((guard->cols[ii] != 0) && (ref->x[guard->edge] + 1 == guard->cols[ii]))
+        {
+            return 0;
+        }
+    }
+    if ((guard->row != 0) && (ref->y[guard->edge] + 1 == guard->row))
+    {
+        return 0;
+    }
+
+    // Check for clearances around other blocks
+    for (ii=0; ii<guard->num_cells; ii++)
+    {
+        cell = &guard->cells[ii];
+        if (ReferenceFilled (ref, ref->x[cell->index] + cell->dx, ref->y[cell->index] + cell->dy))
+        {
+            return 0;
+        }
+    }
+
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        ref->x[ii] += rotation->cells[ii].dx;
+        ref->y[ii] += rotation->cells[ii].dy;
+    }
+    ref->orientation = rotation->orientation;
+
+    return 1;
+
+}  // End of ReferenceRotate()
+
+
+static int ReferenceSpawn (referenceGame *ref, int first_block)
+{
+    int ii = 0;  // Loop iterator
+
+    // Same generator calls as GameSpawnPiece()
+    ref->type_index = RngRange (&ref->rng, (first_block == FIRST_BLOCK_YES) ? NUM_BLOCKS_TYPES - 2 : NUM_BLOCKS_TYPES);
+    ref->orientation = ORIENTATION_1;
+    ref->game_status = GAME_RUN;
+
+    if (ref->num_pieces < SCENARIO_MAX_PIECES)
+    {
+        ref->pieces[ref->num_pieces] = PieceBlockType (ref->type_index);
+    }
+    ref->num_pieces++;
+
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        ref->x[ii] = spawnCells[ref->type_index][ii].dx;
+        ref->y[ii] = spawnCells[ref->type_index][ii].dy;
+
+        // Game ends when the new block overlaps the stack
+        if (ref->grid[ref->y[ii]][ref->x[ii]])
+        {
+            ref->game_status = GAME_END;
+        }
+    }
+
+    return ref->game_status;
+
+}  // End of ReferenceSpawn()
+
+
+static void ReferenceStep (referenceGame *ref, char input)
+{
+    switch (input)
+    {
+        case SCENARIO_INPUT_LEFT:
+            ReferenceMove (ref, -1);
+            break;
+        case SCENARIO_INPUT_RIGHT:
+            ReferenceMove (ref, 1);
+            break;
+        case SCENARIO_INPUT_CW:
+            ReferenceRotate (ref, ROTATE_CW);
+            break;
+        case SCENARIO_INPUT_CCW:
+            ReferenceRotate (ref, ROTATE_CCW);
+            break;
+    }
+
+    // Timer tick
+    ReferenceAdvance (ref);
+
+}  // End of ReferenceStep()
+
+
+static void WriteRows (FILE *file, const boardData *stack, const boardData *piece)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int top = GRID_NUM_ROWS - 1;
+
+    // Rows are aligned to the bottom, so start at the highest filled one
+    for (ii=GRID_NUM_ROWS-1; ii>=0; ii--)
+    {
+        if (stack->rows[ii] | piece->rows[ii])
+        {
+            top = ii;
+        }
+    }
+
+    for (ii=top; ii<GRID_NUM_ROWS; ii++)
+    {
+        fprintf (file, "expect   ");
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            fputc ((piece->rows[ii] & (1 << jj)) ? '@' : ((stack->rows[ii] & (1 << jj)) ? '#' : '.'), file);
+        }
+        fputc ('\n', file);
+    }
+
+}  // End of WriteRows()
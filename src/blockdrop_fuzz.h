@@ -0,0 +1,64 @@
+//==============================================================================
+//
+// Title:       blockdrop_fuzz.h
+// Purpose:     Differential fuzzing of the engine against a cell by cell
+//              reference model of the user interface callbacks.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_fuzz_H__
+#define __blockdrop_fuzz_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_scenario.h"
+
+//==============================================================================
+// Constants
+
+#define FUZZ_SEED_SIZE          8       // Leading input bytes that seed the block generator
+#define FUZZ_MAX_TICKS          4096    // Input bytes after the seed that are used
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int tick;                   // First tick the models disagree on, -1 when they agree
+    int num_ticks;              // Ticks run
+    boardData engine;           // Stack and active block of each model after the tick
+    boardData reference;
+    int engine_lines;
+    int reference_lines;
+    int engine_status;
+    int reference_status;
+} fuzzReport;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int FuzzCompare (const unsigned char *data, size_t size, fuzzReport *report);
+
+int FuzzMinimize (unsigned char *data, size_t *size);
+
+int FuzzWriteScenario (const char *path, const unsigned char *data, size_t size);
+
+#ifdef BLOCKDROP_LIBFUZZER
+int LLVMFuzzerTestOneInput (const unsigned char *data, size_t size);
+#endif
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_fuzz_H__ */
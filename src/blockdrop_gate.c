@@ -0,0 +1,85 @@
+//==============================================================================
+//
+// Title:       blockdrop_gate.c
+// Purpose:     Performance regression gate for builds without CVI.
+//
+//              The same record and compare commands as blockdrop_tools
+//              regress, built by the Makefile on Linux from the engine, the
+//              benchmarks and blockdrop_platform.c. Baselines are the same
+//              files on both platforms, but only compare runs of one machine.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_regress.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void ShowUsage (void);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int main (int argc, char *argv[])
+{
+    int numSamples = 0;
+    int record = 0;
+    const char *report = NULL;
+
+    // Same arguments as blockdrop_tools regress
+    if ((argc < 3) || (argc > 5) || ((strcmp (argv[1], "record") != 0) && (strcmp (argv[1], "compare") != 0)))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    record = (strcmp (argv[1], "record") == 0);
+    if (record && (argc > 4))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (argc == (record ? 4 : 5))
+    {
+        numSamples = atoi (argv[argc-1]);
+        if (numSamples < 1)
+        {
+            printf ("Samples must be at least 1\n");
+            return -1;
+        }
+    }
+    if (!record && (argc >= 4))
+    {
+        report = argv[3];
+    }
+
+    return RegressRun (record, argv[2], report, numSamples);
+
+}  // End of main()
+
+
+static void ShowUsage (void)
+{
+    printf ("Usage:\n");
+    printf ("  blockdrop_gate record <baseline_file> [samples]\n");
+    printf ("  blockdrop_gate compare <baseline_file> [report_file] [samples]\n");
+
+}  // End of ShowUsage()
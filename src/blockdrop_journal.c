@@ -0,0 +1,279 @@
+//==============================================================================
+//
+// Title:       blockdrop_journal.c
+// Purpose:     Undo and redo of block placements from recorded changes.
+//
+//              Locking a block records a boardDelta: the cells it filled in
+//              each of its rows and the rows it cleared. Undo takes the cells
+//              out again after putting the cleared rows back, redo does the
+//              reverse, and both only touch the rows of the block and the
+//              rows above the lowest cleared one. No board is copied, so a
+//              depth first search can lock, recurse and undo on one board.
+//
+//              The journal adds the active block, generator state and level
+//              before and after each placement, so a whole game steps back
+//              and forth through JOURNAL_MAX_ENTRIES placements, e.g. for an
+//              undo key in practice games. A new placement after an undo
+//              drops the placements that could have been redone.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_journal.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void MakeDelta (const boardData *board, const pieceData *piece, boardDelta *delta);
+
+static void RemoveRows (boardData *board, const boardDelta *delta);
+
+static void RestoreRows (boardData *board, const boardDelta *delta);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int BoardLockDelta (boardData *board, const pieceData *piece, boardDelta *delta)
+{
+    MakeDelta (board, piece, delta);
+    BoardRedoDelta (board, delta);
+
+    return delta->num_cleared;
+
+}  // End of BoardLockDelta()
+
+
+void BoardRedoDelta (boardData *board, const boardDelta *delta)
+{
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<delta->num_rows; ii++)
+    {
+        board->rows[delta->top+ii] |= delta->masks[ii];
+    }
+
+    RemoveRows (board, delta);
+
+}  // End of BoardRedoDelta()
+
+
+void BoardUndoDelta (boardData *board, const boardDelta *delta)
+{
+    int ii = 0;  // Loop iterator
+
+    RestoreRows (board, delta);
+
+    for (ii=0; ii<delta->num_rows; ii++)
+    {
+        board->rows[delta->top+ii] &= (unsigned short)~delta->masks[ii];
+    }
+
+}  // End of BoardUndoDelta()
+
+
+int JournalPlace (journalData *journal, gameData *game, const placementData *placement)
+{
+    journalEntry *entry = NULL;
+    int numLineClears = 0;
+    pieceData piece = game->piece;
+
+    piece.orientation = placement->orientation;
+    piece.x = placement->x;
+    piece.y = placement->y;
+
+    if (PieceFits (&game->board, &piece) == 0)
+    {
+        return -1;
+    }
+
+    // Placements undone so far cannot be redone after a new one
+    journal->num_entries = journal->position;
+    if (journal->num_entries == JOURNAL_MAX_ENTRIES)
+    {
+        journal->first = (journal->first + 1) % JOURNAL_MAX_ENTRIES;
+        journal->num_entries--;
+        journal->position--;
+    }
+
+    entry = &journal->entries[(journal->first + journal->position) % JOURNAL_MAX_ENTRIES];
+    entry->piece_before = PiecePack (&game->piece);
+    entry->rng_before = game->rng;
+    entry->level_before = (short)game->level;
+    entry->status_before = (signed char)game->game_status;
+
+    // Recorded before GamePlace() locks the block, which clears the same rows
+    MakeDelta (&game->board, &piece, &entry->delta);
+    numLineClears = GamePlace (game, placement);
+
+    entry->piece_after = PiecePack (&game->piece);
+    entry->rng_after = game->rng;
+    entry->level_after = (short)game->level;
+    entry->status_after = (signed char)game->game_status;
+
+    journal->position++;
+    journal->num_entries++;
+
+    return numLineClears;
+
+}  // End of JournalPlace()
+
+
+int JournalRedo (journalData *journal, gameData *game)
+{
+    const journalEntry *entry = NULL;
+
+    if (journal->position == journal->num_entries)
+    {
+        return -1;
+    }
+
+    entry = &journal->entries[(journal->first + journal->position) % JOURNAL_MAX_ENTRIES];
+
+    BoardRedoDelta (&game->board, &entry->delta);
+    PieceUnpack (entry->piece_after, &game->piece);
+    game->rng = entry->rng_after;
+    game->lines += entry->delta.num_cleared;
+    game->level = entry->level_after;
+    game->pieces++;
+    game->game_status = entry->status_after;
+
+    journal->position++;
+
+    return 0;
+
+}  // End of JournalRedo()
+
+
+void JournalReset (journalData *journal)
+{
+    journal->first = 0;
+    journal->num_entries = 0;
+    journal->position = 0;
+
+}  // End of JournalReset()
+
+
+int JournalUndo (journalData *journal, gameData *game)
+{
+    const journalEntry *entry = NULL;
+
+    if (journal->position == 0)
+    {
+        return -1;
+    }
+
+    journal->position--;
+
+    entry = &journal->entries[(journal->first + journal->position) % JOURNAL_MAX_ENTRIES];
+
+    BoardUndoDelta (&game->board, &entry->delta);
+    PieceUnpack (entry->piece_before, &game->piece);
+    game->rng = entry->rng_before;
+    game->lines -= entry->delta.num_cleared;
+    game->level = entry->level_before;
+    game->pieces--;
+    game->game_status = entry->status_before;
+
+    return 0;
+
+}  // End of JournalUndo()
+
+
+static void MakeDelta (const boardData *board, const pieceData *piece, boardDelta *delta)
+{
+    int ii = 0;  // Loop iterator
+    const pieceShape *shape = &g_pieceShapes[piece->type_index][piece->orientation];
+
+    delta->top = (signed char)piece->y;
+    delta->num_rows = (unsigned char)shape->height;
+    delta->num_cleared = 0;
+
+    // Rows were not full before, so only the rows of the block can clear
+    for (ii=0; ii<shape->height; ii++)
+    {
+        delta->masks[ii] = (unsigned short)(shape->mask[ii] << piece->x);
+        if ((board->rows[piece->y+ii] | delta->masks[ii]) == FULL_ROW_MASK)
+        {
+            delta->cleared[delta->num_cleared++] = (unsigned char)(piece->y + ii);
+        }
+    }
+
+}  // End of MakeDelta()
+
+
+static void RemoveRows (boardData *board, const boardDelta *delta)
+{
+    int cleared = delta->num_cleared - 1;
+    int ii = 0;  // Loop iterator
+    int row = 0;
+
+    if (delta->num_cleared == 0)
+    {
+        return;
+    }
+
+    // Move the rows above the lowest cleared one down over the cleared ones
+    row = delta->cleared[cleared];
+    for (ii=row; ii>=0; ii--)
+    {
+        if ((cleared >= 0) && (ii == delta->cleared[cleared]))
+        {
+            cleared--;
+        }
+        else
+        {
+            board->rows[row--] = board->rows[ii];
+        }
+    }
+
+    for (ii=row; ii>=0; ii--)
+    {
+        board->rows[ii] = 0;
+    }
+
+}  // End of RemoveRows()
+
+
+static void RestoreRows (boardData *board, const boardDelta *delta)
+{
+    int cleared = 0;
+    int ii = 0;  // Loop iterator
+
+    if (delta->num_cleared == 0)
+    {
+        return;
+    }
+
+    // From the top, row ii comes from num_cleared rows further down, less
+    // the cleared rows above it. Rows are only read below where they are
+    // written, so the board can be rebuilt in place.
+    for (ii=0; ii<=delta->cleared[delta->num_cleared-1]; ii++)
+    {
+        if ((cleared < delta->num_cleared) && (ii == delta->cleared[cleared]))
+        {
+            board->rows[ii] = FULL_ROW_MASK;
+            cleared++;
+        }
+        else
+        {
+            board->rows[ii] = board->rows[ii + delta->num_cleared - cleared];
+        }
+    }
+
+}  // End of RestoreRows()
@@ -0,0 +1,86 @@
+//==============================================================================
+//
+// Title:       blockdrop_journal.h
+// Purpose:     Undo and redo of block placements from recorded changes.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_journal_H__
+#define __blockdrop_journal_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_piece.h"
+
+//==============================================================================
+// Constants
+
+#define JOURNAL_MAX_ENTRIES     1024    // Oldest placements are forgotten past this
+
+//==============================================================================
+// Types
+
+// What locking one block changed on the board. Cleared rows are not saved,
+// they were full.
+typedef struct
+{
+    signed char top;                                    // First row the block is in
+    unsigned char num_rows;                             // Rows the block is in
+    unsigned char num_cleared;
+    unsigned char cleared[NUM_SQUARES_PER_BLOCK];       // Rows cleared, top to bottom, before the clear
+    unsigned short masks[NUM_SQUARES_PER_BLOCK];        // Cells the block filled in each of its rows
+} boardDelta;
+
+typedef struct
+{
+    boardDelta delta;
+    packedPiece piece_before;       // Active block before and after the placement
+    packedPiece piece_after;
+    rngData rng_before;
+    rngData rng_after;
+    short level_before;
+    short level_after;
+    signed char status_before;      // GAME_RUN or GAME_END
+    signed char status_after;
+} journalEntry;
+
+typedef struct
+{
+    int first;                      // Oldest entry, entries[] is used as a ring
+    int num_entries;                // Placements that can be undone or redone
+    int position;                   // Placements applied, the ones after it can be redone
+    journalEntry entries[JOURNAL_MAX_ENTRIES];
+} journalData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int BoardLockDelta (boardData *board, const pieceData *piece, boardDelta *delta);
+
+void BoardRedoDelta (boardData *board, const boardDelta *delta);
+
+void BoardUndoDelta (boardData *board, const boardDelta *delta);
+
+int JournalPlace (journalData *journal, gameData *game, const placementData *placement);
+
+int JournalRedo (journalData *journal, gameData *game);
+
+void JournalReset (journalData *journal);
+
+int JournalUndo (journalData *journal, gameData *game);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_journal_H__ */
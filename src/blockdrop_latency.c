@@ -0,0 +1,276 @@
+//==============================================================================
+//
+// Title:       blockdrop_latency.c
+// Purpose:     Latency histograms of the input, simulation and drawing stages
+//              of the user interface.
+//
+//              Recording is a timer read, a few shifts to find the bucket and
+//              an increment, with no locks. The histograms of the stages are
+//              meant for the user interface thread, which runs every callback
+//              of the game; other threads keep their own latencyHistogram.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_latency.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+static latencyHistogram g_stages[LATENCY_NUM_STAGES];
+
+static unsigned long long g_frequency = 0;  // Performance counter ticks per second
+
+static const char *g_stageNames[LATENCY_NUM_STAGES] = { "input", "command", "step", "render", "input_to_render" };
+
+//==============================================================================
+// Static functions
+
+static int BucketIndex (unsigned long long ns);
+
+static unsigned long long BucketValue (int index);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int LatencyDump (const char *path)
+{
+    FILE *file = NULL;
+    const latencyHistogram *histogram = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    char text[1024] = "\0";
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    LatencyFormat (text, sizeof (text));
+    fprintf (file, "%s\n", text);
+
+    // Bucket value in ns and count, for plotting the whole distribution
+    for (ii=0; ii<LATENCY_NUM_STAGES; ii++)
+    {
+        histogram = &g_stages[ii];
+        fprintf (file, "%s\n", g_stageNames[ii]);
+        for (jj=0; jj<LATENCY_NUM_BUCKETS; jj++)
+        {
+            if (histogram->buckets[jj] != 0)
+            {
+                fprintf (file, "  %llu %u\n", BucketValue (jj), histogram->buckets[jj]);
+            }
+        }
+    }
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of LatencyDump()
+
+
+int LatencyFormat (char *text, size_t size)
+{
+    const latencyHistogram *histogram = NULL;
+    int ii = 0;  // Loop iterator
+    size_t length = 0;
+
+    // Microseconds
+    length = snprintf (text, size, "%-16s %8s %8s %8s %8s\n", "stage", "count", "p50", "p99", "max");
+
+    for (ii=0; (ii < LATENCY_NUM_STAGES) && (length < size); ii++)
+    {
+        histogram = &g_stages[ii];
+        length += snprintf (text + length, size - length, "%-16s %8llu %8.0f %8.0f %8.0f\n", g_stageNames[ii],
+                            histogram->count, LatencyHistogramPercentile (histogram, 50.0) / 1000.0,
+                            LatencyHistogramPercentile (histogram, 99.0) / 1000.0, histogram->max_ns / 1000.0);
+    }
+
+    return 0;
+
+}  // End of LatencyFormat()
+
+
+void LatencyHistogramAdd (latencyHistogram *histogram, unsigned long long ns)
+{
+    if ((histogram->count == 0) || (ns < histogram->min_ns))
+    {
+        histogram->min_ns = ns;
+    }
+    if (ns > histogram->max_ns)
+    {
+        histogram->max_ns = ns;
+    }
+
+    histogram->count++;
+    histogram->sum_ns += (double)ns;
+    histogram->buckets[BucketIndex (ns)]++;
+
+}  // End of LatencyHistogramAdd()
+
+
+unsigned long long LatencyHistogramPercentile (const latencyHistogram *histogram, double percentile)
+{
+    unsigned long long count = 0;
+    int ii = 0;  // Loop iterator
+    unsigned long long rank = 0;
+    unsigned long long value = 0;
+
+    if (histogram->count == 0)
+    {
+        return 0;
+    }
+
+    // Smallest value with at least percentile % of the values at or below it
+    rank = (unsigned long long)(percentile / 100.0 * histogram->count + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+
+    for (ii=0; ii<LATENCY_NUM_BUCKETS; ii++)
+    {
+        count += histogram->buckets[ii];
+        if (count >= rank)
+        {
+            break;
+        }
+    }
+
+    value = BucketValue (ii);
+    if (value > histogram->max_ns)
+    {
+        value = histogram->max_ns;
+    }
+    if (value < histogram->min_ns)
+    {
+        value = histogram->min_ns;
+    }
+
+    return value;
+
+}  // End of LatencyHistogramPercentile()
+
+
+void LatencyHistogramReset (latencyHistogram *histogram)
+{
+    memset (histogram, 0, sizeof (latencyHistogram));
+
+}  // End of LatencyHistogramReset()
+
+
+unsigned long long LatencyNow (void)
+{
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    unsigned long long ticks = 0;
+
+    if (g_frequency == 0)
+    {
+        QueryPerformanceFrequency (&frequency);
+        g_frequency = (unsigned long long)frequency.QuadPart;
+    }
+
+    QueryPerformanceCounter (&counter);
+    ticks = (unsigned long long)counter.QuadPart;
+
+    // In two parts so the multiplication cannot overflow
+    return (ticks / g_frequency) * 1000000000ULL + (ticks % g_frequency) * 1000000000ULL / g_frequency;
+
+}  // End of LatencyNow()
+
+
+void LatencyRecord (int stage, unsigned long long start)
+{
+    unsigned long long now = LatencyNow ();
+
+    LatencyHistogramAdd (&g_stages[stage], (now > start) ? now - start : 0);
+
+}  // End of LatencyRecord()
+
+
+void LatencyReset (void)
+{
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<LATENCY_NUM_STAGES; ii++)
+    {
+        LatencyHistogramReset (&g_stages[ii]);
+    }
+
+}  // End of LatencyReset()
+
+
+const latencyHistogram *LatencyStage (int stage)
+{
+    return &g_stages[stage];
+
+}  // End of LatencyStage()
+
+
+const char *LatencyStageName (int stage)
+{
+    return g_stageNames[stage];
+
+}  // End of LatencyStageName()
+
+
+static int BucketIndex (unsigned long long ns)
+{
+    int bits = 0;
+    int msb = 0;  // Highest set bit
+    int shift = 0;
+
+    if (ns < LATENCY_SUB_BUCKETS)
+    {
+        return (int)ns;
+    }
+
+    if (ns >= (1ULL << LATENCY_MAX_BITS))
+    {
+        return LATENCY_NUM_BUCKETS - 1;
+    }
+
+    for (bits=32; bits>0; bits>>=1)
+    {
+        if (ns >> (msb + bits))
+        {
+            msb += bits;
+        }
+    }
+
+    // The LATENCY_SUB_BITS bits below the highest one pick the sub bucket
+    shift = msb - LATENCY_SUB_BITS;
+
+    return (shift + 1) * LATENCY_SUB_BUCKETS + (int)((ns >> shift) - LATENCY_SUB_BUCKETS);
+
+}  // End of BucketIndex()
+
+
+static unsigned long long BucketValue (int index)
+{
+    int shift = index / LATENCY_SUB_BUCKETS - 1;
+    unsigned long long sub = index % LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKETS;
+
+    if (index < LATENCY_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    // Middle of the bucket
+    return (sub << shift) + ((1ULL << shift) >> 1);
+
+}  // End of BucketValue()
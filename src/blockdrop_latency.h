@@ -0,0 +1,84 @@
+//==============================================================================
+//
+// Title:       blockdrop_latency.h
+// Purpose:     Latency histograms of the input, simulation and drawing stages
+//              of the user interface.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_latency_H__
+#define __blockdrop_latency_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "cvi_blockdrop.h"
+
+//==============================================================================
+// Constants
+
+// Stages
+#define LATENCY_STAGE_INPUT         0   // Key press until its move or rotation is done
+#define LATENCY_STAGE_COMMAND       1   // Move and rotate callbacks
+#define LATENCY_STAGE_STEP          2   // AdvanceBlock()
+#define LATENCY_STAGE_RENDER        3   // Drawing the grid changes
+#define LATENCY_STAGE_INPUT_RENDER  4   // Key press until its move or rotation is drawn
+#define LATENCY_NUM_STAGES          5
+
+// Log-linear buckets, every power of two split into LATENCY_SUB_BUCKETS, so
+// values are kept to about 3%. Values of 2^LATENCY_MAX_BITS ns and over share
+// the last bucket.
+#define LATENCY_SUB_BITS            5
+#define LATENCY_SUB_BUCKETS         (1 << LATENCY_SUB_BITS)
+#define LATENCY_MAX_BITS            40
+#define LATENCY_NUM_BUCKETS         ((LATENCY_MAX_BITS - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    unsigned long long count;
+    unsigned long long min_ns;
+    unsigned long long max_ns;
+    double sum_ns;
+    unsigned int buckets[LATENCY_NUM_BUCKETS];
+} latencyHistogram;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int LatencyDump (const char *path);
+
+int LatencyFormat (char *text, size_t size);
+
+void LatencyHistogramAdd (latencyHistogram *histogram, unsigned long long ns);
+
+unsigned long long LatencyHistogramPercentile (const latencyHistogram *histogram, double percentile);
+
+void LatencyHistogramReset (latencyHistogram *histogram);
+
+unsigned long long LatencyNow (void);
+
+void LatencyRecord (int stage, unsigned long long start);
+
+void LatencyReset (void);
+
+const latencyHistogram *LatencyStage (int stage);
+
+const char *LatencyStageName (int stage);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_latency_H__ */
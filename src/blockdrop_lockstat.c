@@ -0,0 +1,226 @@
+//==============================================================================
+//
+// Title:       blockdrop_lockstat.c
+// Purpose:     Thread lock that records wait and hold times per call site.
+//
+//              A get first tries the lock without waiting. When that fails the
+//              acquisition counts as contended and waits for the lock. Every
+//              statistic is updated while the lock is held, so the lock also
+//              protects its own statistics. Nested gets by the holding thread
+//              are counted but only the outermost one is timed as a hold.
+//
+//              With BLOCKDROP_TRACE defined the waits and holds also appear as
+//              lock_wait and lock_held trace zones.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_lockstat.h"
+#include "blockdrop_trace.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int CompareHold (const void *a, const void *b);
+
+static int FindSite (statLock *lock, const char *function, int line);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int StatLockCreate (statLock *lock)
+{
+    memset (lock, 0, sizeof (statLock));
+    lock->holder = -1;
+
+    return (CmtNewLock (NULL, 0, &lock->handle) == 0) ? 0 : -1;
+
+}  // End of StatLockCreate()
+
+
+int StatLockDiscard (statLock *lock)
+{
+    return (CmtDiscardLock (lock->handle) == 0) ? 0 : -1;
+
+}  // End of StatLockDiscard()
+
+
+int StatLockFormat (statLock *lock, char *text, size_t size)
+{
+    unsigned long long acquisitions = 0;
+    unsigned long long contended = 0;
+    int gotLock = 0;
+    int ii = 0;  // Loop iterator
+    size_t length = 0;
+    int numSites = 0;
+    lockSite *site = NULL;
+    lockSite *sites = NULL;
+
+    sites = malloc (LOCKSTAT_MAX_SITES * sizeof (lockSite));
+    if (sites == NULL)
+    {
+        return -1;
+    }
+
+    // Snapshot under the lock, it guards the statistics, without counting as a site
+    if ((CmtGetLockEx (lock->handle, 0, CMT_WAIT_FOREVER, &gotLock) != 0) || (gotLock == 0))
+    {
+        free (sites);
+        return -1;
+    }
+    numSites = lock->num_sites;
+    memcpy (sites, lock->sites, numSites * sizeof (lockSite));
+    CmtReleaseLock (lock->handle);
+
+    // Longest total hold first, microseconds
+    qsort (sites, numSites, sizeof (lockSite), CompareHold);
+
+    length = snprintf (text, size, "%-28s %8s %8s %8s %8s %8s %8s %10s\n", "site", "gets", "waited", "wait99",
+                       "waitmax", "hold50", "hold99", "hold_total");
+
+    for (ii=0; (ii < numSites) && (length < size); ii++)
+    {
+        site = &sites[ii];
+        acquisitions += site->acquisitions;
+        contended += site->contended;
+        length += snprintf (text + length, size - length,
+                            "%-22.22s:%-5d %8llu %8llu %8.0f %8.0f %8.0f %8.0f %10.0f\n", site->function, site->line,
+                            site->acquisitions, site->contended,
+                            LatencyHistogramPercentile (&site->wait, 99.0) / 1000.0, site->wait.max_ns / 1000.0,
+                            LatencyHistogramPercentile (&site->hold, 50.0) / 1000.0,
+                            LatencyHistogramPercentile (&site->hold, 99.0) / 1000.0, site->hold.sum_ns / 1000.0);
+    }
+
+    if (length < size)
+    {
+        snprintf (text + length, size - length, "contended %llu of %llu gets (%.1f%%)\n", contended, acquisitions,
+                  (acquisitions > 0) ? 100.0 * contended / acquisitions : 0.0);
+    }
+
+    free (sites);
+
+    return 0;
+
+}  // End of StatLockFormat()
+
+
+int StatLockGet (statLock *lock, const char *function, int line)
+{
+    int contended = 0;
+    int gotLock = 0;
+    int index = 0;
+    unsigned long long start = LatencyNow ();
+    unsigned long long wait = 0;
+
+    TRACE_BEGIN ("lock_wait");
+
+    if (CmtTryToGetLock (lock->handle, &gotLock) != 0)
+    {
+        TRACE_END ("lock_wait");
+        return -1;
+    }
+
+    if (gotLock == 0)
+    {
+        contended = 1;
+        if ((CmtGetLockEx (lock->handle, 0, CMT_WAIT_FOREVER, &gotLock) != 0) || (gotLock == 0))
+        {
+            TRACE_END ("lock_wait");
+            return -1;
+        }
+    }
+
+    TRACE_END ("lock_wait");
+    TRACE_BEGIN ("lock_held");
+
+    // Held from here on, the statistics are ours to update
+    wait = LatencyNow () - start;
+    index = FindSite (lock, function, line);
+    if (index >= 0)
+    {
+        lock->sites[index].acquisitions++;
+        lock->sites[index].contended += contended;
+        LatencyHistogramAdd (&lock->sites[index].wait, wait);
+    }
+
+    if (lock->depth++ == 0)
+    {
+        lock->holder = index;
+        lock->acquired = start + wait;
+    }
+
+    return 0;
+
+}  // End of StatLockGet()
+
+
+int StatLockRelease (statLock *lock)
+{
+    if (--lock->depth == 0)
+    {
+        if (lock->holder >= 0)
+        {
+            LatencyHistogramAdd (&lock->sites[lock->holder].hold, LatencyNow () - lock->acquired);
+        }
+        lock->holder = -1;
+    }
+
+    TRACE_END ("lock_held");
+
+    return (CmtReleaseLock (lock->handle) == 0) ? 0 : -1;
+
+}  // End of StatLockRelease()
+
+
+static int CompareHold (const void *a, const void *b)
+{
+    double x = ((const lockSite *)a)->hold.sum_ns;
+    double y = ((const lockSite *)b)->hold.sum_ns;
+
+    return (x < y) - (x > y);
+
+}  // End of CompareHold()
+
+
+static int FindSite (statLock *lock, const char *function, int line)
+{
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<lock->num_sites; ii++)
+    {
+        if ((lock->sites[ii].line == line) && (strcmp (lock->sites[ii].function, function) == 0))
+        {
+            return ii;
+        }
+    }
+
+    // Sites past LOCKSTAT_MAX_SITES are not recorded
+    if (lock->num_sites == LOCKSTAT_MAX_SITES)
+    {
+        return -1;
+    }
+
+    memset (&lock->sites[ii], 0, sizeof (lockSite));
+    lock->sites[ii].function = function;
+    lock->sites[ii].line = line;
+    lock->num_sites++;
+
+    return ii;
+
+}  // End of FindSite()
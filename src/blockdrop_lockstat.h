@@ -0,0 +1,73 @@
+//==============================================================================
+//
+// Title:       blockdrop_lockstat.h
+// Purpose:     Thread lock that records wait and hold times per call site.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_lockstat_H__
+#define __blockdrop_lockstat_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_latency.h"
+
+//==============================================================================
+// Constants
+
+#define LOCKSTAT_MAX_SITES      32
+
+// Gets the lock and records the calling function and line as the holder
+#define STAT_LOCK_GET(lock)     StatLockGet ((lock), __func__, __LINE__)
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const char *function;
+    int line;
+    unsigned long long acquisitions;
+    unsigned long long contended;           // Acquisitions that found the lock held
+    latencyHistogram wait;
+    latencyHistogram hold;
+} lockSite;
+
+typedef struct
+{
+    CmtThreadLockHandle handle;
+    int depth;                              // Nested gets by the holding thread
+    int holder;                             // Site of the outermost get, -1 when free
+    unsigned long long acquired;            // Time of the outermost get, ns
+    int num_sites;
+    lockSite sites[LOCKSTAT_MAX_SITES];
+} statLock;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int StatLockCreate (statLock *lock);
+
+int StatLockDiscard (statLock *lock);
+
+int StatLockFormat (statLock *lock, char *text, size_t size);
+
+int StatLockGet (statLock *lock, const char *function, int line);
+
+int StatLockRelease (statLock *lock);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_lockstat_H__ */
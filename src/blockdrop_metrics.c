@@ -0,0 +1,274 @@
+//==============================================================================
+//
+// Title:       blockdrop_metrics.c
+// Purpose:     Live game metrics in shared memory for monitors in other
+//              processes.
+//
+//              The game owns a named file mapping holding one metricsHeader
+//              and publishes a snapshot into it with a sequence lock: two
+//              interlocked increments around a copy, no system calls and no
+//              waiting on readers. A monitor maps the same name and copies
+//              the snapshot out, retrying while the game is writing.
+//
+//              MetricsFormatPrometheus() turns a snapshot into the Prometheus
+//              text exposition format.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_metrics.h"
+
+//==============================================================================
+// Constants
+
+#define MAX_OBJECT_NAME         (METRICS_MAX_NAME + 32)
+#define METRICS_READ_RETRIES    1000
+
+//==============================================================================
+// Types
+
+struct metricsData
+{
+    HANDLE mapping;
+    metricsHeader *header;
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static LONG ReadSequence (volatile LONG *sequence);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void MetricsClose (metricsData *metrics)
+{
+    if (metrics == NULL)
+    {
+        return;
+    }
+
+    if (metrics->header != NULL)
+    {
+        UnmapViewOfFile (metrics->header);
+    }
+    if (metrics->mapping != NULL)
+    {
+        CloseHandle (metrics->mapping);
+    }
+
+    free (metrics);
+
+}  // End of MetricsClose()
+
+
+int MetricsCreate (const char *name, metricsData **metrics)
+{
+    char mappingName[MAX_OBJECT_NAME] = "\0";
+    metricsData *newMetrics = NULL;
+
+    *metrics = NULL;
+
+    if (strlen (name) >= METRICS_MAX_NAME)
+    {
+        return -1;
+    }
+
+    newMetrics = calloc (1, sizeof (metricsData));
+    if (newMetrics == NULL)
+    {
+        return -1;
+    }
+
+    sprintf (mappingName, "Local\\blockdrop_metrics_%s", name);
+    newMetrics->mapping = CreateFileMapping (INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+                                             (DWORD)sizeof (metricsHeader), mappingName);
+
+    // Only one game per name
+    if ((newMetrics->mapping == NULL) || (GetLastError () == ERROR_ALREADY_EXISTS))
+    {
+        MetricsClose (newMetrics);
+        return -1;
+    }
+
+    newMetrics->header = MapViewOfFile (newMetrics->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (newMetrics->header == NULL)
+    {
+        MetricsClose (newMetrics);
+        return -1;
+    }
+
+    // The magic goes in last, so a monitor never sees a half written header
+    memset (newMetrics->header, 0, sizeof (metricsHeader));
+    newMetrics->header->version = METRICS_VERSION;
+    newMetrics->header->size = sizeof (metricsHeader);
+    newMetrics->header->num_stages = LATENCY_NUM_STAGES;
+    InterlockedExchangeAdd ((volatile LONG *)&newMetrics->header->magic, METRICS_MAGIC);
+
+    *metrics = newMetrics;
+
+    return 0;
+
+}  // End of MetricsCreate()
+
+
+int MetricsFormatPrometheus (const metricsSnapshot *snapshot, char *text, size_t size)
+{
+    int ii = 0;  // Loop iterator
+    size_t length = 0;
+    const metricsStage *stage = NULL;
+
+    length = snprintf (text, size,
+                       "# HELP blockdrop_ticks_total Block steps.\n"
+                       "# TYPE blockdrop_ticks_total counter\n"
+                       "blockdrop_ticks_total %llu\n"
+                       "# HELP blockdrop_pieces_total Blocks spawned.\n"
+                       "# TYPE blockdrop_pieces_total counter\n"
+                       "blockdrop_pieces_total %llu\n"
+                       "# HELP blockdrop_lines_total Lines cleared.\n"
+                       "# TYPE blockdrop_lines_total counter\n"
+                       "blockdrop_lines_total %llu\n"
+                       "# HELP blockdrop_frame_drops_total Timer ticks that came at least one interval late.\n"
+                       "# TYPE blockdrop_frame_drops_total counter\n"
+                       "blockdrop_frame_drops_total %llu\n"
+                       "# HELP blockdrop_sounds_total Sound effects started.\n"
+                       "# TYPE blockdrop_sounds_total counter\n"
+                       "blockdrop_sounds_total %llu\n"
+                       "# HELP blockdrop_level Level of the current game.\n"
+                       "# TYPE blockdrop_level gauge\n"
+                       "blockdrop_level %d\n"
+                       "# HELP blockdrop_game_running 1 while a game is running.\n"
+                       "# TYPE blockdrop_game_running gauge\n"
+                       "blockdrop_game_running %d\n"
+                       "# HELP blockdrop_last_update_timestamp_seconds Time of the last publish.\n"
+                       "# TYPE blockdrop_last_update_timestamp_seconds gauge\n"
+                       "blockdrop_last_update_timestamp_seconds %.3f\n"
+                       "# HELP blockdrop_stage_latency_seconds Latency of the user interface stages.\n"
+                       "# TYPE blockdrop_stage_latency_seconds summary\n",
+                       snapshot->ticks, snapshot->pieces, snapshot->lines, snapshot->frame_drops, snapshot->sounds,
+                       snapshot->level, (snapshot->game_status == GAME_RUN) ? 1 : 0, snapshot->update_time);
+
+    for (ii=0; (ii < LATENCY_NUM_STAGES) && (length < size); ii++)
+    {
+        stage = &snapshot->stages[ii];
+        length += snprintf (text + length, size - length,
+                            "blockdrop_stage_latency_seconds{stage=\"%s\",quantile=\"0.5\"} %.9f\n"
+                            "blockdrop_stage_latency_seconds{stage=\"%s\",quantile=\"0.99\"} %.9f\n"
+                            "blockdrop_stage_latency_seconds_sum{stage=\"%s\"} %.9f\n"
+                            "blockdrop_stage_latency_seconds_count{stage=\"%s\"} %llu\n",
+                            LatencyStageName (ii), stage->p50_ns / 1e9, LatencyStageName (ii), stage->p99_ns / 1e9,
+                            LatencyStageName (ii), stage->sum_ns / 1e9, LatencyStageName (ii), stage->count);
+    }
+
+    if (length < size)
+    {
+        length += snprintf (text + length, size - length,
+                            "# HELP blockdrop_stage_latency_max_seconds Longest latency of the stage.\n"
+                            "# TYPE blockdrop_stage_latency_max_seconds gauge\n");
+    }
+
+    for (ii=0; (ii < LATENCY_NUM_STAGES) && (length < size); ii++)
+    {
+        length += snprintf (text + length, size - length, "blockdrop_stage_latency_max_seconds{stage=\"%s\"} %.9f\n",
+                            LatencyStageName (ii), snapshot->stages[ii].max_ns / 1e9);
+    }
+
+    return (length < size) ? 0 : -1;
+
+}  // End of MetricsFormatPrometheus()
+
+
+int MetricsOpen (const char *name, metricsData **metrics)
+{
+    char mappingName[MAX_OBJECT_NAME] = "\0";
+    metricsData *newMetrics = NULL;
+
+    *metrics = NULL;
+
+    if (strlen (name) >= METRICS_MAX_NAME)
+    {
+        return -1;
+    }
+
+    newMetrics = calloc (1, sizeof (metricsData));
+    if (newMetrics == NULL)
+    {
+        return -1;
+    }
+
+    sprintf (mappingName, "Local\\blockdrop_metrics_%s", name);
+    newMetrics->mapping = OpenFileMapping (FILE_MAP_ALL_ACCESS, FALSE, mappingName);
+    if (newMetrics->mapping != NULL)
+    {
+        newMetrics->header = MapViewOfFile (newMetrics->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    }
+
+    if ((newMetrics->header == NULL) ||
+        (ReadSequence ((volatile LONG *)&newMetrics->header->magic) != METRICS_MAGIC) ||
+        (newMetrics->header->version != METRICS_VERSION) || (newMetrics->header->size != sizeof (metricsHeader)))
+    {
+        MetricsClose (newMetrics);
+        return -1;
+    }
+
+    *metrics = newMetrics;
+
+    return 0;
+
+}  // End of MetricsOpen()
+
+
+void MetricsPublish (metricsData *metrics, const metricsSnapshot *snapshot)
+{
+    // Odd while the snapshot is being written, both increments are full barriers
+    InterlockedIncrement (&metrics->header->sequence);
+    metrics->header->snapshot = *snapshot;
+    InterlockedIncrement (&metrics->header->sequence);
+
+}  // End of MetricsPublish()
+
+
+int MetricsRead (metricsData *metrics, metricsSnapshot *snapshot)
+{
+    LONG after = 0;
+    LONG before = 0;
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<METRICS_READ_RETRIES; ii++)
+    {
+        before = ReadSequence (&metrics->header->sequence);
+        if (before & 1)
+        {
+            continue;
+        }
+
+        memcpy (snapshot, &metrics->header->snapshot, sizeof (metricsSnapshot));
+
+        after = ReadSequence (&metrics->header->sequence);
+        if (after == before)
+        {
+            return 0;
+        }
+    }
+
+    return -1;
+
+}  // End of MetricsRead()
+
+
+static LONG ReadSequence (volatile LONG *sequence)
+{
+    // Full barrier, so the snapshot is read between the two sequence reads
+    return InterlockedCompareExchange (sequence, 0, 0);
+
+}  // End of ReadSequence()
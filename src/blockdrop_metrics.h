@@ -0,0 +1,94 @@
+//==============================================================================
+//
+// Title:       blockdrop_metrics.h
+// Purpose:     Live game metrics in shared memory for monitors in other
+//              processes.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_metrics_H__
+#define __blockdrop_metrics_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_latency.h"
+
+//==============================================================================
+// Constants
+
+#define METRICS_MAGIC           0x4D444C42  // "BLDM"
+#define METRICS_VERSION         1
+#define METRICS_MAX_NAME        64
+#define METRICS_DEFAULT_NAME    "game"
+#define METRICS_TEXT_SIZE       8192  // Enough for MetricsFormatPrometheus()
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    unsigned long long count;
+    unsigned long long p50_ns;
+    unsigned long long p99_ns;
+    unsigned long long max_ns;
+    double sum_ns;
+} metricsStage;
+
+typedef struct
+{
+    unsigned long long ticks;               // AdvanceBlock() steps
+    unsigned long long pieces;              // Blocks spawned
+    unsigned long long lines;               // Lines cleared, all games
+    unsigned long long frame_drops;         // Timer ticks that came at least one interval late
+    unsigned long long sounds;              // Sound effects started
+    int level;                              // Of the current game
+    int game_status;                        // GAME_RUN or GAME_END
+    double update_time;                     // Seconds since 1970 of the last publish
+    metricsStage stages[LATENCY_NUM_STAGES];
+} metricsSnapshot;
+
+// Whole shared memory. The game makes sequence odd, writes the snapshot and
+// makes it even again, so a reader retries when it is odd or has changed.
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int size;                      // sizeof (metricsHeader)
+    unsigned int num_stages;
+    volatile LONG sequence;
+    char padding[44];
+    metricsSnapshot snapshot;
+} metricsHeader;
+
+typedef struct metricsData metricsData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void MetricsClose (metricsData *metrics);
+
+int MetricsCreate (const char *name, metricsData **metrics);
+
+int MetricsFormatPrometheus (const metricsSnapshot *snapshot, char *text, size_t size);
+
+int MetricsOpen (const char *name, metricsData **metrics);
+
+void MetricsPublish (metricsData *metrics, const metricsSnapshot *snapshot);
+
+int MetricsRead (metricsData *metrics, metricsSnapshot *snapshot);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_metrics_H__ */
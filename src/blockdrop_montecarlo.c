@@ -0,0 +1,298 @@
+//==============================================================================
+//
+// Title:       blockdrop_montecarlo.c
+// Purpose:     Monte Carlo evaluation of block placements.
+//
+//              Each candidate placement of the active block is scored by many
+//              short random rollouts in which the greedy policy places the
+//              following blocks. Rollouts run on a thread pool; every worker
+//              owns its random generator and statistics, so no locks are
+//              taken until the results are merged.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_montecarlo.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const mcConfig *config;
+    int num_candidates;
+    boardData boards[MAX_PLACEMENTS];  // Board after each candidate is locked
+    int lines[MAX_PLACEMENTS];         // Lines cleared by each candidate
+    double deadline;
+    int max_rounds;
+} mcJob;
+
+typedef struct
+{
+    const mcJob *job;
+    int index;
+    rngData rng;
+    int rollouts[MAX_PLACEMENTS];
+    int survived[MAX_PLACEMENTS];
+    double lines_sum[MAX_PLACEMENTS];
+    double lines_sq[MAX_PLACEMENTS];
+    char padding[64];  // Keep workers on separate cache lines
+} mcWorker;
+
+//==============================================================================
+// Static global variables
+
+static CmtThreadPoolHandle mcPool = 0;
+
+static int mcPoolThreads = 0;
+
+static mcJob mcSharedJob;
+
+static mcWorker mcWorkers[MC_MAX_THREADS];
+
+//==============================================================================
+// Static functions
+
+static int CVICALLBACK MonteCarloWorker (void *functionData);
+
+static int Rollout (const boardData *board, rngData *rng, int depth, const weightData *weights,
+                    int *lines);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void MonteCarloDefaultConfig (mcConfig *config)
+{
+    memset (config, 0, sizeof (mcConfig));
+
+    config->rollout_depth = MC_DEFAULT_DEPTH;
+    config->time_budget = MC_DEFAULT_TIME_BUDGET;
+    config->seed = (unsigned long long)time (NULL);
+    config->weights = g_defaultWeights;
+
+}  // End of MonteCarloDefaultConfig()
+
+
+int MonteCarloDiscard (void)
+{
+    if (mcPool != 0)
+    {
+        CmtDiscardThreadPool (mcPool);
+        mcPool = 0;
+        mcPoolThreads = 0;
+    }
+
+    return 0;
+
+}  // End of MonteCarloDiscard()
+
+
+int MonteCarloEvaluate (const gameData *game, const mcConfig *config, mcResult results[],
+                        int *best_index)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    double mean = 0.0;
+    int numThreads = config->num_threads;
+    int numRollouts = 0;
+    int numSurvived = 0;
+    pieceData piece = game->piece;
+    placementData placements[MAX_PLACEMENTS];
+    int status = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double variance = 0.0;
+    void *workerData[MC_MAX_THREADS] = {NULL};
+
+    *best_index = -1;
+
+    if (game->game_status == GAME_END)
+    {
+        return 0;
+    }
+
+    if (numThreads <= 0)
+    {
+        numThreads = GetNumProcessors ();
+    }
+    if (numThreads > MC_MAX_THREADS)
+    {
+        numThreads = MC_MAX_THREADS;
+    }
+
+    // Reuse the thread pool between moves
+    if ((mcPool != 0) && (mcPoolThreads != numThreads))
+    {
+        MonteCarloDiscard ();
+    }
+    if (mcPool == 0)
+    {
+        status = CmtNewThreadPool (numThreads, &mcPool);
+        if (status < 0)
+        {
+            mcPool = 0;
+            return -1;
+        }
+        mcPoolThreads = numThreads;
+    }
+
+    // Lock every candidate once up front
+    mcSharedJob.config = config;
+    mcSharedJob.num_candidates = EnumeratePlacements (&game->board, piece.type_index, placements);
+    for (ii=0; ii<mcSharedJob.num_candidates; ii++)
+    {
+        piece.orientation = placements[ii].orientation;
+        piece.x = placements[ii].x;
+        piece.y = placements[ii].y;
+
+        mcSharedJob.boards[ii] = game->board;
+        mcSharedJob.lines[ii] = BoardLockPiece (&mcSharedJob.boards[ii], &piece);
+    }
+
+    mcSharedJob.max_rounds = 0;
+    if (config->max_rollouts > 0)
+    {
+        mcSharedJob.max_rounds = (config->max_rollouts + numThreads - 1) / numThreads;
+    }
+    mcSharedJob.deadline = Timer () + config->time_budget;
+
+    for (ii=0; ii<numThreads; ii++)
+    {
+        memset (&mcWorkers[ii], 0, sizeof (mcWorker));
+        mcWorkers[ii].job = &mcSharedJob;
+        mcWorkers[ii].index = ii;
+        RngSeed (&mcWorkers[ii].rng, config->seed + ii);
+        workerData[ii] = &mcWorkers[ii];
+    }
+
+    // Runs without processing events: a callback run while waiting could start another evaluation
+    // over mcSharedJob and mcWorkers, or discard the pool, while the workers still use them
+    if (ThreadPoolRun (mcPool, MonteCarloWorker, workerData, numThreads) != 0)
+    {
+        return -1;
+    }
+
+    // Merge the per worker statistics
+    for (ii=0; ii<mcSharedJob.num_candidates; ii++)
+    {
+        numRollouts = 0;
+        numSurvived = 0;
+        sum = 0.0;
+        sumSquares = 0.0;
+
+        for (jj=0; jj<numThreads; jj++)
+        {
+            numRollouts += mcWorkers[jj].rollouts[ii];
+            numSurvived += mcWorkers[jj].survived[ii];
+            sum += mcWorkers[jj].lines_sum[ii];
+            sumSquares += mcWorkers[jj].lines_sq[ii];
+        }
+
+        results[ii].placement = placements[ii];
+        results[ii].rollouts = numRollouts;
+        results[ii].survival = 0.0;
+        results[ii].survival_ci = 1.0;
+        results[ii].lines = mcSharedJob.lines[ii];
+        results[ii].lines_ci = 0.0;
+
+        if (numRollouts > 0)
+        {
+            mean = sum / numRollouts;
+            variance = (numRollouts > 1) ? (sumSquares - (sum * mean)) / (numRollouts - 1) : 0.0;
+            if (variance < 0.0)
+            {
+                variance = 0.0;
+            }
+
+            results[ii].survival = (double)numSurvived / numRollouts;
+            results[ii].survival_ci = MC_CONFIDENCE_Z *
+                                      sqrt (results[ii].survival * (1.0 - results[ii].survival) / numRollouts);
+            results[ii].lines = mcSharedJob.lines[ii] + mean;
+            results[ii].lines_ci = MC_CONFIDENCE_Z * sqrt (variance / numRollouts);
+        }
+
+        // Prefer survival, then lines cleared
+        if ((*best_index < 0) ||
+            (results[ii].survival > results[*best_index].survival) ||
+            ((results[ii].survival == results[*best_index].survival) &&
+             (results[ii].lines > results[*best_index].lines)))
+        {
+            *best_index = ii;
+        }
+    }
+
+    return mcSharedJob.num_candidates;
+
+}  // End of MonteCarloEvaluate()
+
+
+static int CVICALLBACK MonteCarloWorker (void *functionData)
+{
+    mcWorker *worker = (mcWorker *)functionData;
+    const mcJob *job = worker->job;
+    int ii = 0;  // Loop iterator
+    int lines = 0;
+    int round = 0;
+
+    for (round=0; (job->max_rounds == 0) || (round < job->max_rounds); round++)
+    {
+        for (ii=0; ii<job->num_candidates; ii++)
+        {
+            // The first worker always finishes one round so every candidate has a sample
+            if (((round > 0) || (worker->index > 0)) && (Timer () >= job->deadline))
+            {
+                return 0;
+            }
+
+            lines = 0;
+            worker->survived[ii] += Rollout (&job->boards[ii], &worker->rng, job->config->rollout_depth,
+                                             &job->config->weights, &lines);
+            worker->rollouts[ii]++;
+            worker->lines_sum[ii] += lines;
+            worker->lines_sq[ii] += (double)lines * lines;
+        }
+    }
+
+    return 0;
+
+}  // End of MonteCarloWorker()
+
+
+static int Rollout (const boardData *board, rngData *rng, int depth, const weightData *weights,
+                    int *lines)
+{
+    int ii = 0;  // Loop iterator
+    pieceData piece = {0};
+    placementData placement = {0};
+    boardData scratch = *board;
+
+    for (ii=0; ii<depth; ii++)
+    {
+        PieceSpawn (RngRange (rng, NUM_BLOCKS_TYPES), &piece);
+
+        // Game over
+        if ((PieceFits (&scratch, &piece) == 0) ||
+            (ChooseGreedyPlacement (&scratch, piece.type_index, weights, &placement) == 0))
+        {
+            return 0;
+        }
+
+        piece.orientation = placement.orientation;
+        piece.x = placement.x;
+        piece.y = placement.y;
+        *lines += BoardLockPiece (&scratch, &piece);
+    }
+
+    return 1;
+
+}  // End of Rollout()
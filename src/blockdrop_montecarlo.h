@@ -0,0 +1,70 @@
+//==============================================================================
+//
+// Title:       blockdrop_montecarlo.h
+// Purpose:     Monte Carlo evaluation of block placements.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_montecarlo_H__
+#define __blockdrop_montecarlo_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define MC_MAX_THREADS          64
+#define MC_DEFAULT_DEPTH        8      // blocks per rollout
+#define MC_DEFAULT_TIME_BUDGET  0.25   // seconds per move
+#define MC_CONFIDENCE_Z         1.96   // 95% confidence interval
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_threads;            // 0 uses one thread per processor
+    int rollout_depth;          // Random blocks played after the candidate
+    int max_rollouts;           // Per candidate, 0 runs until the time budget expires
+    double time_budget;         // seconds
+    unsigned long long seed;
+    weightData weights;         // Greedy policy used inside the rollouts
+} mcConfig;
+
+typedef struct
+{
+    placementData placement;
+    int rollouts;
+    double survival;            // Fraction of rollouts that did not end the game
+    double survival_ci;         // Half width of the confidence interval
+    double lines;               // Mean lines cleared, including the candidate itself
+    double lines_ci;
+} mcResult;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void MonteCarloDefaultConfig (mcConfig *config);
+
+int MonteCarloDiscard (void);
+
+int MonteCarloEvaluate (const gameData *game, const mcConfig *config, mcResult results[],
+                        int *best_index);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_montecarlo_H__ */
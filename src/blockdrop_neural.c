@@ -0,0 +1,452 @@
+//==============================================================================
+//
+// Title:       blockdrop_neural.c
+// Purpose:     Int8 quantized neural network board evaluator.
+//
+//              A two hidden layer network scores a board from its filled cells
+//              and the lines just cleared. Inputs are 0 or 1, so the first
+//              layer adds one weight column per filled cell instead of a full
+//              matrix product. Candidate placements of the same block share
+//              the first layer sums of the board they start from and only add
+//              the four cells of the block, unless the block clears lines.
+//
+//              The kernels are fixed width loops of NEURAL_LANES over
+//              contiguous int8 weights, with 16 bit first layer sums, which
+//              the compiler turns into SIMD code without intrinsics or
+//              external libraries.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_neural.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void AccumulateBoard (const neuralNet *net, const boardData *board, int lines, short sums[]);
+
+static void AddInput (const neuralNet *net, int input, short * restrict sums);
+
+static int AllocateNet (const neuralHeader *header, neuralNet **net);
+
+static int CheckBiases (const neuralNet *net);
+
+static double Forward (const neuralNet *net, const short sums[]);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int ChooseNeuralPlacement (const neuralNet *net, const boardData *board, int type_index, placementData *best)
+{
+    double bestScore = 0.0;
+    int ii = 0;  // Loop iterator
+    int numPlacements = 0;
+    placementData placements[MAX_PLACEMENTS];
+    double scores[MAX_PLACEMENTS];
+
+    numPlacements = EnumeratePlacements (board, type_index, placements);
+    NeuralEvaluatePlacements (net, board, type_index, placements, numPlacements, scores);
+
+    for (ii=0; ii<numPlacements; ii++)
+    {
+        if ((ii == 0) || (scores[ii] > bestScore))
+        {
+            bestScore = scores[ii];
+            *best = placements[ii];
+        }
+    }
+
+    return numPlacements;
+
+}  // End of ChooseNeuralPlacement()
+
+
+int NeuralCreateRandom (int hidden1, int hidden2, unsigned long long seed, neuralNet **net)
+{
+    neuralHeader header = {0};
+    int ii = 0;  // Loop iterator
+    rngData rng;
+
+    header.magic = NEURAL_MAGIC;
+    header.version = NEURAL_VERSION;
+    header.num_inputs = NEURAL_NUM_INPUTS;
+    header.hidden1 = hidden1;
+    header.hidden2 = hidden2;
+    header.shift1 = 1;
+    header.shift2 = 6;
+    header.output_scale = 0.001f;
+
+    if (AllocateNet (&header, net) != 0)
+    {
+        return -1;
+    }
+
+    // Untrained, for benchmarks and as a starting point for training
+    RngSeed (&rng, seed);
+    for (ii=0; ii<NEURAL_NUM_INPUTS*hidden1; ii++)
+    {
+        (*net)->w1[ii] = (signed char)(RngRange (&rng, 65) - 32);
+    }
+    for (ii=0; ii<hidden1; ii++)
+    {
+        (*net)->b1[ii] = RngRange (&rng, 129) - 64;
+    }
+    for (ii=0; ii<hidden2*hidden1; ii++)
+    {
+        (*net)->w2[ii] = (signed char)(RngRange (&rng, 65) - 32);
+    }
+    for (ii=0; ii<hidden2; ii++)
+    {
+        (*net)->b2[ii] = RngRange (&rng, 129) - 64;
+        (*net)->w3[ii] = (signed char)(RngRange (&rng, 65) - 32);
+    }
+    (*net)->b3 = 0;
+
+    return 0;
+
+}  // End of NeuralCreateRandom()
+
+
+void NeuralDiscard (neuralNet *net)
+{
+    if (net == NULL)
+    {
+        return;
+    }
+
+    free (net->w1);
+    free (net->b1);
+    free (net->w2);
+    free (net->b2);
+    free (net->w3);
+    free (net);
+
+}  // End of NeuralDiscard()
+
+
+int NeuralEvaluateBatch (const neuralNet *net, const boardData boards[], const int lines[], int num_boards,
+                         double scores[])
+{
+    int ii = 0;  // Loop iterator
+    short sums[NEURAL_MAX_HIDDEN];
+
+    for (ii=0; ii<num_boards; ii++)
+    {
+        AccumulateBoard (net, &boards[ii], (lines != NULL) ? lines[ii] : 0, sums);
+        scores[ii] = Forward (net, sums);
+    }
+
+    return num_boards;
+
+}  // End of NeuralEvaluateBatch()
+
+
+int NeuralEvaluatePlacements (const neuralNet *net, const boardData *board, int type_index,
+                              const placementData placements[], int num_placements, double scores[])
+{
+    boardData after = {0};
+    short baseSums[NEURAL_MAX_HIDDEN];
+    unsigned int cells = 0;
+    int column = 0;
+    int hidden1 = (int)net->header.hidden1;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int lines = 0;
+    pieceData piece = {0};
+    const pieceShape *shape = NULL;
+    short sums[NEURAL_MAX_HIDDEN];
+
+    AccumulateBoard (net, board, 0, baseSums);
+
+    piece.type_index = type_index;
+
+    for (ii=0; ii<num_placements; ii++)
+    {
+        piece.orientation = placements[ii].orientation;
+        piece.x = placements[ii].x;
+        piece.y = placements[ii].y;
+
+        after = *board;
+        lines = BoardLockPiece (&after, &piece);
+
+        // Cleared lines move every row above them, so start over
+        if (lines > 0)
+        {
+            AccumulateBoard (net, &after, lines, sums);
+        }
+        else
+        {
+            memcpy (sums, baseSums, hidden1 * sizeof (short));
+
+            shape = &g_pieceShapes[type_index][piece.orientation];
+            for (jj=0; jj<shape->height; jj++)
+            {
+                cells = shape->mask[jj];
+                for (column=piece.x; cells != 0; column++, cells >>= 1)
+                {
+                    if (cells & 1)
+                    {
+                        AddInput (net, (piece.y + jj) * GRID_NUM_COLS + column, sums);
+                    }
+                }
+            }
+        }
+
+        scores[ii] = Forward (net, sums);
+    }
+
+    return num_placements;
+
+}  // End of NeuralEvaluatePlacements()
+
+
+int NeuralLoad (const char *path, neuralNet **net)
+{
+    FILE *file = NULL;
+    neuralHeader header = {0};
+    int hidden1 = 0;
+    int hidden2 = 0;
+    int status = 0;
+
+    *net = NULL;
+
+    file = fopen (path, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fread (&header, sizeof (header), 1, file) != 1) || (header.magic != NEURAL_MAGIC) ||
+        (header.version != NEURAL_VERSION) || (header.num_inputs != NEURAL_NUM_INPUTS) ||
+        (AllocateNet (&header, net) != 0))
+    {
+        fclose (file);
+        return -1;
+    }
+
+    hidden1 = (int)header.hidden1;
+    hidden2 = (int)header.hidden2;
+
+    if ((fread ((*net)->w1, 1, NEURAL_NUM_INPUTS * hidden1, file) != (size_t)(NEURAL_NUM_INPUTS * hidden1)) ||
+        (fread ((*net)->b1, sizeof (int), hidden1, file) != (size_t)hidden1) ||
+        (fread ((*net)->w2, 1, hidden2 * hidden1, file) != (size_t)(hidden2 * hidden1)) ||
+        (fread ((*net)->b2, sizeof (int), hidden2, file) != (size_t)hidden2) ||
+        (fread ((*net)->w3, 1, hidden2, file) != (size_t)hidden2) ||
+        (fread (&(*net)->b3, sizeof (int), 1, file) != 1) || (CheckBiases (*net) != 0))
+    {
+        NeuralDiscard (*net);
+        *net = NULL;
+        status = -1;
+    }
+
+    fclose (file);
+
+    return status;
+
+}  // End of NeuralLoad()
+
+
+int NeuralSave (const neuralNet *net, const char *path)
+{
+    FILE *file = NULL;
+    int hidden1 = (int)net->header.hidden1;
+    int hidden2 = (int)net->header.hidden2;
+    int status = 0;
+
+    file = fopen (path, "wb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fwrite (&net->header, sizeof (neuralHeader), 1, file) != 1) ||
+        (fwrite (net->w1, 1, NEURAL_NUM_INPUTS * hidden1, file) != (size_t)(NEURAL_NUM_INPUTS * hidden1)) ||
+        (fwrite (net->b1, sizeof (int), hidden1, file) != (size_t)hidden1) ||
+        (fwrite (net->w2, 1, hidden2 * hidden1, file) != (size_t)(hidden2 * hidden1)) ||
+        (fwrite (net->b2, sizeof (int), hidden2, file) != (size_t)hidden2) ||
+        (fwrite (net->w3, 1, hidden2, file) != (size_t)hidden2) ||
+        (fwrite (&net->b3, sizeof (int), 1, file) != 1))
+    {
+        status = -1;
+    }
+
+    if (fclose (file) != 0)
+    {
+        status = -1;
+    }
+
+    return status;
+
+}  // End of NeuralSave()
+
+
+static void AccumulateBoard (const neuralNet *net, const boardData *board, int lines, short sums[])
+{
+    unsigned int bits = 0;
+    int column = 0;
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<(int)net->header.hidden1; ii++)
+    {
+        sums[ii] = (short)net->b1[ii];
+    }
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        for (bits=board->rows[ii], column=0; bits != 0; bits >>= 1, column++)
+        {
+            if (bits & 1)
+            {
+                AddInput (net, ii * GRID_NUM_COLS + column, sums);
+            }
+        }
+    }
+
+    if ((lines > 0) && (lines <= 4))
+    {
+        AddInput (net, NEURAL_NUM_CELLS + lines - 1, sums);
+    }
+
+}  // End of AccumulateBoard()
+
+
+static void AddInput (const neuralNet *net, int input, short * restrict sums)
+{
+    int hidden1 = (int)net->header.hidden1;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    const signed char * restrict weights = net->w1 + input * hidden1;
+
+    for (ii=0; ii<hidden1; ii+=NEURAL_LANES)
+    {
+        for (jj=0; jj<NEURAL_LANES; jj++)
+        {
+            sums[ii+jj] += weights[ii+jj];
+        }
+    }
+
+}  // End of AddInput()
+
+
+static int AllocateNet (const neuralHeader *header, neuralNet **net)
+{
+    int hidden1 = (int)header->hidden1;
+    int hidden2 = (int)header->hidden2;
+    neuralNet *newNet = NULL;
+
+    *net = NULL;
+
+    // Whole vectors only
+    if ((hidden1 < NEURAL_LANES) || (hidden1 > NEURAL_MAX_HIDDEN) || ((hidden1 % NEURAL_LANES) != 0) ||
+        (hidden2 < NEURAL_LANES) || (hidden2 > NEURAL_MAX_HIDDEN) || ((hidden2 % NEURAL_LANES) != 0) ||
+        (header->shift1 > 30) || (header->shift2 > 30))
+    {
+        return -1;
+    }
+
+    newNet = calloc (1, sizeof (neuralNet));
+    if (newNet == NULL)
+    {
+        return -1;
+    }
+
+    newNet->header = *header;
+    newNet->w1 = malloc (NEURAL_NUM_INPUTS * hidden1);
+    newNet->b1 = malloc (hidden1 * sizeof (int));
+    newNet->w2 = malloc (hidden2 * hidden1);
+    newNet->b2 = malloc (hidden2 * sizeof (int));
+    newNet->w3 = malloc (hidden2);
+
+    if ((newNet->w1 == NULL) || (newNet->b1 == NULL) || (newNet->w2 == NULL) ||
+        (newNet->b2 == NULL) || (newNet->w3 == NULL))
+    {
+        NeuralDiscard (newNet);
+        return -1;
+    }
+
+    *net = newNet;
+
+    return 0;
+
+}  // End of AllocateNet()
+
+
+static int CheckBiases (const neuralNet *net)
+{
+    int ii = 0;  // Loop iterator
+
+    // Keeps the first layer sums within 16 bits whatever the board
+    for (ii=0; ii<(int)net->header.hidden1; ii++)
+    {
+        if ((net->b1[ii] < -NEURAL_MAX_BIAS1) || (net->b1[ii] > NEURAL_MAX_BIAS1))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+
+}  // End of CheckBiases()
+
+
+static double Forward (const neuralNet *net, const short sums[])
+{
+    int activation = 0;
+    int activations2[NEURAL_MAX_HIDDEN];
+    int hidden1 = (int)net->header.hidden1;
+    int hidden2 = (int)net->header.hidden2;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    int sum = 0;
+    const signed char * restrict weights = NULL;
+
+    memcpy (activations2, net->b2, hidden2 * sizeof (int));
+
+    // Clipped ReLU keeps the activations in 0 to 127 for the int8 products, and
+    // the ones clipped to zero are skipped
+    for (ii=0; ii<hidden1; ii++)
+    {
+        activation = sums[ii] >> net->header.shift1;
+        if (activation <= 0)
+        {
+            continue;
+        }
+        activation = (activation > 127) ? 127 : activation;
+
+        weights = net->w2 + ii * hidden2;
+        for (jj=0; jj<hidden2; jj+=NEURAL_LANES)
+        {
+            for (kk=0; kk<NEURAL_LANES; kk++)
+            {
+                activations2[jj+kk] += activation * weights[jj+kk];
+            }
+        }
+    }
+
+    sum = net->b3;
+    for (ii=0; ii<hidden2; ii++)
+    {
+        activation = activations2[ii] >> net->header.shift2;
+        sum += ((activation < 0) ? 0 : (activation > 127) ? 127 : activation) * net->w3[ii];
+    }
+
+    return sum * (double)net->header.output_scale;
+
+}  // End of Forward()
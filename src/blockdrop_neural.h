@@ -0,0 +1,93 @@
+//==============================================================================
+//
+// Title:       blockdrop_neural.h
+// Purpose:     Int8 quantized neural network board evaluator.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_neural_H__
+#define __blockdrop_neural_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define NEURAL_MAGIC            0x4E4E4442  // "BDNN"
+#define NEURAL_VERSION          1
+#define NEURAL_MAX_HIDDEN       256
+#define NEURAL_LANES            16      // Hidden sizes are a multiple of this
+#define NEURAL_MAX_BIAS1        3072    // Plus 231 inputs of 127 still fits the 16 bit first layer sums
+
+// One input per cell, bit (row * GRID_NUM_COLS + column), then one per number of lines cleared
+#define NEURAL_NUM_CELLS        (GRID_NUM_ROWS * GRID_NUM_COLS)
+#define NEURAL_NUM_INPUTS       (NEURAL_NUM_CELLS + 4)
+
+//==============================================================================
+// Types
+
+// Weights file, little endian: this header, then
+//   signed char w1[NEURAL_NUM_INPUTS][hidden1]    int b1[hidden1]
+//   signed char w2[hidden1][hidden2]              int b2[hidden2]
+//   signed char w3[hidden2]                       int b3
+// Hidden activations are clamp ((sum >> shift), 0, 127), the output is
+// (b3 + w3 . a2) * output_scale.
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int num_inputs;
+    unsigned int hidden1;
+    unsigned int hidden2;
+    unsigned int shift1;
+    unsigned int shift2;
+    float output_scale;
+} neuralHeader;
+
+typedef struct
+{
+    neuralHeader header;
+    signed char *w1;        // Input major, so a set cell adds one contiguous column
+    int *b1;
+    signed char *w2;        // Input major as well, zero activations skip a whole column
+    int *b2;
+    signed char *w3;
+    int b3;
+} neuralNet;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int ChooseNeuralPlacement (const neuralNet *net, const boardData *board, int type_index, placementData *best);
+
+int NeuralCreateRandom (int hidden1, int hidden2, unsigned long long seed, neuralNet **net);
+
+void NeuralDiscard (neuralNet *net);
+
+int NeuralEvaluateBatch (const neuralNet *net, const boardData boards[], const int lines[], int num_boards,
+                         double scores[]);
+
+int NeuralEvaluatePlacements (const neuralNet *net, const boardData *board, int type_index,
+                              const placementData placements[], int num_placements, double scores[]);
+
+int NeuralLoad (const char *path, neuralNet **net);
+
+int NeuralSave (const neuralNet *net, const char *path);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_neural_H__ */
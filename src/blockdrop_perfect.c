@@ -0,0 +1,532 @@
+//==============================================================================
+//
+// Title:       blockdrop_perfect.c
+// Purpose:     Perfect clear finder for stacks of up to four rows.
+//
+//              The bottom PERFECT_NUM_ROWS rows of the grid are held in one
+//              64 bit field, bit (row * GRID_NUM_COLS + column) with row 0 at
+//              the bottom, and every block position is a precomputed mask of
+//              that field. Dropping, locking and clearing a line are then a few
+//              shifts and masks, with no board copies or per cell loops.
+//
+//              A perfect clear of height h needs (10 * h - cells) / 4 blocks,
+//              all placed below row h. Heights are tried from the lowest, and
+//              each is searched depth first over the hard drop placements of
+//              EnumeratePlacements(). The field is cut when full columns leave
+//              a stretch of empty cells that is not a multiple of four, or when
+//              no mix of the blocks still to come can even out the empty cells
+//              of the odd and even columns (an O, S or Z always covers two of
+//              each, an L or J three of one kind).
+//
+//              Every result is kept in a table keyed by the field and the
+//              blocks still to come, which stays valid from one query to the
+//              next, so a bot asking again after each block mostly hits the
+//              table. An optional node limit keeps a single query bounded,
+//              positions cut short by it are not stored.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_perfect.h"
+
+//==============================================================================
+// Constants
+
+#define ROW_BITS(field, row)    ((unsigned int)((field) >> (GRID_NUM_COLS * (row))) & FULL_ROW_MASK)
+#define EVEN_COLUMNS            0x155   // Columns 0, 2, 4, 6 and 8
+#define BALANCE_OFFSET          32      // Bit of a zero balance in the reachable balance masks
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    unsigned long long mask;    // Cells with the bottom of the bounding box on row 0
+    int orientation;
+    int x;
+    int height;
+} perfectMove;
+
+typedef struct
+{
+    unsigned long long field;
+    unsigned int queue;         // Three bits per block still to come
+    unsigned char num_queue;    // 0 when unused
+    unsigned char solvable;
+} perfectEntry;
+
+struct perfectSolver
+{
+    unsigned int balances[NUM_BLOCKS_TYPES];        // Bit (2 + b) for each balance b a block can have
+    int num_moves[NUM_BLOCKS_TYPES];
+    perfectMove moves[NUM_BLOCKS_TYPES][MAX_PLACEMENTS];
+    perfectEntry *table;
+    unsigned long long table_mask;
+    perfectStats stats;
+    long long max_nodes;                            // Per query, 0 for no limit
+    long long query_nodes;                          // Current query
+    int num_pieces;
+    int types[PERFECT_MAX_PIECES];
+    placementData path[PERFECT_MAX_PIECES];
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int BalanceFits (const perfectSolver *solver, unsigned long long field, int height, int depth);
+
+static unsigned long long ClearRows (unsigned long long field, int height);
+
+static int CountCells (unsigned long long field);
+
+static perfectEntry *FindEntry (perfectSolver *solver, unsigned long long field, int depth, int *found);
+
+static int SearchField (perfectSolver *solver, unsigned long long field, int depth);
+
+static int SplitsEvenly (unsigned long long field, int height);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int ChoosePerfectClearPlacement (perfectSolver *solver, const gameData *game, int num_preview,
+                                 placementData *placement)
+{
+    int ii = 0;  // Loop iterator
+    rngData preview = game->rng;
+    perfectSolution solution;
+    int types[PERFECT_MAX_PIECES];
+
+    if (game->game_status == GAME_END)
+    {
+        return 0;
+    }
+
+    if (num_preview > PERFECT_MAX_PIECES - 1)
+    {
+        num_preview = PERFECT_MAX_PIECES - 1;
+    }
+
+    // The next blocks come from the same generator as GameSpawnPiece()
+    types[0] = game->piece.type_index;
+    for (ii=0; ii<num_preview; ii++)
+    {
+        types[ii+1] = RngRange (&preview, NUM_BLOCKS_TYPES);
+    }
+
+    if (PerfectClearFind (solver, &game->board, types, num_preview + 1, &solution) != 1)
+    {
+        return 0;
+    }
+
+    *placement = solution.placements[0];
+
+    return 1;
+
+}  // End of ChoosePerfectClearPlacement()
+
+
+int PerfectClearCreate (int table_bits, long long max_nodes, perfectSolver **solver)
+{
+    int balance = 0;
+    int duplicate = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    perfectMove *move = NULL;
+    perfectSolver *newSolver = NULL;
+    const pieceShape *shape = NULL;
+    int type_index = 0;
+    int x = 0;
+
+    *solver = NULL;
+
+    if ((table_bits < 1) || (table_bits > 28) || (max_nodes < 0))
+    {
+        return -1;
+    }
+
+    newSolver = calloc (1, sizeof (perfectSolver));
+    if (newSolver == NULL)
+    {
+        return -1;
+    }
+
+    newSolver->max_nodes = max_nodes;
+    newSolver->table_mask = (1ULL << table_bits) - 1;
+    newSolver->table = calloc ((size_t)newSolver->table_mask + 1, sizeof (perfectEntry));
+    if (newSolver->table == NULL)
+    {
+        free (newSolver);
+        return -1;
+    }
+
+    // One mask per distinct orientation and column
+    for (type_index=0; type_index<NUM_BLOCKS_TYPES; type_index++)
+    {
+        for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+        {
+            shape = &g_pieceShapes[type_index][ii];
+
+            for (jj=0, duplicate=0; (jj < ii) && (duplicate == 0); jj++)
+            {
+                duplicate = (memcmp (shape, &g_pieceShapes[type_index][jj], sizeof (pieceShape)) == 0);
+            }
+            if (duplicate || (shape->height > PERFECT_NUM_ROWS))
+            {
+                continue;
+            }
+
+            for (x=0; x<=GRID_NUM_COLS-shape->width; x++)
+            {
+                move = &newSolver->moves[type_index][newSolver->num_moves[type_index]++];
+                move->orientation = ii;
+                move->x = x;
+                move->height = shape->height;
+                move->mask = 0;
+                balance = 0;
+                for (kk=0; kk<shape->height; kk++)
+                {
+                    move->mask |= (unsigned long long)(shape->mask[kk] << x) <<
+                                  (GRID_NUM_COLS * (shape->height - 1 - kk));
+                    balance += CountCells ((shape->mask[kk] << x) & EVEN_COLUMNS) -
+                               CountCells ((shape->mask[kk] << x) & ~EVEN_COLUMNS);
+                }
+
+                // Four cells, so the difference is always even
+                newSolver->balances[type_index] |= 1 << (2 + balance / 2);
+            }
+        }
+    }
+
+    *solver = newSolver;
+
+    return 0;
+
+}  // End of PerfectClearCreate()
+
+
+void PerfectClearDiscard (perfectSolver *solver)
+{
+    if (solver == NULL)
+    {
+        return;
+    }
+
+    free (solver->table);
+    free (solver);
+
+}  // End of PerfectClearDiscard()
+
+
+int PerfectClearFind (perfectSolver *solver, const boardData *board, const int types[], int num_types,
+                      perfectSolution *solution)
+{
+    int cells = 0;
+    unsigned long long field = 0;
+    int height = 0;
+    int ii = 0;  // Loop iterator
+
+    memset (solution, 0, sizeof (perfectSolution));
+    solver->stats.queries++;
+    solver->query_nodes = 0;
+
+    for (ii=0; ii<num_types; ii++)
+    {
+        if ((types[ii] < 0) || (types[ii] >= NUM_BLOCKS_TYPES))
+        {
+            return -1;
+        }
+    }
+
+    // Only stacks within the bottom rows
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        if (ii < GRID_NUM_ROWS - PERFECT_NUM_ROWS)
+        {
+            if (board->rows[ii] != 0)
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            field |= (unsigned long long)(board->rows[ii] & FULL_ROW_MASK) <<
+                     (GRID_NUM_COLS * (GRID_NUM_ROWS - 1 - ii));
+        }
+    }
+    cells = CountCells (field);
+
+    // Lowest clear first, it takes the fewest blocks
+    for (height=1; height<=PERFECT_NUM_ROWS; height++)
+    {
+        solver->num_pieces = (GRID_NUM_COLS * height - cells) / NUM_SQUARES_PER_BLOCK;
+
+        if ((GRID_NUM_COLS * height < cells) || (((GRID_NUM_COLS * height - cells) % NUM_SQUARES_PER_BLOCK) != 0) ||
+            (solver->num_pieces < 1) || (solver->num_pieces > num_types) ||
+            ((field >> (GRID_NUM_COLS * height)) != 0))
+        {
+            continue;
+        }
+
+        memcpy (solver->types, types, solver->num_pieces * sizeof (int));
+        if (SearchField (solver, field, 0) != 0)
+        {
+            solution->num_pieces = solver->num_pieces;
+            solution->height = height;
+            memcpy (solution->types, solver->types, solver->num_pieces * sizeof (int));
+            memcpy (solution->placements, solver->path, solver->num_pieces * sizeof (placementData));
+            return 1;
+        }
+    }
+
+    if ((solver->max_nodes > 0) && (solver->query_nodes > solver->max_nodes))
+    {
+        solver->stats.gave_up++;
+    }
+
+    return 0;
+
+}  // End of PerfectClearFind()
+
+
+void PerfectClearGetStats (const perfectSolver *solver, perfectStats *stats)
+{
+    *stats = solver->stats;
+
+}  // End of PerfectClearGetStats()
+
+
+static int BalanceFits (const perfectSolver *solver, unsigned long long field, int height, int depth)
+{
+    int balance = 0;
+    int ii = 0;  // Loop iterator
+    unsigned long long reachable = 1ULL << BALANCE_OFFSET;
+    unsigned long long next = 0;
+    int row = 0;
+    int shift = 0;
+
+    // Empty cells in even columns less those in odd columns. Cleared rows
+    // were full, so only the blocks still to come can change it, each by one
+    // of its balances.
+    for (row=0; row<height; row++)
+    {
+        balance += CountCells (~ROW_BITS (field, row) & EVEN_COLUMNS) -
+                   CountCells (~ROW_BITS (field, row) & FULL_ROW_MASK & ~EVEN_COLUMNS);
+    }
+
+    for (ii=depth; ii<solver->num_pieces; ii++)
+    {
+        next = 0;
+        for (shift=-2; shift<=2; shift++)
+        {
+            if (solver->balances[solver->types[ii]] & (1 << (2 + shift)))
+            {
+                next |= (shift < 0) ? (reachable >> -shift) : (reachable << shift);
+            }
+        }
+        reachable = next;
+    }
+
+    return ((balance % 2) == 0) && ((reachable >> (BALANCE_OFFSET + balance / 2)) & 1);
+
+}  // End of BalanceFits()
+
+
+static unsigned long long ClearRows (unsigned long long field, int height)
+{
+    unsigned long long below = 0;
+    int row = 0;
+
+    // From the top down, so the rows still to check do not move
+    for (row=height-1; row>=0; row--)
+    {
+        if (ROW_BITS (field, row) == FULL_ROW_MASK)
+        {
+            below = field & ((1ULL << (GRID_NUM_COLS * row)) - 1);
+            field = ((field >> (GRID_NUM_COLS * (row + 1))) << (GRID_NUM_COLS * row)) | below;
+        }
+    }
+
+    return field;
+
+}  // End of ClearRows()
+
+
+static int CountCells (unsigned long long field)
+{
+    int cells = 0;
+
+    while (field != 0)
+    {
+        field &= field - 1;
+        cells++;
+    }
+
+    return cells;
+
+}  // End of CountCells()
+
+
+static perfectEntry *FindEntry (perfectSolver *solver, unsigned long long field, int depth, int *found)
+{
+    perfectEntry *entry = NULL;
+    unsigned long long hash = 0;
+    int ii = 0;  // Loop iterator
+    int numQueue = solver->num_pieces - depth;
+    unsigned int queue = 0;
+
+    for (ii=depth; ii<solver->num_pieces; ii++)
+    {
+        queue = (queue << 3) | (unsigned int)solver->types[ii];
+    }
+
+    hash = (field * 0x9E3779B97F4A7C15ULL) ^ ((queue * 0xFF51AFD7ED558CCDULL) + numQueue);
+    hash ^= hash >> 29;
+    entry = &solver->table[hash & solver->table_mask];
+
+    *found = (entry->num_queue == numQueue) && (entry->queue == queue) && (entry->field == field);
+
+    // The caller fills it in, replacing whatever was there
+    if (*found == 0)
+    {
+        entry->field = field;
+        entry->queue = queue;
+        entry->num_queue = 0;
+    }
+
+    return entry;
+
+}  // End of FindEntry()
+
+
+static int SearchField (perfectSolver *solver, unsigned long long field, int depth)
+{
+    perfectEntry *entry = NULL;
+    int found = 0;
+    int height = 0;
+    int ii = 0;  // Loop iterator
+    const perfectMove *move = NULL;
+    int num_moves = 0;
+    unsigned long long placed = 0;
+    int remaining = solver->num_pieces - depth;
+    int row = 0;
+    int solvable = 0;
+    int type_index = 0;
+
+    if (remaining == 0)
+    {
+        return (field == 0);
+    }
+
+    // Known to fail, or known to work and only the path is wanted again
+    entry = FindEntry (solver, field, depth, &found);
+    if (found)
+    {
+        solver->stats.table_hits++;
+        if (entry->solvable == 0)
+        {
+            return 0;
+        }
+    }
+    solver->stats.nodes++;
+
+    // Out of time for this query. Nothing is stored, a later query with the
+    // same blocks may still get through.
+    if ((solver->max_nodes > 0) && (++solver->query_nodes > solver->max_nodes))
+    {
+        return 0;
+    }
+
+    height = (CountCells (field) + NUM_SQUARES_PER_BLOCK * remaining) / GRID_NUM_COLS;
+    type_index = solver->types[depth];
+
+    // Nothing placed here can fix a bad split or column balance
+    if (SplitsEvenly (field, height) && BalanceFits (solver, field, height, depth))
+    {
+        num_moves = solver->num_moves[type_index];
+    }
+
+    for (ii=0; (solvable == 0) && (ii < num_moves); ii++)
+    {
+        move = &solver->moves[type_index][ii];
+
+        // Hard drop from the clear height, nothing is ever stacked above it,
+        // and the block has to come to rest below it
+        row = height;
+        while ((row > 0) && (((move->mask << (GRID_NUM_COLS * (row - 1))) & field) == 0))
+        {
+            row--;
+        }
+        if (row + move->height > height)
+        {
+            continue;
+        }
+        placed = field | (move->mask << (GRID_NUM_COLS * row));
+
+        solver->path[depth].orientation = move->orientation;
+        solver->path[depth].x = move->x;
+        solver->path[depth].y = GRID_NUM_ROWS - row - move->height;
+
+        solvable = SearchField (solver, ClearRows (placed, height), depth + 1);
+    }
+
+    if ((solvable == 0) && (solver->max_nodes > 0) && (solver->query_nodes > solver->max_nodes))
+    {
+        return 0;
+    }
+
+    // The entry may have been replaced further down
+    entry = FindEntry (solver, field, depth, &found);
+    entry->num_queue = (unsigned char)remaining;
+    entry->solvable = (unsigned char)solvable;
+
+    return solvable;
+
+}  // End of SearchField()
+
+
+static int SplitsEvenly (unsigned long long field, int height)
+{
+    int column = 0;
+    int empty = 0;
+    int row = 0;
+    unsigned int walls = FULL_ROW_MASK;
+
+    for (row=0; row<height; row++)
+    {
+        walls &= ROW_BITS (field, row);
+    }
+
+    // No block reaches past the clear height, so a full column is a wall and
+    // each stretch of columns between walls has to take whole blocks
+    for (column=0; column<=GRID_NUM_COLS; column++)
+    {
+        if ((column == GRID_NUM_COLS) || (walls & (1 << column)))
+        {
+            if ((empty % NUM_SQUARES_PER_BLOCK) != 0)
+            {
+                return 0;
+            }
+            empty = 0;
+            continue;
+        }
+
+        for (row=0; row<height; row++)
+        {
+            empty += ((ROW_BITS (field, row) & (1 << column)) == 0);
+        }
+    }
+
+    return 1;
+
+}  // End of SplitsEvenly()
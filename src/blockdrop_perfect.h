@@ -0,0 +1,74 @@
+//==============================================================================
+//
+// Title:       blockdrop_perfect.h
+// Purpose:     Perfect clear finder for stacks of up to four rows.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_perfect_H__
+#define __blockdrop_perfect_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define PERFECT_NUM_ROWS        4       // Bottom rows of the grid searched
+#define PERFECT_MAX_PIECES      10      // Blocks that fill PERFECT_NUM_ROWS empty rows
+
+#define PERFECT_DEFAULT_TABLE_BITS  18
+#define PERFECT_DEFAULT_MAX_NODES   200000  // Keeps a query within a few milliseconds
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_pieces;                                 // Blocks used, 0 when none was found
+    int height;                                     // Rows cleared
+    int types[PERFECT_MAX_PIECES];
+    placementData placements[PERFECT_MAX_PIECES];   // On the board as it is when each block is placed
+} perfectSolution;
+
+typedef struct
+{
+    long long queries;
+    long long nodes;
+    long long table_hits;
+    long long gave_up;          // Queries stopped at the node limit
+} perfectStats;
+
+typedef struct perfectSolver perfectSolver;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int ChoosePerfectClearPlacement (perfectSolver *solver, const gameData *game, int num_preview,
+                                 placementData *placement);
+
+int PerfectClearCreate (int table_bits, long long max_nodes, perfectSolver **solver);
+
+void PerfectClearDiscard (perfectSolver *solver);
+
+int PerfectClearFind (perfectSolver *solver, const boardData *board, const int types[], int num_types,
+                      perfectSolution *solution);
+
+void PerfectClearGetStats (const perfectSolver *solver, perfectStats *stats);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_perfect_H__ */
@@ -0,0 +1,133 @@
+//==============================================================================
+//
+// Title:       blockdrop_perft.c
+// Purpose:     Placement counting to validate and benchmark the move generator.
+//
+//              Like perft in chess engines, Perft() walks the tree of every
+//              reachable lock position for a fixed block sequence and counts
+//              the leaves. Any change to movement, rotation, locking or line
+//              clearing that alters the set of reachable positions changes
+//              the counts in g_perftPositions[].
+//
+//              The tree is walked on one board: every lock is taken back with
+//              BoardUndoDelta() once its subtree is counted.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_journal.h"
+#include "blockdrop_perft.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static long long PerftNode (boardData *board, const char *sequence, int depth, long long *nodes);
+
+//==============================================================================
+// Global variables
+
+const perftPosition g_perftPositions[] =
+{
+    {"empty I",      "", "I",    1, 17},
+    {"empty T",      "", "T",    1, 34},
+    {"empty O",      "", "O",    1, 9},
+    {"empty IJL",    "", "IJL",  3, 20352},
+    {"empty TSZ",    "", "TSZ",  3, 10483},
+    {"empty OTIJ",   "", "OTIJ", 4, 192607},
+    {"tuck",
+     "....####../"
+     "........../"
+     "#.......#./"
+     "##.....###/"
+     "###.######",
+     "TLJS", 3, 103893},
+    {"line clear",
+     "#########./"
+     "#########./"
+     "#########./"
+     "#########.",
+     "IIO", 3, 2658}
+};
+
+const int g_numPerftPositions = sizeof (g_perftPositions) / sizeof (g_perftPositions[0]);
+
+//==============================================================================
+// Global functions
+
+int Perft (const boardData *board, const char *sequence, int depth, perftResult *result)
+{
+    boardData scratch = *board;
+    double start = 0.0;
+
+    memset (result, 0, sizeof (perftResult));
+
+    if ((depth < 0) || (depth > PERFT_MAX_DEPTH) || (depth > (int)strlen (sequence)))
+    {
+        return -1;
+    }
+
+    start = Timer ();
+    result->leaves = PerftNode (&scratch, sequence, depth, &result->nodes);
+    result->seconds = Timer () - start;
+
+    return 0;
+
+}  // End of Perft()
+
+
+static long long PerftNode (boardData *board, const char *sequence, int depth, long long *nodes)
+{
+    boardDelta delta = {0};
+    int ii = 0;  // Loop iterator
+    long long leaves = 0;
+    int numLocks = 0;
+    pieceData piece = {0};
+    reachData reach;
+    int type_index = 0;
+
+    if (depth == 0)
+    {
+        return 1;
+    }
+
+    type_index = PieceTypeIndex (sequence[0]);
+    if (type_index < 0)
+    {
+        return 0;
+    }
+
+    // Game over when the block does not fit at the spawn position
+    PieceSpawn (type_index, &piece);
+    numLocks = ReachSearch (board, &piece, &reach);
+    *nodes += numLocks;
+
+    // Count the last level in bulk
+    if (depth == 1)
+    {
+        return numLocks;
+    }
+
+    for (ii=0; ii<numLocks; ii++)
+    {
+        ReachLockPiece (&reach, ii, &piece);
+        BoardLockDelta (board, &piece, &delta);
+        leaves += PerftNode (board, sequence + 1, depth - 1, nodes);
+        BoardUndoDelta (board, &delta);
+    }
+
+    return leaves;
+
+}  // End of PerftNode()
@@ -0,0 +1,62 @@
+//==============================================================================
+//
+// Title:       blockdrop_perft.h
+// Purpose:     Placement counting to validate and benchmark the move generator.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_perft_H__
+#define __blockdrop_perft_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_reach.h"
+
+//==============================================================================
+// Constants
+
+#define PERFT_MAX_DEPTH         16
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const char *name;
+    const char *board;      // See BoardParse()
+    const char *sequence;   // Block types, e.g. "IJL"
+    int depth;
+    long long leaves;       // Known good count
+} perftPosition;
+
+typedef struct
+{
+    long long leaves;       // Lock sequences at the requested depth
+    long long nodes;        // Lock positions generated at every depth
+    double seconds;
+} perftResult;
+
+//==============================================================================
+// External variables
+
+extern const perftPosition g_perftPositions[];
+
+extern const int g_numPerftPositions;
+
+//==============================================================================
+// Global functions
+
+int Perft (const boardData *board, const char *sequence, int depth, perftResult *result);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_perft_H__ */
@@ -0,0 +1,237 @@
+//==============================================================================
+//
+// Title:       blockdrop_piece.c
+// Purpose:     Packed piece state with the block geometry derived from tables.
+//
+//              Search nodes, replays and snapshots keep the active block as a
+//              packedPiece. Everything else blockData holds follows from the
+//              block type, orientation and bounding box position, so
+//              BlockUnpack() rebuilds it from the cell table below: the cells
+//              in the order CB_BtnRotateCW() and CB_BtnRotateCCW() expect in
+//              block.position[], the rows from top to bottom, the lowest cell
+//              of every column and the outer cells of every row.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_piece.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int dx;
+    int dy;
+} cellOffset;
+
+//==============================================================================
+// Static global variables
+
+// Cells relative to the bounding box in block.position[] order, as left by
+// SpawnBlock() and the rotation callbacks. The order does not depend on how
+// the orientation was reached.
+static const cellOffset blockCells[NUM_BLOCKS_TYPES][NUM_ORIENTATIONS][NUM_SQUARES_PER_BLOCK] =
+{
+    { {{3, 0}, {0, 0}, {1, 0}, {2, 0}},      // I
+      {{0, 0}, {0, 1}, {0, 2}, {0, 3}},
+      {{3, 0}, {0, 0}, {1, 0}, {2, 0}},
+      {{0, 0}, {0, 1}, {0, 2}, {0, 3}} },
+    { {{0, 1}, {0, 0}, {2, 1}, {1, 1}},      // J
+      {{1, 0}, {0, 1}, {0, 0}, {0, 2}},
+      {{2, 1}, {1, 0}, {2, 0}, {0, 0}},
+      {{1, 0}, {1, 1}, {1, 2}, {0, 2}} },
+    { {{1, 1}, {0, 1}, {2, 1}, {2, 0}},      // L
+      {{0, 0}, {0, 1}, {0, 2}, {1, 2}},
+      {{0, 0}, {1, 0}, {0, 1}, {2, 0}},
+      {{1, 0}, {0, 0}, {1, 2}, {1, 1}} },
+    { {{0, 0}, {0, 1}, {1, 0}, {1, 1}},      // O
+      {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+      {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+      {{0, 0}, {0, 1}, {1, 0}, {1, 1}} },
+    { {{1, 0}, {0, 1}, {1, 1}, {2, 1}},      // T
+      {{0, 0}, {0, 2}, {0, 1}, {1, 1}},
+      {{0, 0}, {1, 1}, {1, 0}, {2, 0}},
+      {{0, 1}, {1, 2}, {1, 1}, {1, 0}} },
+    { {{2, 0}, {0, 1}, {1, 0}, {1, 1}},      // S
+      {{0, 0}, {0, 1}, {1, 1}, {1, 2}},
+      {{2, 0}, {0, 1}, {1, 0}, {1, 1}},
+      {{0, 0}, {0, 1}, {1, 1}, {1, 2}} },
+    { {{0, 0}, {2, 1}, {1, 0}, {1, 1}},      // Z
+      {{1, 0}, {1, 1}, {0, 1}, {0, 2}},
+      {{0, 0}, {2, 1}, {1, 0}, {1, 1}},
+      {{1, 0}, {1, 1}, {0, 1}, {0, 2}} }
+};
+
+// Same colors as SpawnBlock()
+static const int blockColors[NUM_BLOCKS_TYPES] = {VAL_CYAN, VAL_BLUE, 0xFFA500, VAL_YELLOW,
+                                                  0xA32CC4, VAL_GREEN, VAL_RED};
+
+//==============================================================================
+// Static functions
+
+//==============================================================================
+// Global variables
+
+const packedPiece g_noPiece = {-1, 0, 0, 0};
+
+//==============================================================================
+// Global functions
+
+int BlockColor (int type_index)
+{
+    if ((type_index < 0) || (type_index >= NUM_BLOCKS_TYPES))
+    {
+        return VAL_WHITE;
+    }
+
+    return blockColors[type_index];
+
+}  // End of BlockColor()
+
+
+int BlockPack (const blockData *block, packedPiece *packed)
+{
+    int ii = 0;  // Loop iterator
+    int type_index = PieceTypeIndex (block->type);
+    int x = GRID_NUM_COLS;
+    int y = GRID_NUM_ROWS;
+
+    if (type_index < 0)
+    {
+        *packed = g_noPiece;
+        return -1;
+    }
+
+    // Bounding box, 0-based
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        if (block->position[ii].x - 1 < x)
+        {
+            x = block->position[ii].x - 1;
+        }
+        if (block->position[ii].y - 1 < y)
+        {
+            y = block->position[ii].y - 1;
+        }
+    }
+
+    packed->type_index = (signed char)type_index;
+    packed->orientation = (signed char)(block->orientation - 1);
+    packed->x = (signed char)x;
+    packed->y = (signed char)y;
+
+    return 0;
+
+}  // End of BlockPack()
+
+
+int BlockUnpack (packedPiece packed, blockData *block)
+{
+    const cellOffset *cells = NULL;
+    int column = 0;
+    int ii = 0;  // Loop iterator
+    int left = 0;
+    int low = 0;
+    int right = 0;
+    int row = 0;
+
+    memset (block, 0, sizeof (blockData));
+
+    if ((packed.type_index < 0) || (packed.type_index >= NUM_BLOCKS_TYPES) ||
+        (packed.orientation < 0) || (packed.orientation >= NUM_ORIENTATIONS))
+    {
+        return -1;
+    }
+
+    cells = blockCells[packed.type_index][packed.orientation];
+
+    block->type = PieceBlockType (packed.type_index);
+    block->color = BlockColor (packed.type_index);
+    block->orientation = packed.orientation + 1;
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        block->position[ii] = MakePoint (packed.x + 1 + cells[ii].dx, packed.y + 1 + cells[ii].dy);
+    }
+
+    // Rows from top to bottom with their outer cells
+    for (row=0; row<NUM_SQUARES_PER_BLOCK; row++)
+    {
+        left = -1;
+        right = -1;
+        for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+        {
+            if (cells[ii].dy != row)
+            {
+                continue;
+            }
+            if ((left < 0) || (cells[ii].dx < cells[left].dx))
+            {
+                left = ii;
+            }
+            if ((right < 0) || (cells[ii].dx > cells[right].dx))
+            {
+                right = ii;
+            }
+        }
+
+        if (left >= 0)
+        {
+            block->rows[block->num_rows++] = packed.y + 1 + row;
+            block->left_points[block->num_left_points++] = block->position[left];
+            block->right_points[block->num_right_points++] = block->position[right];
+        }
+    }
+
+    // Lowest cell of every column, from left to right
+    for (column=0; column<NUM_SQUARES_PER_BLOCK; column++)
+    {
+        low = -1;
+        for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+        {
+            if ((cells[ii].dx == column) && ((low < 0) || (cells[ii].dy > cells[low].dy)))
+            {
+                low = ii;
+            }
+        }
+
+        if (low >= 0)
+        {
+            block->low_points[block->num_low_points++] = block->position[low];
+        }
+    }
+
+    return 0;
+
+}  // End of BlockUnpack()
+
+
+packedPiece PiecePack (const pieceData *piece)
+{
+    packedPiece packed = {0};
+
+    packed.type_index = (signed char)piece->type_index;
+    packed.orientation = (signed char)piece->orientation;
+    packed.x = (signed char)piece->x;
+    packed.y = (signed char)piece->y;
+
+    return packed;
+
+}  // End of PiecePack()
+
+
+void PieceUnpack (packedPiece packed, pieceData *piece)
+{
+    piece->type_index = packed.type_index;
+    piece->orientation = packed.orientation;
+    piece->x = packed.x;
+    piece->y = packed.y;
+
+}  // End of PieceUnpack()
@@ -0,0 +1,60 @@
+//==============================================================================
+//
+// Title:       blockdrop_piece.h
+// Purpose:     Packed piece state with the block geometry derived from tables.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_piece_H__
+#define __blockdrop_piece_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+// Four bytes instead of the 16 of pieceData and the 172 of blockData. Fields
+// are as in pieceData, type_index is -1 when there is no active block.
+typedef struct
+{
+    signed char type_index;
+    signed char orientation;
+    signed char x;
+    signed char y;
+} packedPiece;
+
+//==============================================================================
+// External variables
+
+extern const packedPiece g_noPiece;
+
+//==============================================================================
+// Global functions
+
+int BlockColor (int type_index);
+
+int BlockPack (const blockData *block, packedPiece *packed);
+
+int BlockUnpack (packedPiece packed, blockData *block);
+
+packedPiece PiecePack (const pieceData *piece);
+
+void PieceUnpack (packedPiece packed, pieceData *piece);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_piece_H__ */
@@ -0,0 +1,257 @@
+//==============================================================================
+//
+// Title:       blockdrop_platform.c
+// Purpose:     The CVI and Win32 calls of the headless engine, the benchmarks
+//              and the regression gate, for builds without CVI.
+//
+//              Timers read CLOCK_MONOTONIC in nanoseconds. Every scheduled
+//              thread pool function runs on a thread of its own, which is
+//              what ThreadPoolRun() asks for: one call per pool thread.
+//              Pinning to a processor uses the Linux affinity calls. The
+//              thread priority is left as it is, raising it needs privileges.
+//
+//              The CVI projects do not build this file, it is empty there.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#ifndef _CVI_
+
+#ifdef __linux__
+    #define _GNU_SOURCE     // pthread_setaffinity_np()
+#endif
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "blockdrop_platform.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    pthread_t thread;
+    ThreadFunctionPtr function;
+    void *data;
+    int in_use;                 // From scheduling until the ID is released
+} platformThread;
+
+//==============================================================================
+// Static global variables
+
+static platformThread g_threads[PLATFORM_MAX_THREADS];
+
+static pthread_mutex_t g_threadsLock = PTHREAD_MUTEX_INITIALIZER;
+
+//==============================================================================
+// Static functions
+
+static void *ThreadMain (void *data);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int CmtReleaseThreadPoolFunctionID (CmtThreadPoolHandle pool, CmtThreadFunctionID id)
+{
+    if ((id < 1) || (id > PLATFORM_MAX_THREADS))
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock (&g_threadsLock);
+    g_threads[id-1].in_use = 0;
+    pthread_mutex_unlock (&g_threadsLock);
+
+    return 0;
+
+}  // End of CmtReleaseThreadPoolFunctionID()
+
+
+int CmtScheduleThreadPoolFunction (CmtThreadPoolHandle pool, ThreadFunctionPtr function, void *data,
+                                   CmtThreadFunctionID *id)
+{
+    int ii = 0;  // Loop iterator
+
+    pthread_mutex_lock (&g_threadsLock);
+    for (ii=0; (ii<PLATFORM_MAX_THREADS) && g_threads[ii].in_use; ii++)
+    {
+    }
+    if (ii < PLATFORM_MAX_THREADS)
+    {
+        g_threads[ii].in_use = 1;
+    }
+    pthread_mutex_unlock (&g_threadsLock);
+
+    if (ii == PLATFORM_MAX_THREADS)
+    {
+        return -1;
+    }
+
+    g_threads[ii].function = function;
+    g_threads[ii].data = data;
+    if (pthread_create (&g_threads[ii].thread, NULL, ThreadMain, &g_threads[ii]) != 0)
+    {
+        CmtReleaseThreadPoolFunctionID (pool, ii + 1);
+        return -1;
+    }
+
+    // IDs start at 1, like the CVI ones
+    if (id != NULL)
+    {
+        *id = ii + 1;
+    }
+
+    return 0;
+
+}  // End of CmtScheduleThreadPoolFunction()
+
+
+int CmtWaitForThreadPoolFunctionCompletion (CmtThreadPoolHandle pool, CmtThreadFunctionID id, int options)
+{
+    if ((id < 1) || (id > PLATFORM_MAX_THREADS))
+    {
+        return -1;
+    }
+
+    return (pthread_join (g_threads[id-1].thread, NULL) == 0) ? 0 : -1;
+
+}  // End of CmtWaitForThreadPoolFunctionCompletion()
+
+
+HANDLE GetCurrentThread (void)
+{
+    // Pseudo handle, same value as Win32
+    return (HANDLE)(intptr_t)-2;
+
+}  // End of GetCurrentThread()
+
+
+void GetSystemInfo (SYSTEM_INFO *info)
+{
+    long numProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+
+    memset (info, 0, sizeof (SYSTEM_INFO));
+    info->dwNumberOfProcessors = (numProcessors > 0) ? (DWORD)numProcessors : 1;
+
+}  // End of GetSystemInfo()
+
+
+int GetThreadPriority (HANDLE thread)
+{
+    return THREAD_PRIORITY_NORMAL;
+
+}  // End of GetThreadPriority()
+
+
+Point MakePoint (int x, int y)
+{
+    Point point;
+
+    point.x = x;
+    point.y = y;
+
+    return point;
+
+}  // End of MakePoint()
+
+
+BOOL QueryPerformanceCounter (LARGE_INTEGER *counter)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    counter->QuadPart = (LONGLONG)now.tv_sec * 1000000000LL + now.tv_nsec;
+
+    return 1;
+
+}  // End of QueryPerformanceCounter()
+
+
+BOOL QueryPerformanceFrequency (LARGE_INTEGER *frequency)
+{
+    frequency->QuadPart = 1000000000LL;
+
+    return 1;
+
+}  // End of QueryPerformanceFrequency()
+
+
+DWORD_PTR SetThreadAffinityMask (HANDLE thread, DWORD_PTR mask)
+{
+    DWORD_PTR oldMask = 0;
+#ifdef __linux__
+    cpu_set_t cpus;
+    int ii = 0;  // Loop iterator
+
+    // Only the calling thread, GetCurrentThread() is the only handle there is
+    if (pthread_getaffinity_np (pthread_self (), sizeof (cpus), &cpus) != 0)
+    {
+        return 0;
+    }
+    for (ii=0; ii<(int)(8 * sizeof (DWORD_PTR)); ii++)
+    {
+        if (CPU_ISSET (ii, &cpus))
+        {
+            oldMask |= (DWORD_PTR)1 << ii;
+        }
+    }
+
+    CPU_ZERO (&cpus);
+    for (ii=0; ii<(int)(8 * sizeof (DWORD_PTR)); ii++)
+    {
+        if (mask & ((DWORD_PTR)1 << ii))
+        {
+            CPU_SET (ii, &cpus);
+        }
+    }
+    if (pthread_setaffinity_np (pthread_self (), sizeof (cpus), &cpus) != 0)
+    {
+        return 0;
+    }
+#endif
+
+    return oldMask;
+
+}  // End of SetThreadAffinityMask()
+
+
+BOOL SetThreadPriority (HANDLE thread, int priority)
+{
+    return (priority == THREAD_PRIORITY_NORMAL);
+
+}  // End of SetThreadPriority()
+
+
+double Timer (void)
+{
+    struct timespec now;
+
+    clock_gettime (CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec * 1e-9;
+
+}  // End of Timer()
+
+
+static void *ThreadMain (void *data)
+{
+    platformThread *thread = (platformThread *)data;
+
+    thread->function (thread->data);
+
+    return NULL;
+
+}  // End of ThreadMain()
+
+#endif  /* ndef _CVI_ */
@@ -0,0 +1,120 @@
+//==============================================================================
+//
+// Title:       blockdrop_platform.h
+// Purpose:     The CVI and Win32 calls of the headless engine, the benchmarks
+//              and the regression gate, for builds without CVI.
+//
+//              cvi_blockdrop.h includes this header instead of the CVI and
+//              Windows ones when _CVI_ is not defined, e.g. in the Linux build
+//              of the regression gate (Makefile). Only the calls those modules
+//              make are provided, on top of POSIX threads and clocks.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_platform_H__
+#define __blockdrop_platform_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//==============================================================================
+// Constants
+
+#define CVICALLBACK
+#define MAX_PATHNAME_LEN        260
+
+// Block colors, same values as userint.h
+#define VAL_BLUE                0x0000FF
+#define VAL_CYAN                0x00FFFF
+#define VAL_GREEN               0x00FF00
+#define VAL_RED                 0xFF0000
+#define VAL_WHITE               0xFFFFFF
+#define VAL_YELLOW              0xFFFF00
+
+#define THREAD_PRIORITY_NORMAL  0
+#define THREAD_PRIORITY_HIGHEST 2
+
+#define PLATFORM_MAX_THREADS    1024    // Thread pool functions scheduled at once
+
+//==============================================================================
+// Types
+
+typedef int BOOL;
+typedef unsigned long DWORD;
+typedef uintptr_t DWORD_PTR;
+typedef void *HANDLE;
+typedef int64_t LONGLONG;
+
+typedef union
+{
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef struct
+{
+    DWORD dwNumberOfProcessors;
+} SYSTEM_INFO;
+
+typedef struct
+{
+    int x;
+    int y;
+} Point;
+
+typedef int CmtThreadPoolHandle;
+typedef int CmtThreadFunctionID;
+typedef int (*ThreadFunctionPtr) (void *functionData);
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int CmtReleaseThreadPoolFunctionID (CmtThreadPoolHandle pool, CmtThreadFunctionID id);
+
+int CmtScheduleThreadPoolFunction (CmtThreadPoolHandle pool, ThreadFunctionPtr function, void *data,
+                                   CmtThreadFunctionID *id);
+
+int CmtWaitForThreadPoolFunctionCompletion (CmtThreadPoolHandle pool, CmtThreadFunctionID id, int options);
+
+HANDLE GetCurrentThread (void);
+
+void GetSystemInfo (SYSTEM_INFO *info);
+
+int GetThreadPriority (HANDLE thread);
+
+Point MakePoint (int x, int y);
+
+BOOL QueryPerformanceCounter (LARGE_INTEGER *counter);
+
+BOOL QueryPerformanceFrequency (LARGE_INTEGER *frequency);
+
+DWORD_PTR SetThreadAffinityMask (HANDLE thread, DWORD_PTR mask);
+
+BOOL SetThreadPriority (HANDLE thread, int priority);
+
+double Timer (void);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_platform_H__ */
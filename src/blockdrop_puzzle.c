@@ -0,0 +1,794 @@
+//==============================================================================
+//
+// Title:       blockdrop_puzzle.c
+// Purpose:     Solver for "clear the board with this block sequence" puzzles.
+//
+//              A depth first search over every reachable lock position of
+//              each block, in sequence order, looking for an empty board after
+//              the last block. Positions are cut when the empty cells of the
+//              rows still in play outnumber the cells the remaining blocks can
+//              add, or when no new row fits and the full columns leave a
+//              stretch of empty cells that is not a multiple of four, or when
+//              the remaining blocks cannot even out the empty cells of the
+//              even and odd columns (see BalanceFits()).
+//              Placements that leave the same board, such as the rotations of
+//              O or the two vertical positions of I, are only searched once.
+//              Positions that failed are remembered per thread by board and
+//              depth, so other move orders reaching them are cut.
+//
+//              The placements of the first block are split across a thread
+//              pool. The solution returned is always the one for the lowest
+//              first placement, so it does not depend on the number of
+//              threads, and when the search completes without one the puzzle
+//              is proven impossible.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_puzzle.h"
+#include "blockdrop_arena.h"
+#include "blockdrop_piece.h"
+
+//==============================================================================
+// Constants
+
+#if (GRID_NUM_COLS % 2) != 0
+    #error "The parity bound needs full rows with as many even as odd columns"
+#endif
+
+#define EVEN_COLUMNS_MASK       (0x5555 & FULL_ROW_MASK)
+#define ODD_COLUMNS_MASK        (0xAAAA & FULL_ROW_MASK)
+
+// Arena scratch of one search depth, see SearchNode()
+#define DEPTH_SCRATCH_SIZE      (sizeof (reachData) + REACH_NUM_STATES * sizeof (puzzleChild) + 2 * ARENA_ALIGNMENT)
+
+#define NODE_BLOCK_SIZE         1024    // Nodes counted against max_nodes at a time
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    short lock_index;
+    short lines;
+    short missing;              // Empty cells in the rows in play, see MeasureBoard()
+    short balance;              // Empty cells in even less odd columns, see MeasureBoard()
+    unsigned long long hash;
+} puzzleChild;
+
+typedef struct
+{
+    unsigned long long key;     // Board hash mixed with the depth, 0 when unused
+    boardData board;
+    int depth;
+} puzzleEntry;
+
+typedef struct
+{
+    const puzzleConfig *config;
+    int num_pieces;
+    int types[PUZZLE_MAX_PIECES];
+    int swing[PUZZLE_MAX_PIECES+1];             // Most balance the blocks from each depth on can take away
+    int num_lj[PUZZLE_MAX_PIECES+1];            // L and J blocks from each depth on
+    int num_t[PUZZLE_MAX_PIECES+1];             // T blocks from each depth on
+    int num_roots;
+    boardData roots[REACH_NUM_STATES];          // Boards after the first block
+    packedPiece root_pieces[REACH_NUM_STATES];
+    int root_missing[REACH_NUM_STATES];
+    int root_balance[REACH_NUM_STATES];
+    volatile LONG next_root;
+    volatile LONG solved_root;                  // Lowest root solved, num_roots when none
+    volatile LONG node_blocks;
+    volatile LONG stopped;
+} puzzleJob;
+
+typedef struct
+{
+    puzzleJob *job;
+    int root;
+    int solved_root;
+    long long nodes;
+    long long table_hits;
+    long long pruned;
+    puzzleEntry *table;
+    unsigned long long table_mask;
+    packedPiece path[PUZZLE_MAX_PIECES];
+    arenaData *arena;           // Reach and children of every depth being searched
+} puzzleWorker;
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int BalanceFits (const puzzleJob *job, int balance, int depth);
+
+static int BitCount (unsigned int value);
+
+static int CollectChildren (puzzleWorker *worker, const boardData *board, int missing, int balance, int depth,
+                            const reachData *reach, puzzleChild children[]);
+
+static int FillsBoard (const boardData *board, int type_index);
+
+static unsigned long long HashBoard (const boardData *board, int depth);
+
+static void LowerSolvedRoot (puzzleJob *job, int root);
+
+static int MeasureBoard (const boardData *board, int *cells, int *balance);
+
+static int CVICALLBACK PuzzleWorker (void *functionData);
+
+static int SearchNode (puzzleWorker *worker, const boardData *board, int missing, int balance, int depth);
+
+static int SplitsEvenly (const boardData *board);
+
+static int TableLookup (const puzzleWorker *worker, const boardData *board, unsigned long long key, int depth);
+
+static void TableStore (puzzleWorker *worker, const boardData *board, unsigned long long key, int depth);
+
+//==============================================================================
+// Global variables
+
+// The 10 block case took 894k nodes before the parity bound, well over its budget
+const puzzlePosition g_puzzlePositions[] =
+{
+    {"well I",     "#########./#########./#########./#########.", "I", PUZZLE_SOLVED, 100, 1.0},
+    {"cell count", "", "LJ",         PUZZLE_IMPOSSIBLE, 1, 1.0},
+    {"empty I",    "", "IIIIIIIIII", PUZZLE_SOLVED, 1000, 1.0},
+    {"empty T",    "", "TTTTTTTTTT", PUZZLE_SOLVED, 1000, 1.0},
+    {"empty mix",  "", "IJLOTSZIJL", PUZZLE_SOLVED, 10000, 1.0},
+    {"empty LJ",   "", "LJLJLJLJLJ", PUZZLE_SOLVED, 10000, 1.0},
+    {"10 blocks",  "", "IOLJTSZIOZ", PUZZLE_IMPOSSIBLE, 600000, 10.0}
+};
+
+const int g_numPuzzlePositions = sizeof (g_puzzlePositions) / sizeof (g_puzzlePositions[0]);
+
+//==============================================================================
+// Global functions
+
+void PuzzleDefaultConfig (puzzleConfig *config)
+{
+    memset (config, 0, sizeof (puzzleConfig));
+
+    config->table_bits = PUZZLE_DEFAULT_TABLE_BITS;
+
+}  // End of PuzzleDefaultConfig()
+
+
+int PuzzleSolve (const boardData *board, const char *sequence, const puzzleConfig *config, puzzleResult *result)
+{
+    arenaStats arena = {0};
+    int balance = 0;
+    int best = -1;
+    int cells = 0;
+    puzzleChild *children = NULL;
+    int ii = 0;  // Loop iterator
+    puzzleJob *job = NULL;
+    int missing = 0;
+    int numChildren = 0;
+    int numThreads = config->num_threads;
+    pieceData piece = {0};
+    CmtThreadPoolHandle pool = 0;
+    reachData *reach = NULL;
+    pieceData spawn = {0};
+    double start = Timer ();
+    int status = 0;
+    void *workerData[PUZZLE_MAX_THREADS] = {NULL};
+    puzzleWorker *workers[PUZZLE_MAX_THREADS] = {NULL};
+
+    memset (result, 0, sizeof (puzzleResult));
+    result->status = PUZZLE_IMPOSSIBLE;
+    result->num_pieces = (int)strlen (sequence);
+
+    if ((result->num_pieces < 1) || (result->num_pieces > PUZZLE_MAX_PIECES) ||
+        (config->table_bits < 1) || (config->table_bits > 28))
+    {
+        return -1;
+    }
+
+    job = calloc (1, sizeof (puzzleJob));
+    if (job == NULL)
+    {
+        return -1;
+    }
+
+    job->config = config;
+    job->num_pieces = result->num_pieces;
+    for (ii=0; ii<job->num_pieces; ii++)
+    {
+        job->types[ii] = PieceTypeIndex (sequence[ii]);
+        if (job->types[ii] < 0)
+        {
+            free (job);
+            return -1;
+        }
+    }
+
+    // Balance a block takes away wherever it locks, see BalanceFits()
+    for (ii=job->num_pieces-1; ii>=0; ii--)
+    {
+        job->swing[ii] = job->swing[ii+1];
+        job->num_lj[ii] = job->num_lj[ii+1];
+        job->num_t[ii] = job->num_t[ii+1];
+
+        switch (PieceBlockType (job->types[ii]))
+        {
+            case BLOCK_I:
+                job->swing[ii] += 4;
+                break;
+            case BLOCK_J:
+            case BLOCK_L:
+                job->swing[ii] += 2;
+                job->num_lj[ii]++;
+                break;
+            case BLOCK_T:
+                job->swing[ii] += 2;
+                job->num_t[ii]++;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (numThreads <= 0)
+    {
+        numThreads = GetNumProcessors ();
+    }
+    if (numThreads > PUZZLE_MAX_THREADS)
+    {
+        numThreads = PUZZLE_MAX_THREADS;
+    }
+
+    for (ii=0; ii<numThreads; ii++)
+    {
+        workers[ii] = calloc (1, sizeof (puzzleWorker));
+        if (workers[ii] != NULL)
+        {
+            workers[ii]->job = job;
+            workers[ii]->solved_root = -1;
+            workers[ii]->table_mask = (1ULL << config->table_bits) - 1;
+            workers[ii]->table = calloc ((size_t)workers[ii]->table_mask + 1, sizeof (puzzleEntry));
+            ArenaCreate (job->num_pieces * DEPTH_SCRATCH_SIZE, &workers[ii]->arena);
+        }
+        workerData[ii] = workers[ii];
+
+        if ((workers[ii] == NULL) || (workers[ii]->table == NULL) || (workers[ii]->arena == NULL))
+        {
+            status = -1;
+        }
+    }
+
+    // Every block adds four cells and every line clear takes ten away, so the
+    // count must come out even before anything is searched
+    missing = MeasureBoard (board, &cells, &balance);
+    if ((status == 0) && (missing <= NUM_SQUARES_PER_BLOCK * job->num_pieces) &&
+        (((cells + NUM_SQUARES_PER_BLOCK * job->num_pieces) % GRID_NUM_COLS) == 0) &&
+        (BalanceFits (job, balance, 0) == 1))
+    {
+        reach = ArenaAlloc (workers[0]->arena, sizeof (reachData));
+        children = ArenaAlloc (workers[0]->arena, REACH_NUM_STATES * sizeof (puzzleChild));
+
+        PieceSpawn (job->types[0], &spawn);
+        ReachSearch (board, &spawn, reach);
+        numChildren = CollectChildren (workers[0], board, missing, balance, 0, reach, children);
+
+        for (ii=0; ii<numChildren; ii++)
+        {
+            ReachLockPiece (reach, children[ii].lock_index, &piece);
+            job->root_pieces[ii] = PiecePack (&piece);
+            job->roots[ii] = *board;
+            job->root_missing[ii] = children[ii].missing;
+            job->root_balance[ii] = children[ii].balance;
+            BoardLockPiece (&job->roots[ii], &piece);
+        }
+        ArenaRelease (workers[0]->arena, 0);
+        job->num_roots = numChildren;
+        job->solved_root = numChildren;
+        workers[0]->nodes++;
+    }
+
+    if ((status == 0) && (job->num_roots > 0))
+    {
+        if (numThreads > job->num_roots)
+        {
+            numThreads = job->num_roots;
+        }
+
+        if (CmtNewThreadPool (numThreads, &pool) < 0)
+        {
+            status = -1;
+        }
+        else
+        {
+            status = ThreadPoolRun (pool, PuzzleWorker, workerData, numThreads);
+            CmtDiscardThreadPool (pool);
+        }
+    }
+
+    for (ii=0; ii<PUZZLE_MAX_THREADS; ii++)
+    {
+        if (workers[ii] == NULL)
+        {
+            continue;
+        }
+
+        result->nodes += workers[ii]->nodes;
+        result->table_hits += workers[ii]->table_hits;
+        result->pruned += workers[ii]->pruned;
+
+        if (workers[ii]->arena != NULL)
+        {
+            ArenaGetStats (workers[ii]->arena, &arena);
+            if ((long long)arena.high_water > result->scratch_bytes)
+            {
+                result->scratch_bytes = (long long)arena.high_water;
+            }
+        }
+
+        if ((workers[ii]->solved_root >= 0) &&
+            ((best < 0) || (workers[ii]->solved_root < workers[best]->solved_root)))
+        {
+            best = ii;
+        }
+    }
+
+    if (best >= 0)
+    {
+        result->status = PUZZLE_SOLVED;
+        for (ii=0; ii<job->num_pieces; ii++)
+        {
+            PieceUnpack (workers[best]->path[ii], &result->placements[ii]);
+        }
+    }
+    else if (job->stopped != 0)
+    {
+        result->status = PUZZLE_UNKNOWN;
+    }
+
+    for (ii=0; ii<PUZZLE_MAX_THREADS; ii++)
+    {
+        if (workers[ii] != NULL)
+        {
+            ArenaDiscard (workers[ii]->arena);
+            free (workers[ii]->table);
+            free (workers[ii]);
+        }
+    }
+    free (job);
+
+    result->seconds = Timer () - start;
+
+    return status;
+
+}  // End of PuzzleSolve()
+
+
+static int BalanceFits (const puzzleJob *job, int balance, int depth)
+{
+    // Full rows and new rows have as many even as odd column cells, so only
+    // the blocks change the balance, and the board is empty when it is 0. I
+    // takes 0 or 4 either way, T 0 or 2, J and L always 2 and the others 0.
+    if ((balance < -job->swing[depth]) || (balance > job->swing[depth]) || ((balance % 2) != 0))
+    {
+        return 0;
+    }
+
+    // Without a T the J and L blocks fix the balance modulo 4
+    if ((job->num_t[depth] == 0) && ((((balance - 2 * job->num_lj[depth]) % 4) + 4) % 4 != 0))
+    {
+        return 0;
+    }
+
+    return 1;
+
+}  // End of BalanceFits()
+
+
+static int BitCount (unsigned int value)
+{
+    int count = 0;
+
+    while (value != 0)
+    {
+        value &= value - 1;
+        count++;
+    }
+
+    return count;
+
+}  // End of BitCount()
+
+
+static int CollectChildren (puzzleWorker *worker, const boardData *board, int missing, int balance, int depth,
+                            const reachData *reach, puzzleChild children[])
+{
+    unsigned int cells = 0;
+    boardData after = {0};
+    puzzleChild child = {0};
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int newRows = 0;
+    int numChildren = 0;
+    pieceData other = {0};
+    boardData otherBoard = {0};
+    pieceData piece = {0};
+    int remaining = worker->job->num_pieces - depth - 1;
+    const pieceShape *shape = NULL;
+    int taken = 0;
+
+    for (ii=0; ii<reach->num_locks; ii++)
+    {
+        ReachLockPiece (reach, ii, &piece);
+
+        // The block fills four cells and brings every empty row it touches
+        // into play, and cleared rows were full, so they change nothing
+        shape = &g_pieceShapes[piece.type_index][piece.orientation];
+        for (jj=0, newRows=0; jj<shape->height; jj++)
+        {
+            newRows += (board->rows[piece.y+jj] == 0);
+        }
+        child.missing = (short)(missing - NUM_SQUARES_PER_BLOCK + GRID_NUM_COLS * newRows);
+
+        // The remaining blocks cannot fill every row still in play
+        if (child.missing > NUM_SQUARES_PER_BLOCK * remaining)
+        {
+            worker->pruned++;
+            continue;
+        }
+
+        // Nor take away the difference between the even and odd columns left empty
+        for (jj=0, taken=0; jj<shape->height; jj++)
+        {
+            cells = (unsigned int)shape->mask[jj] << piece.x;
+            taken += BitCount (cells & EVEN_COLUMNS_MASK) - BitCount (cells & ODD_COLUMNS_MASK);
+        }
+        child.balance = (short)(balance - taken);
+        if (BalanceFits (worker->job, child.balance, depth + 1) == 0)
+        {
+            worker->pruned++;
+            continue;
+        }
+
+        after = *board;
+        child.lines = (short)BoardLockPiece (&after, &piece);
+
+        // Once no new row fits in the budget, full columns are walls no block can cross
+        if ((child.missing + GRID_NUM_COLS > NUM_SQUARES_PER_BLOCK * remaining) && (SplitsEvenly (&after) == 0))
+        {
+            worker->pruned++;
+            continue;
+        }
+
+        child.lock_index = (short)ii;
+        child.hash = HashBoard (&after, 0);
+
+        // Skip placements that leave a board already collected
+        for (jj=0; jj<numChildren; jj++)
+        {
+            if (children[jj].hash == child.hash)
+            {
+                ReachLockPiece (reach, children[jj].lock_index, &other);
+                otherBoard = *board;
+                BoardLockPiece (&otherBoard, &other);
+                if (memcmp (&otherBoard, &after, sizeof (boardData)) == 0)
+                {
+                    break;
+                }
+            }
+        }
+        if (jj < numChildren)
+        {
+            continue;
+        }
+
+        // Line clears first, then the fewest empty cells in play
+        for (jj=numChildren; (jj > 0) && ((children[jj-1].lines < child.lines) ||
+             ((children[jj-1].lines == child.lines) && (children[jj-1].missing > child.missing))); jj--)
+        {
+            children[jj] = children[jj-1];
+        }
+        children[jj] = child;
+        numChildren++;
+    }
+
+    return numChildren;
+
+}  // End of CollectChildren()
+
+
+static int FillsBoard (const boardData *board, int type_index)
+{
+    unsigned short gaps[NUM_SQUARES_PER_BLOCK] = {0};
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int matches = 0;
+    int numRows = 0;
+    const pieceShape *shape = NULL;
+    int x = 0;
+
+    // Rows in play have to be contiguous and no taller than a block
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        if (board->rows[ii] == 0)
+        {
+            continue;
+        }
+
+        if ((numRows == NUM_SQUARES_PER_BLOCK) || ((numRows > 0) && (board->rows[ii-1] == 0)))
+        {
+            return 0;
+        }
+        gaps[numRows++] = (unsigned short)(~board->rows[ii] & FULL_ROW_MASK);
+    }
+
+    // The empty cells must be one of the orientations of the block
+    for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+    {
+        shape = &g_pieceShapes[type_index][ii];
+        if (shape->height != numRows)
+        {
+            continue;
+        }
+
+        for (x=0; x<=GRID_NUM_COLS-shape->width; x++)
+        {
+            for (jj=0, matches=0; jj<numRows; jj++)
+            {
+                matches += (gaps[jj] == (unsigned short)(shape->mask[jj] << x));
+            }
+
+            if (matches == numRows)
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+
+}  // End of FillsBoard()
+
+
+static unsigned long long HashBoard (const boardData *board, int depth)
+{
+    unsigned long long hash = 0x9E3779B97F4A7C15ULL * (depth + 1);
+    int ii = 0;  // Loop iterator
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        hash = (hash ^ board->rows[ii]) * 0xFF51AFD7ED558CCDULL;
+    }
+    hash ^= hash >> 32;
+
+    return (hash != 0) ? hash : 1;
+
+}  // End of HashBoard()
+
+
+static void LowerSolvedRoot (puzzleJob *job, int root)
+{
+    LONG solvedRoot = job->solved_root;
+
+    while (root < solvedRoot)
+    {
+        if (InterlockedCompareExchange (&job->solved_root, root, solvedRoot) == solvedRoot)
+        {
+            break;
+        }
+        solvedRoot = job->solved_root;
+    }
+
+}  // End of LowerSolvedRoot()
+
+
+static int MeasureBoard (const boardData *board, int *cells, int *balance)
+{
+    unsigned int bits = 0;
+    int ii = 0;  // Loop iterator
+    int missing = 0;
+    int rowCells = 0;
+
+    *cells = 0;
+    *balance = 0;
+
+    // Every row with a cell in it must be filled before the board can be empty
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        for (bits=board->rows[ii], rowCells=0; bits != 0; bits &= bits - 1)
+        {
+            rowCells++;
+        }
+
+        if (rowCells > 0)
+        {
+            *cells += rowCells;
+            missing += GRID_NUM_COLS - rowCells;
+            *balance += BitCount (board->rows[ii] & ODD_COLUMNS_MASK) -
+                        BitCount (board->rows[ii] & EVEN_COLUMNS_MASK);
+        }
+    }
+
+    return missing;
+
+}  // End of MeasureBoard()
+
+
+static int CVICALLBACK PuzzleWorker (void *functionData)
+{
+    puzzleWorker *worker = (puzzleWorker *)functionData;
+    puzzleJob *job = worker->job;
+    int root = 0;
+    int status = 0;
+
+    // Take the next first placement until none are left or a lower one is solved
+    for (root=InterlockedIncrement (&job->next_root) - 1; (root < job->num_roots) && (root < job->solved_root);
+         root=InterlockedIncrement (&job->next_root) - 1)
+    {
+        worker->root = root;
+        status = SearchNode (worker, &job->roots[root], job->root_missing[root], job->root_balance[root], 1);
+
+        if (status == PUZZLE_SOLVED)
+        {
+            worker->solved_root = root;
+            worker->path[0] = job->root_pieces[root];
+            LowerSolvedRoot (job, root);
+            break;
+        }
+
+        if (job->stopped != 0)
+        {
+            break;
+        }
+    }
+
+    return 0;
+
+}  // End of PuzzleWorker()
+
+
+static int SearchNode (puzzleWorker *worker, const boardData *board, int missing, int balance, int depth)
+{
+    boardData after = {0};
+    puzzleChild *children = NULL;
+    int ii = 0;  // Loop iterator
+    puzzleJob *job = worker->job;
+    unsigned long long key = 0;
+    size_t mark = 0;
+    int numChildren = 0;
+    pieceData piece = {0};
+    reachData *reach = NULL;
+    int status = PUZZLE_IMPOSSIBLE;
+
+    // Only empty boards get this far, see CollectChildren()
+    if (depth == job->num_pieces)
+    {
+        return PUZZLE_SOLVED;
+    }
+
+    // A lower first placement was solved, or the node limit was reached
+    if ((job->solved_root < worker->root) || (job->stopped != 0))
+    {
+        return PUZZLE_UNKNOWN;
+    }
+
+    // The last block has to fill exactly the cells still empty
+    if ((depth == job->num_pieces - 1) && (FillsBoard (board, job->types[depth]) == 0))
+    {
+        return PUZZLE_IMPOSSIBLE;
+    }
+
+    key = HashBoard (board, depth);
+    if (TableLookup (worker, board, key, depth) != 0)
+    {
+        worker->table_hits++;
+        return PUZZLE_IMPOSSIBLE;
+    }
+
+    worker->nodes++;
+    if (((worker->nodes % NODE_BLOCK_SIZE) == 0) && (job->config->max_nodes > 0) &&
+        ((long long)InterlockedIncrement (&job->node_blocks) * NODE_BLOCK_SIZE >= job->config->max_nodes))
+    {
+        InterlockedExchange (&job->stopped, 1);
+    }
+
+    // Scratch of this depth, handed back before returning. Sized for every
+    // depth in PuzzleSolve(), so it always fits.
+    mark = ArenaMark (worker->arena);
+    reach = ArenaAlloc (worker->arena, sizeof (reachData));
+    children = ArenaAlloc (worker->arena, REACH_NUM_STATES * sizeof (puzzleChild));
+
+    // Game over when the block does not fit at the spawn position
+    PieceSpawn (job->types[depth], &piece);
+    ReachSearch (board, &piece, reach);
+    numChildren = CollectChildren (worker, board, missing, balance, depth, reach, children);
+
+    for (ii=0; (ii < numChildren) && (status == PUZZLE_IMPOSSIBLE); ii++)
+    {
+        ReachLockPiece (reach, children[ii].lock_index, &piece);
+        after = *board;
+        BoardLockPiece (&after, &piece);
+
+        status = SearchNode (worker, &after, children[ii].missing, children[ii].balance, depth + 1);
+        if (status == PUZZLE_SOLVED)
+        {
+            worker->path[depth] = PiecePack (&piece);
+        }
+    }
+
+    ArenaRelease (worker->arena, mark);
+
+    // Not remembered when the search below was cut short
+    if (status == PUZZLE_IMPOSSIBLE)
+    {
+        TableStore (worker, board, key, depth);
+    }
+
+    return status;
+
+}  // End of SearchNode()
+
+
+static int SplitsEvenly (const boardData *board)
+{
+    int column = 0;
+    int empty = 0;
+    int ii = 0;  // Loop iterator
+    unsigned int walls = FULL_ROW_MASK;
+
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        if (board->rows[ii] != 0)
+        {
+            walls &= board->rows[ii];
+        }
+    }
+
+    // Each stretch of columns between walls has to take whole blocks
+    for (column=0; column<=GRID_NUM_COLS; column++)
+    {
+        if ((column == GRID_NUM_COLS) || (walls & (1 << column)))
+        {
+            if ((empty % NUM_SQUARES_PER_BLOCK) != 0)
+            {
+                return 0;
+            }
+            empty = 0;
+            continue;
+        }
+
+        for (ii=0; ii<GRID_NUM_ROWS; ii++)
+        {
+            empty += (board->rows[ii] != 0) && ((board->rows[ii] & (1 << column)) == 0);
+        }
+    }
+
+    return 1;
+
+}  // End of SplitsEvenly()
+
+
+static int TableLookup (const puzzleWorker *worker, const boardData *board, unsigned long long key, int depth)
+{
+    const puzzleEntry *entry = &worker->table[key & worker->table_mask];
+
+    return (entry->key == key) && (entry->depth == depth) &&
+           (memcmp (&entry->board, board, sizeof (boardData)) == 0);
+
+}  // End of TableLookup()
+
+
+static void TableStore (puzzleWorker *worker, const boardData *board, unsigned long long key, int depth)
+{
+    puzzleEntry *entry = &worker->table[key & worker->table_mask];
+
+    // Always replace, recent positions are the most likely to come back
+    entry->key = key;
+    entry->board = *board;
+    entry->depth = depth;
+
+}  // End of TableStore()
@@ -0,0 +1,85 @@
+//==============================================================================
+//
+// Title:       blockdrop_puzzle.h
+// Purpose:     Solver for "clear the board with this block sequence" puzzles.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_puzzle_H__
+#define __blockdrop_puzzle_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_reach.h"
+
+//==============================================================================
+// Constants
+
+#define PUZZLE_MAX_PIECES       32
+#define PUZZLE_MAX_THREADS      64
+
+#define PUZZLE_DEFAULT_TABLE_BITS   16      // Failed positions remembered per thread
+
+// Results
+#define PUZZLE_SOLVED           1
+#define PUZZLE_IMPOSSIBLE       0
+#define PUZZLE_UNKNOWN          -2          // Stopped at the node limit
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_threads;            // 0 uses one thread per processor
+    int table_bits;             // Memo table of 2^table_bits positions per thread
+    long long max_nodes;        // 0 searches until solved or proven impossible
+} puzzleConfig;
+
+typedef struct
+{
+    const char *name;
+    const char *board;          // See BoardParse()
+    const char *sequence;       // Block types, e.g. "IJL"
+    int status;                 // Known PUZZLE_ result
+    long long max_nodes;        // Node budget, the search is stopped past it
+    double max_seconds;         // Slowest acceptable search
+} puzzlePosition;
+
+typedef struct
+{
+    int status;                                 // PUZZLE_ result
+    int num_pieces;
+    pieceData placements[PUZZLE_MAX_PIECES];    // Lock position of each block when solved
+    long long nodes;                            // Positions expanded
+    long long table_hits;                       // Positions already known to fail
+    long long pruned;                           // Placements cut by the cell count, parity or column bounds
+    long long scratch_bytes;                    // Most search scratch one thread had in use
+    double seconds;
+} puzzleResult;
+
+//==============================================================================
+// External variables
+
+extern const puzzlePosition g_puzzlePositions[];
+
+extern const int g_numPuzzlePositions;
+
+//==============================================================================
+// Global functions
+
+void PuzzleDefaultConfig (puzzleConfig *config);
+
+int PuzzleSolve (const boardData *board, const char *sequence, const puzzleConfig *config, puzzleResult *result);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_puzzle_H__ */
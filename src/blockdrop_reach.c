@@ -0,0 +1,431 @@
+//==============================================================================
+//
+// Title:       blockdrop_reach.c
+// Purpose:     Breadth-first search of every position a block can lock in.
+//
+//              Unlike EnumeratePlacements(), which rotates at the top and drops
+//              straight down, the search also finds tucks under overhangs and
+//              rotations into cavities. States are (orientation, row, column)
+//              of the bounding box and moves use the same rules as the game
+//              callbacks via PieceRotateShape(). The search runs one input
+//              layer at a time on column bit masks, so a whole row of states
+//              is expanded with a shift and two ANDs.
+//
+//              With REACH_FREE_DROPS every layer is also closed under moving
+//              down, so the layers count key presses while gravity drops the
+//              block, which is what the finesse analyzer needs.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_reach.h"
+
+//==============================================================================
+// Constants
+
+#define NUM_INPUTS              5
+
+// Index of the lowest set bit, via a de Bruijn multiply
+#define LOW_BIT_INDEX(bits)     (lowBitTable[(((bits) & (0u - (bits))) * 0x077CB531u) >> 27])
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int valid;
+    int orientation;  // Orientation after the input
+    int dx;
+    int dy;
+} moveData;
+
+//==============================================================================
+// Static global variables
+
+// Searched in this order, so horizontal moves and rotations are preferred over drops
+static const char searchInputs[NUM_INPUTS] = {INPUT_LEFT, INPUT_RIGHT, INPUT_CW, INPUT_CCW, INPUT_DOWN};
+
+static const int lowBitTable[32] =
+{
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+//==============================================================================
+// Static functions
+
+static void BuildFitMasks (const boardData *board, int type_index,
+                           unsigned short fits[NUM_ORIENTATIONS][GRID_NUM_ROWS]);
+
+static int CloseDrops (unsigned short frontier[NUM_ORIENTATIONS][GRID_NUM_ROWS],
+                       unsigned short fits[NUM_ORIENTATIONS][GRID_NUM_ROWS],
+                       reachData *reach, int first_row, int *last_row);
+
+static int StateIndex (int orientation, int y, int x);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int ReachInputSequence (const reachData *reach, int lock_index, char inputs[], int max_inputs)
+{
+    int ii = 0;  // Loop iterator
+    int length = 0;
+    pieceData piece = {0};
+    int state = 0;
+    char swap = 0;
+
+    // Walk back to the spawn state by undoing each recorded input
+    ReachLockPiece (reach, lock_index, &piece);
+    state = reach->locks[lock_index];
+
+    while (state != StateIndex (reach->start.orientation, reach->start.y, reach->start.x))
+    {
+        if (length >= max_inputs)
+        {
+            return -1;
+        }
+
+        inputs[length] = reach->inputs[state];
+        switch (inputs[length])
+        {
+            case INPUT_LEFT:
+                piece.x++;
+                break;
+            case INPUT_RIGHT:
+                piece.x--;
+                break;
+            case INPUT_DOWN:
+                piece.y--;
+                break;
+            case INPUT_CW:
+                PieceRotateShape (&piece, ROTATE_CCW);
+                break;
+            case INPUT_CCW:
+                PieceRotateShape (&piece, ROTATE_CW);
+                break;
+        }
+
+        state = StateIndex (piece.orientation, piece.y, piece.x);
+        length++;
+    }
+
+    // Inputs were collected last to first
+    for (ii=0; ii<length/2; ii++)
+    {
+        swap = inputs[ii];
+        inputs[ii] = inputs[length-1-ii];
+        inputs[length-1-ii] = swap;
+    }
+
+    return length;
+
+}  // End of ReachInputSequence()
+
+
+int ReachLockPiece (const reachData *reach, int lock_index, pieceData *piece)
+{
+    int state = reach->locks[lock_index];
+
+    piece->type_index = reach->type_index;
+    piece->x = state % GRID_NUM_COLS;
+    piece->y = (state / GRID_NUM_COLS) % GRID_NUM_ROWS;
+    piece->orientation = state / (GRID_NUM_COLS * GRID_NUM_ROWS);
+
+    return 0;
+
+}  // End of ReachLockPiece()
+
+
+int ReachSearch (const boardData *board, const pieceData *start, reachData *reach)
+{
+    return ReachSearchEx (board, start, 0, reach);
+
+}  // End of ReachSearch()
+
+
+int ReachSearchEx (const boardData *board, const pieceData *start, int options, reachData *reach)
+{
+    unsigned int bits = 0;
+    unsigned short *current = NULL;
+    unsigned short fits[NUM_ORIENTATIONS][GRID_NUM_ROWS];
+    unsigned short frontier[2][NUM_ORIENTATIONS][GRID_NUM_ROWS];
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    int firstRow = 0;
+    int lastRow = 0;
+    int layer = 0;
+    unsigned short locked = 0;
+    const moveData *move = NULL;
+    moveData moves[NUM_ORIENTATIONS][NUM_INPUTS];
+    int nextFirstRow = 0;
+    int nextLastRow = 0;
+    int nextY = 0;
+    int numNew = 1;
+    pieceData piece = {0};
+    unsigned short reached = 0;
+    int x = 0;
+
+    reach->type_index = start->type_index;
+    reach->start = *start;
+    reach->num_locks = 0;
+    memset (reach->visited, 0, sizeof (reach->visited));
+    memset (frontier, 0, sizeof (frontier));
+
+    BuildFitMasks (board, start->type_index, fits);
+
+    // Resolve every input once per orientation instead of once per state
+    for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+    {
+        for (jj=0; jj<NUM_INPUTS; jj++)
+        {
+            piece.type_index = start->type_index;
+            piece.orientation = ii;
+            piece.x = 0;
+            piece.y = 0;
+            moves[ii][jj].valid = 1;
+
+            switch (searchInputs[jj])
+            {
+                case INPUT_LEFT:
+                    piece.x--;
+                    break;
+                case INPUT_RIGHT:
+                    piece.x++;
+                    break;
+                case INPUT_DOWN:
+                    piece.y++;
+                    moves[ii][jj].valid = ((options & REACH_FREE_DROPS) == 0);
+                    break;
+                case INPUT_CW:
+                    moves[ii][jj].valid = PieceRotateShape (&piece, ROTATE_CW);
+                    break;
+                case INPUT_CCW:
+                    moves[ii][jj].valid = PieceRotateShape (&piece, ROTATE_CCW);
+                    break;
+            }
+
+            moves[ii][jj].orientation = piece.orientation;
+            moves[ii][jj].dx = piece.x;
+            moves[ii][jj].dy = piece.y;
+
+            // Two orientation blocks reach the same state with either rotation
+            if ((searchInputs[jj] == INPUT_CCW) &&
+                (moves[ii][jj].orientation == moves[ii][jj-1].orientation) &&
+                (moves[ii][jj].dx == moves[ii][jj-1].dx) && (moves[ii][jj].dy == moves[ii][jj-1].dy))
+            {
+                moves[ii][jj].valid = 0;
+            }
+        }
+    }
+
+    // Game over, the block does not fit at all
+    if ((start->x < 0) || (start->x >= GRID_NUM_COLS) ||
+        (start->y < 0) || (start->y >= GRID_NUM_ROWS) ||
+        ((fits[start->orientation][start->y] & (1 << start->x)) == 0))
+    {
+        return 0;
+    }
+
+    reach->visited[start->orientation][start->y] = (unsigned short)(1 << start->x);
+    frontier[0][start->orientation][start->y] = reach->visited[start->orientation][start->y];
+    firstRow = start->y;
+    lastRow = start->y;
+
+    if (options & REACH_FREE_DROPS)
+    {
+        CloseDrops (frontier[0], fits, reach, firstRow, &lastRow);
+    }
+
+    // Expand one input layer at a time so the first visit is a shortest path
+    for (layer=0; numNew > 0; layer ^= 1)
+    {
+        numNew = 0;
+        nextFirstRow = GRID_NUM_ROWS;
+        nextLastRow = -1;
+        memset (frontier[layer^1], 0, sizeof (frontier[0]));
+
+        for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+        {
+            current = frontier[layer][ii];
+
+            // Only the rows touched by the previous layer can hold frontier states
+            for (jj=firstRow; jj<=lastRow; jj++)
+            {
+                if (current[jj] == 0)
+                {
+                    continue;
+                }
+
+                // Blocks lock once they cannot move down
+                locked = current[jj];
+                if (jj + 1 < GRID_NUM_ROWS)
+                {
+                    locked &= (unsigned short)~fits[ii][jj+1];
+                }
+                for (bits=locked; bits != 0; bits &= bits - 1)
+                {
+                    x = LOW_BIT_INDEX (bits);
+                    reach->locks[reach->num_locks++] = (short)StateIndex (ii, jj, x);
+                }
+
+                for (kk=0; kk<NUM_INPUTS; kk++)
+                {
+                    move = &moves[ii][kk];
+                    nextY = jj + move->dy;
+                    if ((move->valid == 0) || (nextY < 0) || (nextY >= GRID_NUM_ROWS))
+                    {
+                        continue;
+                    }
+
+                    reached = (move->dx >= 0) ? (unsigned short)(current[jj] << move->dx) :
+                                                (unsigned short)(current[jj] >> -move->dx);
+                    reached &= fits[move->orientation][nextY] & ~reach->visited[move->orientation][nextY];
+                    if (reached == 0)
+                    {
+                        continue;
+                    }
+
+                    reach->visited[move->orientation][nextY] |= reached;
+                    frontier[layer^1][move->orientation][nextY] |= reached;
+                    numNew++;
+
+                    if (nextY < nextFirstRow)
+                    {
+                        nextFirstRow = nextY;
+                    }
+                    if (nextY > nextLastRow)
+                    {
+                        nextLastRow = nextY;
+                    }
+
+                    for (bits=reached; bits != 0; bits &= bits - 1)
+                    {
+                        x = LOW_BIT_INDEX (bits);
+                        reach->inputs[StateIndex (move->orientation, nextY, x)] = searchInputs[kk];
+                    }
+                }
+            }
+        }
+
+        if ((options & REACH_FREE_DROPS) && (numNew > 0))
+        {
+            numNew += CloseDrops (frontier[layer^1], fits, reach, nextFirstRow, &nextLastRow);
+        }
+
+        firstRow = nextFirstRow;
+        lastRow = nextLastRow;
+    }
+
+    return reach->num_locks;
+
+}  // End of ReachSearchEx()
+
+
+static void BuildFitMasks (const boardData *board, int type_index,
+                           unsigned short fits[NUM_ORIENTATIONS][GRID_NUM_ROWS])
+{
+    unsigned int blocked = 0;
+    unsigned int cells = 0;
+    int column = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    const pieceShape *shape = NULL;
+
+    for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+    {
+        shape = &g_pieceShapes[type_index][ii];
+
+        for (jj=0; jj<GRID_NUM_ROWS; jj++)
+        {
+            if (jj + shape->height > GRID_NUM_ROWS)
+            {
+                fits[ii][jj] = 0;
+                continue;
+            }
+
+            // Bit x is set when a square of the block at column x would overlap the stack
+            blocked = 0;
+            for (kk=0; kk<shape->height; kk++)
+            {
+                cells = shape->mask[kk];
+                for (column=0; cells != 0; column++, cells >>= 1)
+                {
+                    if (cells & 1)
+                    {
+                        blocked |= (unsigned int)board->rows[jj+kk] >> column;
+                    }
+                }
+            }
+
+            fits[ii][jj] = (unsigned short)(~blocked & ((1 << (GRID_NUM_COLS - shape->width + 1)) - 1));
+        }
+    }
+
+}  // End of BuildFitMasks()
+
+
+static int CloseDrops (unsigned short frontier[NUM_ORIENTATIONS][GRID_NUM_ROWS],
+                       unsigned short fits[NUM_ORIENTATIONS][GRID_NUM_ROWS],
+                       reachData *reach, int first_row, int *last_row)
+{
+    unsigned int bits = 0;
+    unsigned short falling = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numNew = 0;
+    unsigned short reached = 0;
+    int x = 0;
+
+    // Top to bottom, so a state dropped into a row keeps falling from there
+    for (ii=0; ii<NUM_ORIENTATIONS; ii++)
+    {
+        for (jj=first_row; jj<GRID_NUM_ROWS-1; jj++)
+        {
+            falling = frontier[ii][jj] & fits[ii][jj+1];
+            if (falling == 0)
+            {
+                continue;
+            }
+
+            reached = falling & ~reach->visited[ii][jj+1];
+            if (reached != 0)
+            {
+                reach->visited[ii][jj+1] |= reached;
+                frontier[ii][jj+1] |= reached;
+                numNew++;
+
+                if (jj + 1 > *last_row)
+                {
+                    *last_row = jj + 1;
+                }
+            }
+
+            // States of this layer are also claimed by falling into them, so the
+            // recorded key presses happen as high up as possible
+            for (bits=falling & frontier[ii][jj+1]; bits != 0; bits &= bits - 1)
+            {
+                x = LOW_BIT_INDEX (bits);
+                reach->inputs[StateIndex (ii, jj + 1, x)] = INPUT_DOWN;
+            }
+        }
+    }
+
+    return numNew;
+
+}  // End of CloseDrops()
+
+
+static int StateIndex (int orientation, int y, int x)
+{
+    return (orientation * GRID_NUM_ROWS + y) * GRID_NUM_COLS + x;
+
+}  // End of StateIndex()
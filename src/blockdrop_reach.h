@@ -0,0 +1,69 @@
+//==============================================================================
+//
+// Title:       blockdrop_reach.h
+// Purpose:     Breadth-first search of every position a block can lock in.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_reach_H__
+#define __blockdrop_reach_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+// One state per orientation, row and column of the bounding box
+#define REACH_NUM_STATES        (NUM_ORIENTATIONS * GRID_NUM_ROWS * GRID_NUM_COLS)
+
+// Inputs, named after the keyboard controls
+#define INPUT_LEFT              'L'
+#define INPUT_RIGHT             'R'
+#define INPUT_DOWN              'D'
+#define INPUT_CW                'X'
+#define INPUT_CCW               'Z'
+
+// ReachSearchEx() options
+#define REACH_FREE_DROPS        0x1     // Moving down costs no input, like gravity
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int type_index;
+    pieceData start;
+    int num_locks;
+    short locks[REACH_NUM_STATES];                              // States that cannot move down
+    char inputs[REACH_NUM_STATES];                              // Input that first reached each state
+    unsigned short visited[NUM_ORIENTATIONS][GRID_NUM_ROWS];    // Column bits per orientation and row
+} reachData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int ReachInputSequence (const reachData *reach, int lock_index, char inputs[], int max_inputs);
+
+int ReachLockPiece (const reachData *reach, int lock_index, pieceData *piece);
+
+int ReachSearch (const boardData *board, const pieceData *start, reachData *reach);
+
+int ReachSearchEx (const boardData *board, const pieceData *start, int options, reachData *reach);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_reach_H__ */
@@ -0,0 +1,580 @@
+//==============================================================================
+//
+// Title:       blockdrop_regress.c
+// Purpose:     Performance baselines and the regression check against them.
+//
+//              A baseline holds every sample of every metric: the per call
+//              times of the micro-benchmarks and the games and blocks per
+//              second of the headless greedy player. A later run is compared
+//              metric by metric with the one sided Mann-Whitney U test, so a
+//              slowdown is only reported when the samples say it is unlikely
+//              to be noise and the medians moved by at least min_change.
+//
+//              RegressRun() is the whole gate. It runs in the CVI built tools
+//              on Windows and in blockdrop_gate, which the Makefile builds on
+//              Linux with the portable calls of blockdrop_platform.c.
+//
+//              Baseline file, text, one metric per line after the header:
+//
+//                  blockdrop_baseline <REGRESS_FILE_VERSION>
+//                  <num_metrics>
+//                  <name> <unit> <higher_is_better> <num_samples> <sample> ...
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_regress.h"
+
+//==============================================================================
+// Constants
+
+#define REGRESS_FILE_TAG        "blockdrop_baseline"
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    double value;
+    int current;                // Nonzero for a sample of the current run
+} rankedSample;
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int CompareDoubles (const void *a, const void *b);
+
+static int CompareRanked (const void *a, const void *b);
+
+static double MannWhitney (const regressMetric *baseline, const regressMetric *current);
+
+static double Median (const double samples[], int num_samples);
+
+static double NormalTail (double z);
+
+static double PlayGames (const regressConfig *config, long long *num_pieces);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int RegressCollect (const regressConfig *config, const benchConfig *bench_config, regressMetric metrics[],
+                    int max_metrics)
+{
+    int ii = 0;  // Loop iterator
+    int numMetrics = 0;
+    int numResults = 0;
+    long long numPieces = 0;
+    benchResult *results = NULL;
+    double seconds = 0.0;
+
+    if ((config->num_runs < 1) || (config->num_runs > BENCH_MAX_SAMPLES) || (config->num_games < 1) ||
+        (max_metrics < 2))
+    {
+        return -1;
+    }
+
+    results = calloc (BENCH_MAX_RESULTS, sizeof (benchResult));
+    if (results == NULL)
+    {
+        return -1;
+    }
+
+    numResults = BenchRunAll (bench_config, results, BENCH_MAX_RESULTS);
+    if (numResults < 0)
+    {
+        free (results);
+        return -1;
+    }
+
+    for (ii=0; (ii < numResults) && (numMetrics < max_metrics - 2); ii++)
+    {
+        memset (&metrics[numMetrics], 0, sizeof (regressMetric));
+        strcpy (metrics[numMetrics].name, results[ii].name);
+        strcpy (metrics[numMetrics].unit, "ns");
+        metrics[numMetrics].num_samples = results[ii].num_samples;
+        memcpy (metrics[numMetrics].samples, results[ii].samples_ns, results[ii].num_samples * sizeof (double));
+        numMetrics++;
+    }
+
+    free (results);
+
+    memset (&metrics[numMetrics], 0, 2 * sizeof (regressMetric));
+    strcpy (metrics[numMetrics].name, "simulate_games");
+    strcpy (metrics[numMetrics].unit, "games/s");
+    strcpy (metrics[numMetrics+1].name, "simulate_pieces");
+    strcpy (metrics[numMetrics+1].unit, "pieces/s");
+    metrics[numMetrics].higher_is_better = 1;
+    metrics[numMetrics+1].higher_is_better = 1;
+
+    // One run first to warm up, the games are the same every run
+    PlayGames (config, &numPieces);
+    for (ii=0; ii<config->num_runs; ii++)
+    {
+        seconds = PlayGames (config, &numPieces);
+        if (seconds <= 0.0)
+        {
+            seconds = 1e-9;
+        }
+        metrics[numMetrics].samples[ii] = config->num_games / seconds;
+        metrics[numMetrics+1].samples[ii] = numPieces / seconds;
+    }
+    metrics[numMetrics].num_samples = config->num_runs;
+    metrics[numMetrics+1].num_samples = config->num_runs;
+
+    return numMetrics + 2;
+
+}  // End of RegressCollect()
+
+
+int RegressCompare (const regressConfig *config, const regressMetric baseline[], int num_baseline,
+                    const regressMetric current[], int num_current, regressComparison comparisons[],
+                    int *num_comparisons)
+{
+    regressComparison *comparison = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numRegressed = 0;
+
+    *num_comparisons = 0;
+
+    // Metrics only in one of the runs are left out
+    for (ii=0; ii<num_current; ii++)
+    {
+        for (jj=0; jj<num_baseline; jj++)
+        {
+            if (strcmp (current[ii].name, baseline[jj].name) == 0)
+            {
+                break;
+            }
+        }
+
+        if ((jj == num_baseline) || (current[ii].num_samples < 1) || (baseline[jj].num_samples < 1))
+        {
+            continue;
+        }
+
+        comparison = &comparisons[(*num_comparisons)++];
+        memset (comparison, 0, sizeof (regressComparison));
+        strcpy (comparison->name, current[ii].name);
+        strcpy (comparison->unit, current[ii].unit);
+
+        comparison->baseline_median = Median (baseline[jj].samples, baseline[jj].num_samples);
+        comparison->current_median = Median (current[ii].samples, current[ii].num_samples);
+        if (comparison->baseline_median > 0.0)
+        {
+            comparison->change = (comparison->current_median - comparison->baseline_median) /
+                                 comparison->baseline_median;
+            if (current[ii].higher_is_better)
+            {
+                comparison->change = -comparison->change;
+            }
+        }
+
+        comparison->p_value = MannWhitney (&baseline[jj], &current[ii]);
+        comparison->regressed = (comparison->p_value < config->alpha) && (comparison->change >= config->min_change);
+        numRegressed += comparison->regressed;
+    }
+
+    return numRegressed;
+
+}  // End of RegressCompare()
+
+
+void RegressDefaultConfig (regressConfig *config)
+{
+    memset (config, 0, sizeof (regressConfig));
+
+    config->num_runs = 21;
+    config->num_games = 20;
+    config->max_pieces = 500;
+    config->alpha = 0.01;
+    config->min_change = 0.05;
+
+}  // End of RegressDefaultConfig()
+
+
+int RegressReadBaseline (const char *path, regressMetric metrics[], int max_metrics, int *num_metrics)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numMetrics = 0;
+    regressMetric *metric = NULL;
+    char tag[BENCH_NAME_SIZE] = "\0";
+    int version = 0;
+
+    *num_metrics = 0;
+
+    file = fopen (path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fscanf (file, "%31s %d %d", tag, &version, &numMetrics) != 3) || (strcmp (tag, REGRESS_FILE_TAG) != 0) ||
+        (version != REGRESS_FILE_VERSION) || (numMetrics < 0) || (numMetrics > max_metrics))
+    {
+        fclose (file);
+        return -1;
+    }
+
+    for (ii=0; ii<numMetrics; ii++)
+    {
+        metric = &metrics[ii];
+        memset (metric, 0, sizeof (regressMetric));
+        if ((fscanf (file, "%31s %15s %d %d", metric->name, metric->unit, &metric->higher_is_better,
+                     &metric->num_samples) != 4) || (metric->num_samples < 0) ||
+            (metric->num_samples > BENCH_MAX_SAMPLES))
+        {
+            fclose (file);
+            return -1;
+        }
+
+        for (jj=0; jj<metric->num_samples; jj++)
+        {
+            if (fscanf (file, "%lf", &metric->samples[jj]) != 1)
+            {
+                fclose (file);
+                return -1;
+            }
+        }
+    }
+
+    fclose (file);
+    *num_metrics = numMetrics;
+
+    return 0;
+
+}  // End of RegressReadBaseline()
+
+
+int RegressRun (int record, const char *baseline_path, const char *report_path, int num_samples)
+{
+    regressMetric *baseline = NULL;
+    benchConfig benchSettings;
+    regressComparison *comparisons = NULL;
+    regressConfig config;
+    regressMetric *current = NULL;
+    int numBaseline = 0;
+    int numComparisons = 0;
+    int numCurrent = 0;
+    int numRegressed = 0;
+    int status = -1;
+
+    BenchDefaultConfig (&benchSettings);
+    RegressDefaultConfig (&config);
+    if (num_samples > 0)
+    {
+        benchSettings.num_samples = num_samples;
+        config.num_runs = num_samples;
+    }
+
+    baseline = calloc (REGRESS_MAX_METRICS, sizeof (regressMetric));
+    current = calloc (REGRESS_MAX_METRICS, sizeof (regressMetric));
+    comparisons = calloc (REGRESS_MAX_METRICS, sizeof (regressComparison));
+    if ((baseline == NULL) || (current == NULL) || (comparisons == NULL))
+    {
+        status = -1;
+    }
+    else if (!record && (RegressReadBaseline (baseline_path, baseline, REGRESS_MAX_METRICS, &numBaseline) != 0))
+    {
+        printf ("Unable to read baseline %s\n", baseline_path);
+    }
+    else if ((numCurrent = RegressCollect (&config, &benchSettings, current, REGRESS_MAX_METRICS)) < 0)
+    {
+        printf ("Invalid benchmark settings\n");
+    }
+    else if (record)
+    {
+        if (RegressWriteBaseline (baseline_path, current, numCurrent) == 0)
+        {
+            printf ("%d metrics written to %s\n", numCurrent, baseline_path);
+            status = 0;
+        }
+        else
+        {
+            printf ("Unable to write %s\n", baseline_path);
+        }
+    }
+    else
+    {
+        numRegressed = RegressCompare (&config, baseline, numBaseline, current, numCurrent, comparisons,
+                                       &numComparisons);
+        RegressWriteReport (NULL, comparisons, numComparisons);
+
+        // Nonzero exit code for a build script when anything got slower
+        status = (numRegressed > 0) ? 1 : 0;
+        if ((report_path != NULL) && (RegressWriteReport (report_path, comparisons, numComparisons) != 0))
+        {
+            printf ("Unable to write %s\n", report_path);
+            status = -1;
+        }
+    }
+
+    free (comparisons);
+    free (current);
+    free (baseline);
+
+    return status;
+
+}  // End of RegressRun()
+
+
+int RegressWriteBaseline (const char *path, const regressMetric metrics[], int num_metrics)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf (file, "%s %d\n%d\n", REGRESS_FILE_TAG, REGRESS_FILE_VERSION, num_metrics);
+
+    for (ii=0; ii<num_metrics; ii++)
+    {
+        fprintf (file, "%s %s %d %d", metrics[ii].name, metrics[ii].unit, metrics[ii].higher_is_better,
+                 metrics[ii].num_samples);
+        for (jj=0; jj<metrics[ii].num_samples; jj++)
+        {
+            fprintf (file, " %.6g", metrics[ii].samples[jj]);
+        }
+        fprintf (file, "\n");
+    }
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of RegressWriteBaseline()
+
+
+int RegressWriteReport (const char *path, const regressComparison comparisons[], int num_comparisons)
+{
+    const char *extension = NULL;
+    FILE *file = stdout;
+    int html = 0;
+    int ii = 0;  // Loop iterator
+    int numRegressed = 0;
+
+    // Text to stdout without a path, HTML for .htm and .html files
+    if (path != NULL)
+    {
+        extension = strrchr (path, '.');
+        html = (extension != NULL) && ((strcmp (extension, ".html") == 0) || (strcmp (extension, ".htm") == 0));
+
+        file = fopen (path, "w");
+        if (file == NULL)
+        {
+            return -1;
+        }
+    }
+
+    for (ii=0; ii<num_comparisons; ii++)
+    {
+        numRegressed += comparisons[ii].regressed;
+    }
+
+    if (html)
+    {
+        fprintf (file, "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n");
+        fprintf (file, "<title>Block drop performance</title>\n<style>\n");
+        fprintf (file, "body { font-family: sans-serif; }\n");
+        fprintf (file, "td, th { padding: 2px 10px; text-align: right; }\n");
+        fprintf (file, "td:first-child, th:first-child { text-align: left; }\n");
+        fprintf (file, ".regressed { background: #f4c7c3; }\n");
+        fprintf (file, "</style>\n</head>\n<body>\n");
+        fprintf (file, "<h1>%d of %d metrics regressed</h1>\n<table>\n", numRegressed, num_comparisons);
+        fprintf (file, "<tr><th>Metric</th><th>Unit</th><th>Baseline</th><th>Current</th><th>Slowdown</th>"
+                 "<th>p</th></tr>\n");
+
+        for (ii=0; ii<num_comparisons; ii++)
+        {
+            fprintf (file, "<tr%s><td>%s</td><td>%s</td><td>%.3f</td><td>%.3f</td><td>%+.1f%%</td>"
+                     "<td>%.4f</td></tr>\n",
+                     comparisons[ii].regressed ? " class=\"regressed\"" : "", comparisons[ii].name,
+                     comparisons[ii].unit, comparisons[ii].baseline_median, comparisons[ii].current_median,
+                     comparisons[ii].change * 100.0, comparisons[ii].p_value);
+        }
+
+        fprintf (file, "</table>\n</body>\n</html>\n");
+    }
+    else
+    {
+        fprintf (file, "%-20s %-9s %12s %12s %9s %8s\n", "metric", "unit", "baseline", "current", "slowdown", "p");
+        for (ii=0; ii<num_comparisons; ii++)
+        {
+            fprintf (file, "%-20s %-9s %12.3f %12.3f %+8.1f%% %8.4f%s\n", comparisons[ii].name, comparisons[ii].unit,
+                     comparisons[ii].baseline_median, comparisons[ii].current_median, comparisons[ii].change * 100.0,
+                     comparisons[ii].p_value, comparisons[ii].regressed ? "  REGRESSED" : "");
+        }
+        fprintf (file, "%d of %d metrics regressed\n", numRegressed, num_comparisons);
+    }
+
+    if (file == stdout)
+    {
+        return 0;
+    }
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of RegressWriteReport()
+
+
+static int CompareDoubles (const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+
+}  // End of CompareDoubles()
+
+
+static int CompareRanked (const void *a, const void *b)
+{
+    double x = ((const rankedSample *)a)->value;
+    double y = ((const rankedSample *)b)->value;
+
+    return (x > y) - (x < y);
+
+}  // End of CompareRanked()
+
+
+static double MannWhitney (const regressMetric *baseline, const regressMetric *current)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    double mean = 0.0;
+    int n1 = baseline->num_samples;
+    int n2 = current->num_samples;
+    int numSamples = n1 + n2;
+    double rank = 0.0;
+    double rankSum = 0.0;
+    rankedSample samples[2 * BENCH_MAX_SAMPLES];
+    double ties = 0.0;
+    double u = 0.0;
+    double variance = 0.0;
+    double z = 0.0;
+
+    for (ii=0; ii<n1; ii++)
+    {
+        samples[ii].value = baseline->samples[ii];
+        samples[ii].current = 0;
+    }
+    for (ii=0; ii<n2; ii++)
+    {
+        samples[n1+ii].value = current->samples[ii];
+        samples[n1+ii].current = 1;
+    }
+    qsort (samples, numSamples, sizeof (rankedSample), CompareRanked);
+
+    // Rank sum of the current samples, equal values share their mean rank
+    for (ii=0; ii<numSamples; ii=jj)
+    {
+        for (jj=ii+1; jj<numSamples; jj++)
+        {
+            if (samples[jj].value != samples[ii].value)
+            {
+                break;
+            }
+        }
+
+        rank = (ii + 1 + jj) / 2.0;
+        ties += (double)(jj - ii) * (jj - ii) * (jj - ii) - (jj - ii);
+        for (kk=ii; kk<jj; kk++)
+        {
+            rankSum += samples[kk].current ? rank : 0.0;
+        }
+    }
+
+    // Normal approximation with tie and continuity corrections
+    u = rankSum - n2 * (n2 + 1) / 2.0;
+    mean = n1 * (double)n2 / 2.0;
+    variance = n1 * (double)n2 / 12.0 * ((numSamples + 1) - ties / ((double)numSamples * (numSamples - 1)));
+    if (variance <= 0.0)
+    {
+        return 1.0;
+    }
+
+    // Slower is larger for times and smaller for rates
+    z = current->higher_is_better ? (mean - u - 0.5) : (u - mean - 0.5);
+
+    return NormalTail (z / sqrt (variance));
+
+}  // End of MannWhitney()
+
+
+static double Median (const double samples[], int num_samples)
+{
+    double sorted[BENCH_MAX_SAMPLES];
+
+    memcpy (sorted, samples, num_samples * sizeof (double));
+    qsort (sorted, num_samples, sizeof (double), CompareDoubles);
+
+    if (num_samples % 2)
+    {
+        return sorted[num_samples/2];
+    }
+
+    return (sorted[num_samples/2-1] + sorted[num_samples/2]) / 2.0;
+
+}  // End of Median()
+
+
+static double NormalTail (double z)
+{
+    double t = 0.0;
+    double tail = 0.0;
+    double x = fabs (z) / sqrt (2.0);
+
+    // Upper tail of the standard normal from erfc, Abramowitz and Stegun 7.1.26
+    t = 1.0 / (1.0 + 0.3275911 * x);
+    tail = 0.5 * t * (0.254829592 + t * (-0.284496736 + t * (1.421413741 + t * (-1.453152027 + t * 1.061405429)))) *
+           exp (-x * x);
+
+    return (z >= 0.0) ? tail : 1.0 - tail;
+
+}  // End of NormalTail()
+
+
+static double PlayGames (const regressConfig *config, long long *num_pieces)
+{
+    gameData game;
+    int ii = 0;  // Loop iterator
+    placementData placement = {0};
+    double seconds = Timer ();
+
+    *num_pieces = 0;
+
+    for (ii=0; ii<config->num_games; ii++)
+    {
+        GameReset (&game, ii + 1);
+
+        while ((game.game_status != GAME_END) && (game.pieces <= config->max_pieces))
+        {
+            if (ChooseGreedyPlacement (&game.board, game.piece.type_index, &g_defaultWeights, &placement) == 0)
+            {
+                break;
+            }
+            GamePlace (&game, &placement);
+        }
+
+        *num_pieces += game.pieces;
+    }
+
+    return Timer () - seconds;
+
+}  // End of PlayGames()
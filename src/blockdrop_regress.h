@@ -0,0 +1,88 @@
+//==============================================================================
+//
+// Title:       blockdrop_regress.h
+// Purpose:     Performance baselines and the regression check against them.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_regress_H__
+#define __blockdrop_regress_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_bench.h"
+
+//==============================================================================
+// Constants
+
+#define REGRESS_FILE_VERSION    1
+#define REGRESS_MAX_METRICS     (BENCH_MAX_RESULTS + 2)
+#define REGRESS_UNIT_SIZE       16
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_runs;               // Samples of the simulator metrics
+    int num_games;              // Greedy games per simulator sample
+    int max_pieces;             // Per game, the greedy player rarely loses
+    double alpha;               // Significance level of the one sided test
+    double min_change;          // Smallest slowdown reported, e.g. 0.05 for 5%
+} regressConfig;
+
+typedef struct
+{
+    char name[BENCH_NAME_SIZE];
+    char unit[REGRESS_UNIT_SIZE];
+    int higher_is_better;               // Nonzero for rates, zero for times
+    int num_samples;
+    double samples[BENCH_MAX_SAMPLES];
+} regressMetric;
+
+typedef struct
+{
+    char name[BENCH_NAME_SIZE];
+    char unit[REGRESS_UNIT_SIZE];
+    double baseline_median;
+    double current_median;
+    double change;              // Relative slowdown of the medians, negative when faster
+    double p_value;             // Mann-Whitney, that the current run is slower
+    int regressed;
+} regressComparison;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int RegressCollect (const regressConfig *config, const benchConfig *bench_config, regressMetric metrics[],
+                    int max_metrics);
+
+int RegressCompare (const regressConfig *config, const regressMetric baseline[], int num_baseline,
+                    const regressMetric current[], int num_current, regressComparison comparisons[],
+                    int *num_comparisons);
+
+void RegressDefaultConfig (regressConfig *config);
+
+int RegressReadBaseline (const char *path, regressMetric metrics[], int max_metrics, int *num_metrics);
+
+int RegressRun (int record, const char *baseline_path, const char *report_path, int num_samples);
+
+int RegressWriteBaseline (const char *path, const regressMetric metrics[], int num_metrics);
+
+int RegressWriteReport (const char *path, const regressComparison comparisons[], int num_comparisons);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_regress_H__ */
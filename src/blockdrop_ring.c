@@ -0,0 +1,331 @@
+//==============================================================================
+//
+// Title:       blockdrop_ring.c
+// Purpose:     Shared memory ring of environment batches for other processes.
+//
+//              One producer steps a vecEnvData straight into the slots of a
+//              named file mapping and one consumer in another process, such as
+//              a Python learner, reads them in place. Nothing is copied or
+//              serialized. Each side only writes its own counter, and named
+//              auto-reset events wake the other side, so there is one event
+//              per batch rather than per observation.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_ring.h"
+
+//==============================================================================
+// Constants
+
+#define ALIGN_UP(size)          (((size) + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1))
+#define MAX_OBJECT_NAME         (RING_MAX_NAME + 32)
+
+//==============================================================================
+// Types
+
+struct ringData
+{
+    int producer;
+    HANDLE mapping;
+    HANDLE data_event;      // Set when a batch is published
+    HANDLE space_event;     // Set when a batch is released
+    ringHeader *header;
+    char *slots;
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void GetSlot (const ringData *ring, LONG count, ringSlot *slot);
+
+static int OpenEvents (ringData *ring, const char *name);
+
+static LONG ReadCount (volatile LONG *count);
+
+static int WaitForEvent (HANDLE event, double deadline);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int RingAcquire (ringData *ring, double timeout, ringSlot *slot)
+{
+    double deadline = (timeout < 0.0) ? -1.0 : Timer () + timeout;
+    LONG writeCount = ring->header->write_count;
+
+    // Wait until the consumer has released the oldest slot
+    while (writeCount - ReadCount (&ring->header->read_count) >= ring->header->num_slots)
+    {
+        if (WaitForEvent (ring->space_event, deadline) != 0)
+        {
+            return RING_ERR_TIMEOUT;
+        }
+    }
+
+    GetSlot (ring, writeCount, slot);
+
+    return 0;
+
+}  // End of RingAcquire()
+
+
+void RingClose (ringData *ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+
+    // Let the consumer drain the ring and stop
+    if (ring->producer && (ring->header != NULL))
+    {
+        InterlockedIncrement (&ring->header->closed);
+        SetEvent (ring->data_event);
+    }
+
+    if (ring->header != NULL)
+    {
+        UnmapViewOfFile (ring->header);
+    }
+    if (ring->mapping != NULL)
+    {
+        CloseHandle (ring->mapping);
+    }
+    if (ring->data_event != NULL)
+    {
+        CloseHandle (ring->data_event);
+    }
+    if (ring->space_event != NULL)
+    {
+        CloseHandle (ring->space_event);
+    }
+
+    free (ring);
+
+}  // End of RingClose()
+
+
+int RingCreate (const char *name, int num_envs, int num_slots, ringData **ring)
+{
+    ringHeader layout = {0};
+    char mappingName[MAX_OBJECT_NAME] = "\0";
+    ringData *newRing = NULL;
+    unsigned long long size = 0;
+
+    *ring = NULL;
+
+    // Power of two slots, so the counters can wrap around
+    if ((strlen (name) >= RING_MAX_NAME) || (num_envs < 1) ||
+        (num_slots < 1) || ((num_slots & (num_slots - 1)) != 0))
+    {
+        return -1;
+    }
+
+    layout.magic = RING_MAGIC;
+    layout.version = RING_VERSION;
+    layout.num_envs = num_envs;
+    layout.num_slots = num_slots;
+    layout.obs_offset = 0;
+    layout.actions_offset = ALIGN_UP (num_envs * (int)sizeof (vecObservation));
+    layout.rewards_offset = ALIGN_UP (layout.actions_offset + num_envs * (int)sizeof (int));
+    layout.dones_offset = ALIGN_UP (layout.rewards_offset + num_envs * (int)sizeof (float));
+    layout.slot_size = ALIGN_UP (layout.dones_offset + num_envs);
+    size = RING_HEADER_SIZE + (unsigned long long)layout.slot_size * num_slots;
+
+    newRing = calloc (1, sizeof (ringData));
+    if (newRing == NULL)
+    {
+        return -1;
+    }
+    newRing->producer = 1;
+
+    sprintf (mappingName, "Local\\blockdrop_ring_%s", name);
+    newRing->mapping = CreateFileMapping (INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                          (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), mappingName);
+
+    // Only one producer per name
+    if ((newRing->mapping == NULL) || (GetLastError () == ERROR_ALREADY_EXISTS))
+    {
+        RingClose (newRing);
+        return -1;
+    }
+
+    newRing->header = MapViewOfFile (newRing->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if ((newRing->header == NULL) || (OpenEvents (newRing, name) != 0))
+    {
+        RingClose (newRing);
+        return -1;
+    }
+    newRing->slots = (char *)newRing->header + RING_HEADER_SIZE;
+
+    // The magic goes in last, so a consumer never sees a half written header
+    layout.magic = 0;
+    *newRing->header = layout;
+    InterlockedExchangeAdd ((volatile LONG *)&newRing->header->magic, RING_MAGIC);
+
+    *ring = newRing;
+
+    return 0;
+
+}  // End of RingCreate()
+
+
+int RingOpen (const char *name, ringData **ring)
+{
+    char mappingName[MAX_OBJECT_NAME] = "\0";
+    ringData *newRing = NULL;
+
+    *ring = NULL;
+
+    if (strlen (name) >= RING_MAX_NAME)
+    {
+        return -1;
+    }
+
+    newRing = calloc (1, sizeof (ringData));
+    if (newRing == NULL)
+    {
+        return -1;
+    }
+
+    sprintf (mappingName, "Local\\blockdrop_ring_%s", name);
+    newRing->mapping = OpenFileMapping (FILE_MAP_ALL_ACCESS, FALSE, mappingName);
+    if (newRing->mapping != NULL)
+    {
+        newRing->header = MapViewOfFile (newRing->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    }
+
+    if ((newRing->header == NULL) || (ReadCount ((volatile LONG *)&newRing->header->magic) != RING_MAGIC) ||
+        (newRing->header->version != RING_VERSION) || (OpenEvents (newRing, name) != 0))
+    {
+        RingClose (newRing);
+        return -1;
+    }
+    newRing->slots = (char *)newRing->header + RING_HEADER_SIZE;
+
+    *ring = newRing;
+
+    return 0;
+
+}  // End of RingOpen()
+
+
+int RingPublish (ringData *ring)
+{
+    InterlockedIncrement (&ring->header->write_count);
+    SetEvent (ring->data_event);
+
+    return 0;
+
+}  // End of RingPublish()
+
+
+int RingReceive (ringData *ring, double timeout, ringSlot *slot)
+{
+    double deadline = (timeout < 0.0) ? -1.0 : Timer () + timeout;
+    LONG readCount = ring->header->read_count;
+
+    while (ReadCount (&ring->header->write_count) == readCount)
+    {
+        // Closed and drained
+        if (ReadCount (&ring->header->closed) != 0)
+        {
+            return RING_ERR_CLOSED;
+        }
+
+        if (WaitForEvent (ring->data_event, deadline) != 0)
+        {
+            return RING_ERR_TIMEOUT;
+        }
+    }
+
+    GetSlot (ring, readCount, slot);
+
+    return 0;
+
+}  // End of RingReceive()
+
+
+int RingRelease (ringData *ring)
+{
+    InterlockedIncrement (&ring->header->read_count);
+    SetEvent (ring->space_event);
+
+    return 0;
+
+}  // End of RingRelease()
+
+
+static void GetSlot (const ringData *ring, LONG count, ringSlot *slot)
+{
+    const ringHeader *header = ring->header;
+    char *base = ring->slots + (size_t)header->slot_size * ((unsigned int)count & (header->num_slots - 1));
+
+    slot->num_envs = header->num_envs;
+    slot->sequence = (unsigned int)count;
+    slot->obs = (vecObservation *)(base + header->obs_offset);
+    slot->actions = (int *)(base + header->actions_offset);
+    slot->rewards = (float *)(base + header->rewards_offset);
+    slot->dones = (unsigned char *)(base + header->dones_offset);
+
+}  // End of GetSlot()
+
+
+static int OpenEvents (ringData *ring, const char *name)
+{
+    char eventName[MAX_OBJECT_NAME] = "\0";
+
+    // Auto reset, the producer creates them and the consumer opens them
+    sprintf (eventName, "Local\\blockdrop_ring_%s_data", name);
+    ring->data_event = ring->producer ? CreateEvent (NULL, FALSE, FALSE, eventName) :
+                                        OpenEvent (SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, eventName);
+
+    sprintf (eventName, "Local\\blockdrop_ring_%s_space", name);
+    ring->space_event = ring->producer ? CreateEvent (NULL, FALSE, FALSE, eventName) :
+                                         OpenEvent (SYNCHRONIZE | EVENT_MODIFY_STATE, FALSE, eventName);
+
+    return ((ring->data_event != NULL) && (ring->space_event != NULL)) ? 0 : -1;
+
+}  // End of OpenEvents()
+
+
+static LONG ReadCount (volatile LONG *count)
+{
+    // Full barrier, so the slot contents are read after the count
+    return InterlockedCompareExchange (count, 0, 0);
+
+}  // End of ReadCount()
+
+
+static int WaitForEvent (HANDLE event, double deadline)
+{
+    double remaining = 0.0;
+
+    if (deadline < 0.0)
+    {
+        WaitForSingleObject (event, INFINITE);
+        return 0;
+    }
+
+    remaining = deadline - Timer ();
+    if (remaining <= 0.0)
+    {
+        return -1;
+    }
+
+    // The caller checks the counters again, a timeout here only ends the wait early
+    WaitForSingleObject (event, (DWORD)(remaining * 1000.0) + 1);
+
+    return 0;
+
+}  // End of WaitForEvent()
@@ -0,0 +1,95 @@
+//==============================================================================
+//
+// Title:       blockdrop_ring.h
+// Purpose:     Shared memory ring of environment batches for other processes.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_ring_H__
+#define __blockdrop_ring_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_vecenv.h"
+
+//==============================================================================
+// Constants
+
+#define RING_MAGIC              0x52444C42  // "BLDR"
+#define RING_VERSION            1
+#define RING_MAX_NAME           64
+#define RING_HEADER_SIZE        256         // Slots start here
+#define RING_ALIGNMENT          64          // Arrays and slots start on cache lines
+
+// Return values
+#define RING_ERR_TIMEOUT        -2
+#define RING_ERR_CLOSED         -3
+
+//==============================================================================
+// Types
+
+// Start of the shared memory. Slot n is at RING_HEADER_SIZE + n * slot_size and
+// holds num_envs observations, actions, rewards and done flags at the offsets.
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    int num_envs;
+    int num_slots;
+    int slot_size;                  // Bytes
+    int obs_offset;                 // vecObservation[num_envs]
+    int actions_offset;             // int[num_envs], the actions that led to the observations
+    int rewards_offset;             // float[num_envs]
+    int dones_offset;               // unsigned char[num_envs]
+    volatile LONG closed;           // Set by the producer when it is done
+    char padding1[24];
+    volatile LONG write_count;      // Batches published, only written by the producer
+    char padding2[60];
+    volatile LONG read_count;       // Batches released, only written by the consumer
+    char padding3[60];
+} ringHeader;
+
+typedef struct
+{
+    int num_envs;
+    unsigned int sequence;          // Batch number since the ring was created
+    vecObservation *obs;
+    int *actions;
+    float *rewards;
+    unsigned char *dones;
+} ringSlot;
+
+typedef struct ringData ringData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int RingAcquire (ringData *ring, double timeout, ringSlot *slot);
+
+void RingClose (ringData *ring);
+
+int RingCreate (const char *name, int num_envs, int num_slots, ringData **ring);
+
+int RingOpen (const char *name, ringData **ring);
+
+int RingPublish (ringData *ring);
+
+int RingReceive (ringData *ring, double timeout, ringSlot *slot);
+
+int RingRelease (ringData *ring);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_ring_H__ */
@@ -0,0 +1,1611 @@
+//==============================================================================
+//
+// Title:       blockdrop_scenario.c
+// Purpose:     Scripted game scenarios run on the headless engine.
+//
+//              A scenario is a few lines of text:
+//
+//                  scenario <name>
+//                  board    <rows>         Starting stack, optional
+//                  pieces   <blocks>       Blocks in order, e.g. IJL
+//                  start    <o> <x> <y>    First block position, optional
+//                  inputs   <inputs>       One SCENARIO_INPUT_ per tick
+//                  expect   <rows>         Stack '#' and active block '@'
+//                  lines    <count>        Optional
+//                  level    <level>        Optional
+//
+//              Rows are written as in BoardParse(), top to bottom and aligned
+//              to the bottom of the grid, either '/' separated or spread over
+//              several board or expect lines. Lines starting with ';' are
+//              comments. A start position, as in pieceData, puts the first
+//              block where inputs alone cannot, e.g. right under an overhang.
+//
+//              Each tick applies one input and then gravity, the same as an
+//              input step of the vectorized environment, so the movement and
+//              rotation rules of PieceMove() and PieceRotate() are what is
+//              being checked.
+//
+//              Scenarios share nothing, so ScenarioRunAll() hands them out to
+//              a thread pool in chunks.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_scenario.h"
+
+//==============================================================================
+// Constants
+
+#define MAX_LINE_SIZE           512
+#define RUN_CHUNK_SIZE          64      // Scenarios taken by a thread at a time
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const scenarioData *scenarios;
+    scenarioResult *results;
+    int num_scenarios;
+    volatile LONG next_chunk;
+    volatile LONG failed;
+} scenarioJob;
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int AppendRows (char text[BOARD_TEXT_SIZE], const char *rows);
+
+static int FinishScenario (scenarioData *scenario, const char *board_text, const char *expect_text);
+
+static int CVICALLBACK ScenarioWorker (void *functionData);
+
+static void SpawnNextPiece (gameData *game, const char *pieces, int *next);
+
+static void StepScenario (gameData *game, char input, const char *pieces, int *next);
+
+//==============================================================================
+// Global variables
+
+// Every branch of CB_BtnRotateCW() and CB_BtnRotateCCW(): each orientation of
+// each block rotated in open space, against the walls and floor, and blocked
+// by each cell the rotation moves into. The expected grids are the engine
+// rules, which the callbacks match since the T branches out of orientation 1
+// check the cell below the center and the floor; see the three marked below.
+const char g_rotationScenarios[] =
+    "scenario I cw from 1 open\n"
+    "pieces   I\n"
+    "inputs   DDDDDDDD.C\n"
+    "expect   .....@..../.....@..../.....@..../.....@..../..........\n"
+    "scenario I cw from 1 blocked at 5,17\n"
+    "board    .....#..../........../........../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   C\n"
+    "expect   .....#..../........../........../........../...@@@@.../..........\n"
+    "scenario I cw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   C\n"
+    "expect   .....#..../........../........../...@@@@.../..........\n"
+    "scenario I cw from 1 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   C\n"
+    "expect   .....#..../........../...@@@@.../..........\n"
+    "scenario I cw from 1 left wall\n"
+    "pieces   I\n"
+    "inputs   LLLLLLDDDDD.C\n"
+    "expect   ..@......./..@......./..@......./..@......./..........\n"
+    "scenario I cw from 1 right wall\n"
+    "pieces   I\n"
+    "inputs   RRRRRRDDDDD.C\n"
+    "expect   ........@./........@./........@./........@./..........\n"
+    "scenario I cw from 1 floor\n"
+    "pieces   I\n"
+    "inputs   DDDDDDDDD.C\n"
+    "expect   .....#..../.....#..../.....#..../.....#....\n"
+    "scenario I ccw from 1 open\n"
+    "pieces   I\n"
+    "inputs   DDDDDDDD.A\n"
+    "expect   .....@..../.....@..../.....@..../.....@..../..........\n"
+    "scenario I ccw from 1 blocked at 5,17\n"
+    "board    .....#..../........../........../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   A\n"
+    "expect   .....#..../........../........../........../...@@@@.../..........\n"
+    "scenario I ccw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   A\n"
+    "expect   .....#..../........../........../...@@@@.../..........\n"
+    "scenario I ccw from 1 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   I\n"
+    "start    0 3 20\n"
+    "inputs   A\n"
+    "expect   .....#..../........../...@@@@.../..........\n"
+    "scenario I ccw from 1 left wall\n"
+    "pieces   I\n"
+    "inputs   LLLLLLDDDDD.A\n"
+    "expect   ..@......./..@......./..@......./..@......./..........\n"
+    "scenario I ccw from 1 right wall\n"
+    "pieces   I\n"
+    "inputs   RRRRRRDDDDD.A\n"
+    "expect   ........@./........@./........@./........@./..........\n"
+    "scenario I ccw from 1 floor\n"
+    "pieces   I\n"
+    "inputs   DDDDDDDDD.A\n"
+    "expect   .....#..../.....#..../.....#..../.....#....\n"
+    "scenario I cw from 2 open\n"
+    "pieces   I\n"
+    "inputs   CDDDDDDDDC\n"
+    "expect   ...@@@@.../..........\n"
+    "scenario I cw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   C\n"
+    "expect   .....@..../.....@..../...#.@..../.....@..../..........\n"
+    "scenario I cw from 2 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   C\n"
+    "expect   .....@..../.....@..../....#@..../.....@..../..........\n"
+    "scenario I cw from 2 blocked at 6,20\n"
+    "board    ......#.../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   C\n"
+    "expect   .....@..../.....@..../.....@#.../.....@..../..........\n"
+    "scenario I cw from 2 left wall\n"
+    "pieces   I\n"
+    "inputs   CLLLLLLDDDDDC\n"
+    "expect   @........./@........./@........./@........./..........\n"
+    "scenario I cw from 2 right wall\n"
+    "pieces   I\n"
+    "inputs   CRRRRRRDDDDDC\n"
+    "expect   .........@/.........@/.........@/.........@/..........\n"
+    "scenario I cw from 2 floor\n"
+    "pieces   I\n"
+    "inputs   CDDDDDDDDDC\n"
+    "expect   ...####...\n"
+    "scenario I ccw from 2 open\n"
+    "pieces   I\n"
+    "inputs   CDDDDDDDDA\n"
+    "expect   ...@@@@.../..........\n"
+    "scenario I ccw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   A\n"
+    "expect   .....@..../.....@..../...#.@..../.....@..../..........\n"
+    "scenario I ccw from 2 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   A\n"
+    "expect   .....@..../.....@..../....#@..../.....@..../..........\n"
+    "scenario I ccw from 2 blocked at 6,20\n"
+    "board    ......#.../........../..........\n"
+    "pieces   I\n"
+    "start    1 5 17\n"
+    "inputs   A\n"
+    "expect   .....@..../.....@..../.....@#.../.....@..../..........\n"
+    "scenario I ccw from 2 left wall\n"
+    "pieces   I\n"
+    "inputs   CLLLLLLDDDDDA\n"
+    "expect   @........./@........./@........./@........./..........\n"
+    "scenario I ccw from 2 right wall\n"
+    "pieces   I\n"
+    "inputs   CRRRRRRDDDDDA\n"
+    "expect   .........@/.........@/.........@/.........@/..........\n"
+    "scenario I ccw from 2 floor\n"
+    "pieces   I\n"
+    "inputs   CDDDDDDDDDA\n"
+    "expect   ...####...\n"
+    "scenario J cw from 1 open\n"
+    "pieces   J\n"
+    "inputs   DDDDDDDDDC\n"
+    "expect   ....@@..../....@...../....@...../..........\n"
+    "scenario J cw from 1 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../........../...@....../...@@@..../..........\n"
+    "scenario J cw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   .....#..../........../...@....../...@@@..../..........\n"
+    "scenario J cw from 1 blocked at 4,19\n"
+    "board    ....#...../........../........../..........\n"
+    "pieces   J\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../...@....../...@@@..../..........\n"
+    "scenario J cw from 1 left wall\n"
+    "pieces   J\n"
+    "inputs   LLLLLLDDDDDDC\n"
+    "expect   .@@......./.@......../.@......../..........\n"
+    "scenario J cw from 1 right wall\n"
+    "pieces   J\n"
+    "inputs   RRRRRRDDDDDDC\n"
+    "expect   ........@@/........@./........@./..........\n"
+    "scenario J cw from 1 floor\n"
+    "pieces   J\n"
+    "inputs   DDDDDDDDDDC\n"
+    "expect   ....##..../....#...../....#.....\n"
+    "scenario J ccw from 1 open\n"
+    "pieces   J\n"
+    "inputs   DDDDDDDDDA\n"
+    "expect   .....@..../.....@..../....@@..../..........\n"
+    "scenario J ccw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../........../...@....../...@@@..../..........\n"
+    "scenario J ccw from 1 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   J\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../...@....../...@@@..../..........\n"
+    "scenario J ccw from 1 left wall\n"
+    "pieces   J\n"
+    "inputs   LLLLLLDDDDDDA\n"
+    "expect   ..@......./..@......./.@@......./..........\n"
+    "scenario J ccw from 1 right wall\n"
+    "pieces   J\n"
+    "inputs   RRRRRRDDDDDDA\n"
+    "expect   .........@/.........@/........@@/..........\n"
+    "scenario J ccw from 1 floor\n"
+    "pieces   J\n"
+    "inputs   DDDDDDDDDDA\n"
+    "expect   .....#..../.....#..../....##....\n"
+    "scenario J cw from 2 open\n"
+    "pieces   J\n"
+    "inputs   CDDDDDDDD.C\n"
+    "expect   ...@@@..../.....@..../..........\n"
+    "scenario J cw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ...#@@..../....@...../....@...../..........\n"
+    "scenario J cw from 2 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ....##..../....##..../....#...../........../..........\n"
+    "scenario J cw from 2 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ....@@..../....@#..../....@...../..........\n"
+    "scenario J cw from 2 left wall\n"
+    "pieces   J\n"
+    "inputs   CLLLLLLDDDDD.C\n"
+    "expect   @@......../@........./@........./..........\n"
+    "scenario J cw from 2 right wall\n"
+    "pieces   J\n"
+    "inputs   CRRRRRRDDDDD.C\n"
+    "expect   .......@@@/.........@/..........\n"
+    "scenario J cw from 2 floor\n"
+    "pieces   J\n"
+    "inputs   CDDDDDDDDD.C\n"
+    "expect   ...###..../.....#....\n"
+    "scenario J ccw from 2 open\n"
+    "pieces   J\n"
+    "inputs   CDDDDDDDD.A\n"
+    "expect   ...@....../...@@@..../..........\n"
+    "scenario J ccw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ...#@@..../....@...../....@...../..........\n"
+    "scenario J ccw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ....@@..../...#@...../....@...../..........\n"
+    "scenario J ccw from 2 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   J\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ....@@..../....@#..../....@...../..........\n"
+    "scenario J ccw from 2 left wall\n"
+    "pieces   J\n"
+    "inputs   CLLLLLLDDDDD.A\n"
+    "expect   @@......../@........./@........./..........\n"
+    "scenario J ccw from 2 right wall\n"
+    "pieces   J\n"
+    "inputs   CRRRRRRDDDDD.A\n"
+    "expect   .......@../.......@@@/..........\n"
+    "scenario J ccw from 2 floor\n"
+    "pieces   J\n"
+    "inputs   CDDDDDDDDD.A\n"
+    "expect   ...#....../...###....\n"
+    "scenario J cw from 3 open\n"
+    "pieces   J\n"
+    "inputs   CCDDDDDDDDC\n"
+    "expect   .....@..../.....@..../....@@..../..........\n"
+    "scenario J cw from 3 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   .....#..../........../...@@@..../.....@..../..........\n"
+    "scenario J cw from 3 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   J\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   ...###..../....##..../........../..........\n"
+    "scenario J cw from 3 left wall\n"
+    "pieces   J\n"
+    "inputs   CCLLLLLLDDDDDC\n"
+    "expect   ..@......./..@......./.@@......./..........\n"
+    "scenario J cw from 3 right wall\n"
+    "pieces   J\n"
+    "inputs   CCRRRRRRDDDDDC\n"
+    "expect   .........@/.........@/........@@/..........\n"
+    "scenario J cw from 3 floor\n"
+    "pieces   J\n"
+    "inputs   CCDDDDDDDDDC\n"
+    "expect   .....#..../.....#..../....##....\n"
+    "scenario J ccw from 3 open\n"
+    "pieces   J\n"
+    "inputs   CCDDDDDDDDA\n"
+    "expect   ....@@..../....@...../....@...../..........\n"
+    "scenario J ccw from 3 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ....#...../........../...@@@..../.....@..../..........\n"
+    "scenario J ccw from 3 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   J\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../........../...@@@..../.....@..../..........\n"
+    "scenario J ccw from 3 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   J\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ...###..../....##..../........../..........\n"
+    "scenario J ccw from 3 left wall\n"
+    "pieces   J\n"
+    "inputs   CCLLLLLLDDDDDA\n"
+    "expect   .@@......./.@......../.@......../..........\n"
+    "scenario J ccw from 3 right wall\n"
+    "pieces   J\n"
+    "inputs   CCRRRRRRDDDDDA\n"
+    "expect   ........@@/........@./........@./..........\n"
+    "scenario J ccw from 3 floor\n"
+    "pieces   J\n"
+    "inputs   CCDDDDDDDDDA\n"
+    "expect   ....##..../....#...../....#.....\n"
+    "scenario J cw from 4 open\n"
+    "pieces   J\n"
+    "inputs   CCCDDDDDDD.C\n"
+    "expect   ...@....../...@@@..../..........\n"
+    "scenario J cw from 4 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   J\n"
+    "start    3 4 18\n"
+    "inputs   C\n"
+    "expect   ...#.@..../.....@..../....@@..../..........\n"
+    "scenario J cw from 4 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   J\n"
+    "start    3 4 18\n"
+    "inputs   C\n"
+    "expect   .....@..../...#.@..../....@@..../..........\n"
+    "scenario J cw from 4 left wall\n"
+    "pieces   J\n"
+    "inputs   CCCLLLLLLDDDD.C\n"
+    "expect   .@......../.@......../@@......../..........\n"
+    "scenario J cw from 4 right wall\n"
+    "pieces   J\n"
+    "inputs   CCCRRRRRRDDDD.C\n"
+    "expect   .......@../.......@@@/..........\n"
+    "scenario J cw from 4 floor\n"
+    "pieces   J\n"
+    "inputs   CCCDDDDDDDD.C\n"
+    "expect   ...#....../...###....\n"
+    "scenario J ccw from 4 open\n"
+    "pieces   J\n"
+    "inputs   CCCDDDDDDD.A\n"
+    "expect   ...@@@..../.....@..../..........\n"
+    "scenario J ccw from 4 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   J\n"
+    "start    3 4 18\n"
+    "inputs   A\n"
+    "expect   ...#.@..../.....@..../....@@..../..........\n"
+    "scenario J ccw from 4 blocked at 4,19\n"
+    "board    ....#...../........../........../..........\n"
+    "pieces   J\n"
+    "start    3 4 18\n"
+    "inputs   A\n"
+    "expect   ....#@..../.....@..../....@@..../..........\n"
+    "scenario J ccw from 4 left wall\n"
+    "pieces   J\n"
+    "inputs   CCCLLLLLLDDDD.A\n"
+    "expect   .@......../.@......../@@......../..........\n"
+    "scenario J ccw from 4 right wall\n"
+    "pieces   J\n"
+    "inputs   CCCRRRRRRDDDD.A\n"
+    "expect   .......@@@/.........@/..........\n"
+    "scenario J ccw from 4 floor\n"
+    "pieces   J\n"
+    "inputs   CCCDDDDDDDD.A\n"
+    "expect   ...###..../.....#....\n"
+    "scenario L cw from 1 open\n"
+    "pieces   L\n"
+    "inputs   DDDDDDDDDC\n"
+    "expect   ....@...../....@...../....@@..../..........\n"
+    "scenario L cw from 1 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../........../.....@..../...@@@..../..........\n"
+    "scenario L cw from 1 blocked at 4,19\n"
+    "board    ....#...../........../........../..........\n"
+    "pieces   L\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../.....@..../...@@@..../..........\n"
+    "scenario L cw from 1 left wall\n"
+    "pieces   L\n"
+    "inputs   LLLLLLDDDDDDC\n"
+    "expect   .@......../.@......../.@@......./..........\n"
+    "scenario L cw from 1 right wall\n"
+    "pieces   L\n"
+    "inputs   RRRRRRDDDDDDC\n"
+    "expect   ........@./........@./........@@/..........\n"
+    "scenario L cw from 1 floor\n"
+    "pieces   L\n"
+    "inputs   DDDDDDDDDDC\n"
+    "expect   ....#...../....#...../....##....\n"
+    "scenario L ccw from 1 open\n"
+    "pieces   L\n"
+    "inputs   DDDDDDDDDA\n"
+    "expect   ....@@..../.....@..../.....@..../..........\n"
+    "scenario L ccw from 1 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   ....#...../........../.....@..../...@@@..../..........\n"
+    "scenario L ccw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../........../.....@..../...@@@..../..........\n"
+    "scenario L ccw from 1 left wall\n"
+    "pieces   L\n"
+    "inputs   LLLLLLDDDDDDA\n"
+    "expect   .@@......./..@......./..@......./..........\n"
+    "scenario L ccw from 1 right wall\n"
+    "pieces   L\n"
+    "inputs   RRRRRRDDDDDDA\n"
+    "expect   ........@@/.........@/.........@/..........\n"
+    "scenario L ccw from 1 floor\n"
+    "pieces   L\n"
+    "inputs   DDDDDDDDDDA\n"
+    "expect   ....##..../.....#..../.....#....\n"
+    "scenario L cw from 2 open\n"
+    "pieces   L\n"
+    "inputs   CDDDDDDDD.C\n"
+    "expect   ...@@@..../...@....../..........\n"
+    "scenario L cw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   L\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ...#@...../....@...../....@@..../..........\n"
+    "scenario L cw from 2 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   L\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ....@#..../....@...../....@@..../..........\n"
+    "scenario L cw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   L\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ....@...../...#@...../....@@..../..........\n"
+    "scenario L cw from 2 left wall\n"
+    "pieces   L\n"
+    "inputs   CLLLLLLDDDDD.C\n"
+    "expect   @........./@........./@@......../..........\n"
+    "scenario L cw from 2 right wall\n"
+    "pieces   L\n"
+    "inputs   CRRRRRRDDDDD.C\n"
+    "expect   .......@@@/.......@../..........\n"
+    "scenario L cw from 2 floor\n"
+    "pieces   L\n"
+    "inputs   CDDDDDDDDD.C\n"
+    "expect   ...###..../...#......\n"
+    "scenario L ccw from 2 open\n"
+    "pieces   L\n"
+    "inputs   CDDDDDDDD.A\n"
+    "expect   .....@..../...@@@..../..........\n"
+    "scenario L ccw from 2 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   L\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ....@#..../....@...../....@@..../..........\n"
+    "scenario L ccw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   L\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ....@...../...#@...../....@@..../..........\n"
+    "scenario L ccw from 2 left wall\n"
+    "pieces   L\n"
+    "inputs   CLLLLLLDDDDD.A\n"
+    "expect   @........./@........./@@......../..........\n"
+    "scenario L ccw from 2 right wall\n"
+    "pieces   L\n"
+    "inputs   CRRRRRRDDDDD.A\n"
+    "expect   .........@/.......@@@/..........\n"
+    "scenario L ccw from 2 floor\n"
+    "pieces   L\n"
+    "inputs   CDDDDDDDDD.A\n"
+    "expect   .....#..../...###....\n"
+    "scenario L cw from 3 open\n"
+    "pieces   L\n"
+    "inputs   CCDDDDDDDDC\n"
+    "expect   ....@@..../.....@..../.....@..../..........\n"
+    "scenario L cw from 3 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../........../...@@@..../...@....../..........\n"
+    "scenario L cw from 3 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   .....#..../........../...@@@..../...@....../..........\n"
+    "scenario L cw from 3 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   ...###..../...#.#..../........../..........\n"
+    "scenario L cw from 3 left wall\n"
+    "pieces   L\n"
+    "inputs   CCLLLLLLDDDDDC\n"
+    "expect   .@@......./..@......./..@......./..........\n"
+    "scenario L cw from 3 right wall\n"
+    "pieces   L\n"
+    "inputs   CCRRRRRRDDDDDC\n"
+    "expect   ........@@/.........@/.........@/..........\n"
+    "scenario L cw from 3 floor\n"
+    "pieces   L\n"
+    "inputs   CCDDDDDDDDDC\n"
+    "expect   ....##..../.....#..../.....#....\n"
+    "scenario L ccw from 3 open\n"
+    "pieces   L\n"
+    "inputs   CCDDDDDDDDA\n"
+    "expect   ....@...../....@...../....@@..../..........\n"
+    "scenario L ccw from 3 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ....#...../........../...@@@..../...@....../..........\n"
+    "scenario L ccw from 3 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ...###..../...##...../........../..........\n"
+    "scenario L ccw from 3 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   L\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ...###..../...#.#..../........../..........\n"
+    "scenario L ccw from 3 left wall\n"
+    "pieces   L\n"
+    "inputs   CCLLLLLLDDDDDA\n"
+    "expect   .@......../.@......../.@@......./..........\n"
+    "scenario L ccw from 3 right wall\n"
+    "pieces   L\n"
+    "inputs   CCRRRRRRDDDDDA\n"
+    "expect   ........@./........@./........@@/..........\n"
+    "scenario L ccw from 3 floor\n"
+    "pieces   L\n"
+    "inputs   CCDDDDDDDDDA\n"
+    "expect   ....#...../....#...../....##....\n"
+    "scenario L cw from 4 open\n"
+    "pieces   L\n"
+    "inputs   CCCDDDDDDD.C\n"
+    "expect   .....@..../...@@@..../..........\n"
+    "scenario L cw from 4 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   L\n"
+    "start    3 4 18\n"
+    "inputs   C\n"
+    "expect   ....@@..../...#.@..../.....@..../..........\n"
+    "scenario L cw from 4 blocked at 4,20\n"
+    "board    ....#...../........../..........\n"
+    "pieces   L\n"
+    "start    3 4 18\n"
+    "inputs   C\n"
+    "expect   ....@@..../....#@..../.....@..../..........\n"
+    "scenario L cw from 4 left wall\n"
+    "pieces   L\n"
+    "inputs   CCCLLLLLLDDDD.C\n"
+    "expect   @@......../.@......../.@......../..........\n"
+    "scenario L cw from 4 right wall\n"
+    "pieces   L\n"
+    "inputs   CCCRRRRRRDDDD.C\n"
+    "expect   .........@/.......@@@/..........\n"
+    "scenario L cw from 4 floor\n"
+    "pieces   L\n"
+    "inputs   CCCDDDDDDDD.C\n"
+    "expect   .....#..../...###....\n"
+    "scenario L ccw from 4 open\n"
+    "pieces   L\n"
+    "inputs   CCCDDDDDDD.A\n"
+    "expect   ...@@@..../...@....../..........\n"
+    "scenario L ccw from 4 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   L\n"
+    "start    3 4 18\n"
+    "inputs   A\n"
+    "expect   ...#@@..../.....@..../.....@..../..........\n"
+    "scenario L ccw from 4 blocked at 4,19\n"
+    "board    ....#...../........../........../..........\n"
+    "pieces   L\n"
+    "start    3 4 18\n"
+    "inputs   A\n"
+    "expect   ....##..../....##..../.....#..../........../..........\n"
+    "scenario L ccw from 4 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   L\n"
+    "start    3 4 18\n"
+    "inputs   A\n"
+    "expect   ....@@..../...#.@..../.....@..../..........\n"
+    "scenario L ccw from 4 left wall\n"
+    "pieces   L\n"
+    "inputs   CCCLLLLLLDDDD.A\n"
+    "expect   @@......../.@......../.@......../..........\n"
+    "scenario L ccw from 4 right wall\n"
+    "pieces   L\n"
+    "inputs   CCCRRRRRRDDDD.A\n"
+    "expect   .......@@@/.......@../..........\n"
+    "scenario L ccw from 4 floor\n"
+    "pieces   L\n"
+    "inputs   CCCDDDDDDDD.A\n"
+    "expect   ...###..../...#......\n"
+    "scenario O cw from 1 open\n"
+    "pieces   O\n"
+    "inputs   DDDDDDDDD.C\n"
+    "expect   ....@@..../....@@..../..........\n"
+    "scenario O cw from 1 left wall\n"
+    "pieces   O\n"
+    "inputs   LLLLLLDDDDDD.C\n"
+    "expect   @@......../@@......../..........\n"
+    "scenario O cw from 1 right wall\n"
+    "pieces   O\n"
+    "inputs   RRRRRRDDDDDD.C\n"
+    "expect   ........@@/........@@/..........\n"
+    "scenario O cw from 1 floor\n"
+    "pieces   O\n"
+    "inputs   DDDDDDDDDD.C\n"
+    "expect   ....##..../....##....\n"
+    "scenario O ccw from 1 open\n"
+    "pieces   O\n"
+    "inputs   DDDDDDDDD.A\n"
+    "expect   ....@@..../....@@..../..........\n"
+    "scenario O ccw from 1 left wall\n"
+    "pieces   O\n"
+    "inputs   LLLLLLDDDDDD.A\n"
+    "expect   @@......../@@......../..........\n"
+    "scenario O ccw from 1 right wall\n"
+    "pieces   O\n"
+    "inputs   RRRRRRDDDDDD.A\n"
+    "expect   ........@@/........@@/..........\n"
+    "scenario O ccw from 1 floor\n"
+    "pieces   O\n"
+    "inputs   DDDDDDDDDD.A\n"
+    "expect   ....##..../....##....\n"
+    "scenario T cw from 1 open\n"
+    "pieces   T\n"
+    "inputs   DDDDDDDDD.C\n"
+    "expect   ....@...../....@@..../....@.....\n"
+    "scenario T cw from 1 blocked at 4,21\n"
+    "board    ....#...../..........\n"
+    "pieces   T\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../...###..../....#...../..........\n"
+    "scenario T cw from 1 left wall\n"
+    "pieces   T\n"
+    "inputs   LLLLLLDDDDDD.C\n"
+    "expect   .@......../.@@......./.@........\n"
+    "scenario T cw from 1 right wall\n"
+    "pieces   T\n"
+    "inputs   RRRRRRDDDDDD.C\n"
+    "expect   ........@./........@@/........@.\n"
+    // Accepted by CB_BtnRotateCW() before its floor check, moving a cell below the grid
+    "scenario T cw from 1 floor\n"
+    "pieces   T\n"
+    "inputs   DDDDDDDDDD.C\n"
+    "expect   ....#...../...###....\n"
+    "scenario T ccw from 1 open\n"
+    "pieces   T\n"
+    "inputs   DDDDDDDDD.A\n"
+    "expect   ....@...../...@@...../....@.....\n"
+    // Accepted by CB_BtnRotateCCW() before it checked the cell below the center
+    "scenario T ccw from 1 blocked at 4,21\n"
+    "board    ....#...../..........\n"
+    "pieces   T\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   ....#...../...###..../....#...../..........\n"
+    "scenario T ccw from 1 left wall\n"
+    "pieces   T\n"
+    "inputs   LLLLLLDDDDDD.A\n"
+    "expect   .@......../@@......../.@........\n"
+    "scenario T ccw from 1 right wall\n"
+    "pieces   T\n"
+    "inputs   RRRRRRDDDDDD.A\n"
+    "expect   ........@./.......@@./........@.\n"
+    // Accepted by CB_BtnRotateCCW() before its floor check, moving a cell below the grid
+    "scenario T ccw from 1 floor\n"
+    "pieces   T\n"
+    "inputs   DDDDDDDDDD.A\n"
+    "expect   ....#...../...###....\n"
+    "scenario T cw from 2 open\n"
+    "pieces   T\n"
+    "inputs   CDDDDDDDD.C\n"
+    "expect   ...@@@..../....@...../..........\n"
+    "scenario T cw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   T\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ...#@...../....@@..../....@...../..........\n"
+    "scenario T cw from 2 left wall\n"
+    "pieces   T\n"
+    "inputs   CLLLLLLDDDDD.C\n"
+    "expect   @........./@@......../@........./..........\n"
+    "scenario T cw from 2 right wall\n"
+    "pieces   T\n"
+    "inputs   CRRRRRRDDDDD.C\n"
+    "expect   .......@@@/........@./..........\n"
+    "scenario T cw from 2 floor\n"
+    "pieces   T\n"
+    "inputs   CDDDDDDDDD.C\n"
+    "expect   ...###..../....#.....\n"
+    "scenario T ccw from 2 open\n"
+    "pieces   T\n"
+    "inputs   CDDDDDDDD.A\n"
+    "expect   ....@...../...@@@..../........../..........\n"
+    "scenario T ccw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   T\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ...#@...../....@@..../....@...../..........\n"
+    "scenario T ccw from 2 left wall\n"
+    "pieces   T\n"
+    "inputs   CLLLLLLDDDDD.A\n"
+    "expect   @........./@@......../@........./..........\n"
+    "scenario T ccw from 2 right wall\n"
+    "pieces   T\n"
+    "inputs   CRRRRRRDDDDD.A\n"
+    "expect   ........@./.......@@@/........../..........\n"
+    "scenario T ccw from 2 floor\n"
+    "pieces   T\n"
+    "inputs   CDDDDDDDDD.A\n"
+    "expect   ....@...../...@@@....\n"
+    "scenario T cw from 3 open\n"
+    "pieces   T\n"
+    "inputs   CCDDDDDDDDC\n"
+    "expect   ....@...../...@@...../....@...../..........\n"
+    "scenario T cw from 3 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   T\n"
+    "start    2 3 19\n"
+    "inputs   C\n"
+    "expect   ....#...../........../...@@@..../....@...../..........\n"
+    "scenario T cw from 3 left wall\n"
+    "pieces   T\n"
+    "inputs   CCLLLLLLDDDDDC\n"
+    "expect   .@......../@@......../.@......../..........\n"
+    "scenario T cw from 3 right wall\n"
+    "pieces   T\n"
+    "inputs   CCRRRRRRDDDDDC\n"
+    "expect   ........@./.......@@./........@./..........\n"
+    "scenario T cw from 3 floor\n"
+    "pieces   T\n"
+    "inputs   CCDDDDDDDDDC\n"
+    "expect   ....#...../...##...../....#.....\n"
+    "scenario T ccw from 3 open\n"
+    "pieces   T\n"
+    "inputs   CCDDDDDDDDA\n"
+    "expect   ....@...../....@@..../....@...../..........\n"
+    "scenario T ccw from 3 blocked at 4,18\n"
+    "board    ....#...../........../........../........../..........\n"
+    "pieces   T\n"
+    "start    2 3 19\n"
+    "inputs   A\n"
+    "expect   ....#...../........../...@@@..../....@...../..........\n"
+    "scenario T ccw from 3 left wall\n"
+    "pieces   T\n"
+    "inputs   CCLLLLLLDDDDDA\n"
+    "expect   .@......../.@@......./.@......../..........\n"
+    "scenario T ccw from 3 right wall\n"
+    "pieces   T\n"
+    "inputs   CCRRRRRRDDDDDA\n"
+    "expect   ........@./........@@/........@./..........\n"
+    "scenario T ccw from 3 floor\n"
+    "pieces   T\n"
+    "inputs   CCDDDDDDDDDA\n"
+    "expect   ....#...../....##..../....#.....\n"
+    "scenario T cw from 4 open\n"
+    "pieces   T\n"
+    "inputs   CCCDDDDDDD.C\n"
+    "expect   ....@...../...@@@..../........../..........\n"
+    "scenario T cw from 4 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   T\n"
+    "start    3 3 18\n"
+    "inputs   C\n"
+    "expect   ....@#..../...@@...../....@...../..........\n"
+    "scenario T cw from 4 left wall\n"
+    "pieces   T\n"
+    "inputs   CCCLLLLLLDDDD.C\n"
+    "expect   .@......../@@@......./........../..........\n"
+    "scenario T cw from 4 right wall\n"
+    "pieces   T\n"
+    "inputs   CCCRRRRRRDDDD.C\n"
+    "expect   .........@/........@@/.........@/..........\n"
+    "scenario T cw from 4 floor\n"
+    "pieces   T\n"
+    "inputs   CCCDDDDDDDD.C\n"
+    "expect   ....@...../...@@@....\n"
+    "scenario T ccw from 4 open\n"
+    "pieces   T\n"
+    "inputs   CCCDDDDDDD.A\n"
+    "expect   ...@@@..../....@...../..........\n"
+    "scenario T ccw from 4 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   T\n"
+    "start    3 3 18\n"
+    "inputs   A\n"
+    "expect   ....@#..../...@@...../....@...../..........\n"
+    "scenario T ccw from 4 left wall\n"
+    "pieces   T\n"
+    "inputs   CCCLLLLLLDDDD.A\n"
+    "expect   @@@......./.@......../..........\n"
+    "scenario T ccw from 4 right wall\n"
+    "pieces   T\n"
+    "inputs   CCCRRRRRRDDDD.A\n"
+    "expect   .........@/........@@/.........@/..........\n"
+    "scenario T ccw from 4 floor\n"
+    "pieces   T\n"
+    "inputs   CCCDDDDDDDD.A\n"
+    "expect   ...###..../....#.....\n"
+    "scenario S cw from 1 open\n"
+    "pieces   S\n"
+    "inputs   DDDDDDDDDC\n"
+    "expect   ...@....../...@@...../....@...../..........\n"
+    "scenario S cw from 1 blocked at 3,18\n"
+    "board    ...#....../........../........../........../..........\n"
+    "pieces   S\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ...#....../........../....@@..../...@@...../..........\n"
+    "scenario S cw from 1 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   S\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   ...#....../....@@..../...@@...../..........\n"
+    "scenario S cw from 1 left wall\n"
+    "pieces   S\n"
+    "inputs   LLLLLLDDDDDDC\n"
+    "expect   @........./@@......../.@......../..........\n"
+    "scenario S cw from 1 right wall\n"
+    "pieces   S\n"
+    "inputs   RRRRRRDDDDDDC\n"
+    "expect   .......@../.......@@./........@./..........\n"
+    "scenario S cw from 1 floor\n"
+    "pieces   S\n"
+    "inputs   DDDDDDDDDDC\n"
+    "expect   ...#....../...##...../....#.....\n"
+    "scenario S ccw from 1 open\n"
+    "pieces   S\n"
+    "inputs   DDDDDDDDDA\n"
+    "expect   ...@....../...@@...../....@...../..........\n"
+    "scenario S ccw from 1 blocked at 3,18\n"
+    "board    ...#....../........../........../........../..........\n"
+    "pieces   S\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   ...#....../........../....@@..../...@@...../..........\n"
+    "scenario S ccw from 1 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   S\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   ...#....../....@@..../...@@...../..........\n"
+    "scenario S ccw from 1 left wall\n"
+    "pieces   S\n"
+    "inputs   LLLLLLDDDDDDA\n"
+    "expect   @........./@@......../.@......../..........\n"
+    "scenario S ccw from 1 right wall\n"
+    "pieces   S\n"
+    "inputs   RRRRRRDDDDDDA\n"
+    "expect   .......@../.......@@./........@./..........\n"
+    "scenario S ccw from 1 floor\n"
+    "pieces   S\n"
+    "inputs   DDDDDDDDDDA\n"
+    "expect   ...#....../...##...../....#.....\n"
+    "scenario S cw from 2 open\n"
+    "pieces   S\n"
+    "inputs   CDDDDDDDD.C\n"
+    "expect   ....@@..../...@@...../..........\n"
+    "scenario S cw from 2 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   S\n"
+    "start    1 3 18\n"
+    "inputs   C\n"
+    "expect   ...@.#..../...@@...../....@...../..........\n"
+    "scenario S cw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   S\n"
+    "start    1 3 18\n"
+    "inputs   C\n"
+    "expect   ...#....../...##...../...##...../........../..........\n"
+    "scenario S cw from 2 left wall\n"
+    "pieces   S\n"
+    "inputs   CLLLLLLDDDDD.C\n"
+    "expect   .@@......./@@......../..........\n"
+    "scenario S cw from 2 right wall\n"
+    "pieces   S\n"
+    "inputs   CRRRRRRDDDDD.C\n"
+    "expect   ........@./........@@/.........@/..........\n"
+    "scenario S cw from 2 floor\n"
+    "pieces   S\n"
+    "inputs   CDDDDDDDDD.C\n"
+    "expect   ....##..../...##.....\n"
+    "scenario S ccw from 2 open\n"
+    "pieces   S\n"
+    "inputs   CDDDDDDDD.A\n"
+    "expect   ....@@..../...@@...../..........\n"
+    "scenario S ccw from 2 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   S\n"
+    "start    1 3 18\n"
+    "inputs   A\n"
+    "expect   ...@.#..../...@@...../....@...../..........\n"
+    "scenario S ccw from 2 blocked at 3,20\n"
+    "board    ...#....../........../..........\n"
+    "pieces   S\n"
+    "start    1 3 18\n"
+    "inputs   A\n"
+    "expect   ...#....../...##...../...##...../........../..........\n"
+    "scenario S ccw from 2 left wall\n"
+    "pieces   S\n"
+    "inputs   CLLLLLLDDDDD.A\n"
+    "expect   .@@......./@@......../..........\n"
+    "scenario S ccw from 2 right wall\n"
+    "pieces   S\n"
+    "inputs   CRRRRRRDDDDD.A\n"
+    "expect   ........@./........@@/.........@/..........\n"
+    "scenario S ccw from 2 floor\n"
+    "pieces   S\n"
+    "inputs   CDDDDDDDDD.A\n"
+    "expect   ....##..../...##.....\n"
+    "scenario Z cw from 1 open\n"
+    "pieces   Z\n"
+    "inputs   DDDDDDDDDC\n"
+    "expect   .....@..../....@@..../....@...../..........\n"
+    "scenario Z cw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   Z\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   .....#..../........../...@@...../....@@..../..........\n"
+    "scenario Z cw from 1 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   Z\n"
+    "start    0 3 19\n"
+    "inputs   C\n"
+    "expect   .....#..../...@@...../....@@..../..........\n"
+    "scenario Z cw from 1 left wall\n"
+    "pieces   Z\n"
+    "inputs   LLLLLLDDDDDDC\n"
+    "expect   ..@......./.@@......./.@......../..........\n"
+    "scenario Z cw from 1 right wall\n"
+    "pieces   Z\n"
+    "inputs   RRRRRRDDDDDDC\n"
+    "expect   .........@/........@@/........@./..........\n"
+    "scenario Z cw from 1 floor\n"
+    "pieces   Z\n"
+    "inputs   DDDDDDDDDDC\n"
+    "expect   .....#..../....##..../....#.....\n"
+    "scenario Z ccw from 1 open\n"
+    "pieces   Z\n"
+    "inputs   DDDDDDDDDA\n"
+    "expect   .....@..../....@@..../....@...../..........\n"
+    "scenario Z ccw from 1 blocked at 5,18\n"
+    "board    .....#..../........../........../........../..........\n"
+    "pieces   Z\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../........../...@@...../....@@..../..........\n"
+    "scenario Z ccw from 1 blocked at 5,19\n"
+    "board    .....#..../........../........../..........\n"
+    "pieces   Z\n"
+    "start    0 3 19\n"
+    "inputs   A\n"
+    "expect   .....#..../...@@...../....@@..../..........\n"
+    "scenario Z ccw from 1 left wall\n"
+    "pieces   Z\n"
+    "inputs   LLLLLLDDDDDDA\n"
+    "expect   ..@......./.@@......./.@......../..........\n"
+    "scenario Z ccw from 1 right wall\n"
+    "pieces   Z\n"
+    "inputs   RRRRRRDDDDDDA\n"
+    "expect   .........@/........@@/........@./..........\n"
+    "scenario Z ccw from 1 floor\n"
+    "pieces   Z\n"
+    "inputs   DDDDDDDDDDA\n"
+    "expect   .....#..../....##..../....#.....\n"
+    "scenario Z cw from 2 open\n"
+    "pieces   Z\n"
+    "inputs   CDDDDDDDD.C\n"
+    "expect   ...@@...../....@@..../..........\n"
+    "scenario Z cw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   Z\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   ...#.@..../....@@..../....@...../..........\n"
+    "scenario Z cw from 2 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   Z\n"
+    "start    1 4 18\n"
+    "inputs   C\n"
+    "expect   .....#..../....##..../....##..../........../..........\n"
+    "scenario Z cw from 2 left wall\n"
+    "pieces   Z\n"
+    "inputs   CLLLLLLDDDDD.C\n"
+    "expect   .@......../@@......../@........./..........\n"
+    "scenario Z cw from 2 right wall\n"
+    "pieces   Z\n"
+    "inputs   CRRRRRRDDDDD.C\n"
+    "expect   .......@@./........@@/..........\n"
+    "scenario Z cw from 2 floor\n"
+    "pieces   Z\n"
+    "inputs   CDDDDDDDDD.C\n"
+    "expect   ...##...../....##....\n"
+    "scenario Z ccw from 2 open\n"
+    "pieces   Z\n"
+    "inputs   CDDDDDDDD.A\n"
+    "expect   ...@@...../....@@..../..........\n"
+    "scenario Z ccw from 2 blocked at 3,19\n"
+    "board    ...#....../........../........../..........\n"
+    "pieces   Z\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   ...#.@..../....@@..../....@...../..........\n"
+    "scenario Z ccw from 2 blocked at 5,20\n"
+    "board    .....#..../........../..........\n"
+    "pieces   Z\n"
+    "start    1 4 18\n"
+    "inputs   A\n"
+    "expect   .....#..../....##..../....##..../........../..........\n"
+    "scenario Z ccw from 2 left wall\n"
+    "pieces   Z\n"
+    "inputs   CLLLLLLDDDDD.A\n"
+    "expect   .@......../@@......../@........./..........\n"
+    "scenario Z ccw from 2 right wall\n"
+    "pieces   Z\n"
+    "inputs   CRRRRRRDDDDD.A\n"
+    "expect   .......@@./........@@/..........\n"
+    "scenario Z ccw from 2 floor\n"
+    "pieces   Z\n"
+    "inputs   CDDDDDDDDD.A\n"
+    "expect   ...##...../....##....\n";
+
+//==============================================================================
+// Global functions
+
+int ScenarioLoad (const char *path, scenarioData **scenarios, int *num_scenarios, int *error_line)
+{
+    FILE *file = NULL;
+    long length = 0;
+    int status = 0;
+    char *text = NULL;
+
+    *scenarios = NULL;
+    *num_scenarios = 0;
+    *error_line = 0;
+
+    file = fopen (path, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fseek (file, 0, SEEK_END) != 0) || ((length = ftell (file)) < 0) || (fseek (file, 0, SEEK_SET) != 0))
+    {
+        fclose (file);
+        return -1;
+    }
+
+    text = malloc (length + 1);
+    if ((text == NULL) || (fread (text, 1, length, file) != (size_t)length))
+    {
+        free (text);
+        fclose (file);
+        return -1;
+    }
+    text[length] = '\0';
+    fclose (file);
+
+    status = ScenarioParse (text, scenarios, num_scenarios, error_line);
+    free (text);
+
+    return status;
+
+}  // End of ScenarioLoad()
+
+
+int ScenarioParse (const char *text, scenarioData **scenarios, int *num_scenarios, int *error_line)
+{
+    char boardText[BOARD_TEXT_SIZE] = "\0";
+    int capacity = 0;
+    scenarioData *current = NULL;
+    char expectText[BOARD_TEXT_SIZE] = "\0";
+    int ii = 0;  // Loop iterator
+    char keyword[16] = "\0";
+    size_t length = 0;
+    char line[MAX_LINE_SIZE] = "\0";
+    int lineNumber = 0;
+    scenarioData *list = NULL;
+    int numScenarios = 0;
+    scenarioData *resized = NULL;
+    int startLine = 0;
+    int status = 0;
+    const char *value = NULL;
+
+    *scenarios = NULL;
+    *num_scenarios = 0;
+    *error_line = 0;
+
+    while ((status == 0) && (*text != '\0'))
+    {
+        // Next line without the line ending or trailing blanks
+        length = strcspn (text, "\n");
+        lineNumber++;
+        if (length >= sizeof (line))
+        {
+            status = -1;
+            break;
+        }
+        memcpy (line, text, length);
+        line[length] = '\0';
+        text += (text[length] == '\n') ? length + 1 : length;
+
+        while ((length > 0) && isspace ((unsigned char)line[length-1]))
+        {
+            line[--length] = '\0';
+        }
+
+        if ((sscanf (line, "%15s", keyword) != 1) || (keyword[0] == ';'))
+        {
+            continue;
+        }
+        value = strstr (line, keyword) + strlen (keyword);
+        while (isspace ((unsigned char)*value))
+        {
+            value++;
+        }
+
+        if (strcmp (keyword, "scenario") == 0)
+        {
+            if ((current != NULL) && (FinishScenario (current, boardText, expectText) != 0))
+            {
+                lineNumber = startLine;
+                status = -1;
+                break;
+            }
+
+            if (numScenarios == capacity)
+            {
+                capacity = (capacity > 0) ? capacity * 2 : 64;
+                resized = realloc (list, capacity * sizeof (scenarioData));
+                if (resized == NULL)
+                {
+                    status = -1;
+                    break;
+                }
+                list = resized;
+            }
+
+            current = &list[numScenarios++];
+            memset (current, 0, sizeof (scenarioData));
+            current->lines = -1;
+            current->level = -1;
+            strncpy (current->name, value, SCENARIO_MAX_NAME - 1);
+            boardText[0] = '\0';
+            expectText[0] = '\0';
+            startLine = lineNumber;
+        }
+        else if (current == NULL)
+        {
+            status = -1;
+        }
+        else if (strcmp (keyword, "board") == 0)
+        {
+            status = AppendRows (boardText, value);
+        }
+        else if (strcmp (keyword, "expect") == 0)
+        {
+            status = AppendRows (expectText, value);
+        }
+        else if (strcmp (keyword, "pieces") == 0)
+        {
+            length = strlen (current->pieces);
+            for (ii=0; (status == 0) && (value[ii] != '\0'); ii++)
+            {
+                if ((length == SCENARIO_MAX_PIECES) || (PieceTypeIndex (value[ii]) < 0))
+                {
+                    status = -1;
+                }
+                else
+                {
+                    current->pieces[length++] = value[ii];
+                }
+            }
+        }
+        else if (strcmp (keyword, "inputs") == 0)
+        {
+            length = strlen (current->inputs);
+            for (ii=0; (status == 0) && (value[ii] != '\0'); ii++)
+            {
+                if (isspace ((unsigned char)value[ii]))
+                {
+                    continue;
+                }
+
+                if ((length == SCENARIO_MAX_INPUTS) || (strchr (".LRCADH", value[ii]) == NULL))
+                {
+                    status = -1;
+                }
+                else
+                {
+                    current->inputs[length++] = value[ii];
+                }
+            }
+        }
+        else if (strcmp (keyword, "start") == 0)
+        {
+            current->use_start = 1;
+            status = ((sscanf (value, "%d %d %d", &current->start.orientation, &current->start.x,
+                               &current->start.y) == 3) &&
+                      (current->start.orientation >= 0) && (current->start.orientation < NUM_ORIENTATIONS)) ? 0 : -1;
+        }
+        else if (strcmp (keyword, "lines") == 0)
+        {
+            status = ((sscanf (value, "%d", &current->lines) == 1) && (current->lines >= 0)) ? 0 : -1;
+        }
+        else if (strcmp (keyword, "level") == 0)
+        {
+            status = ((sscanf (value, "%d", &current->level) == 1) && (current->level >= 1)) ? 0 : -1;
+        }
+        else
+        {
+            status = -1;
+        }
+    }
+
+    if ((status == 0) && (current != NULL) && (FinishScenario (current, boardText, expectText) != 0))
+    {
+        lineNumber = startLine;
+        status = -1;
+    }
+
+    if (status != 0)
+    {
+        *error_line = lineNumber;
+        free (list);
+        return -1;
+    }
+
+    *scenarios = list;
+    *num_scenarios = numScenarios;
+
+    return 0;
+
+}  // End of ScenarioParse()
+
+
+int ScenarioRun (const scenarioData *scenario, scenarioResult *result)
+{
+    gameData game;
+    int ii = 0;  // Loop iterator
+    int next = 0;
+
+    memset (result, 0, sizeof (scenarioResult));
+    memset (&game, 0, sizeof (gameData));
+
+    game.board = scenario->board;
+    game.level = 1;
+    game.game_status = GAME_RUN;
+    SpawnNextPiece (&game, scenario->pieces, &next);
+
+    if (scenario->use_start)
+    {
+        game.piece.orientation = scenario->start.orientation;
+        game.piece.x = scenario->start.x;
+        game.piece.y = scenario->start.y;
+        game.game_status = PieceFits (&game.board, &game.piece) ? GAME_RUN : GAME_END;
+    }
+
+    for (ii=0; (scenario->inputs[ii] != '\0') && (game.game_status == GAME_RUN); ii++)
+    {
+        StepScenario (&game, scenario->inputs[ii], scenario->pieces, &next);
+    }
+
+    result->ticks = ii;
+    result->stack = game.board;
+    result->lines = game.lines;
+    result->level = game.level;
+    result->game_status = game.game_status;
+
+    // No single block fills a row, so locking it alone just draws its cells
+    if (game.game_status == GAME_RUN)
+    {
+        BoardLockPiece (&result->piece, &game.piece);
+    }
+
+    result->passed = ((scenario->check_board == 0) ||
+                      ((memcmp (&result->stack, &scenario->stack, sizeof (boardData)) == 0) &&
+                       (memcmp (&result->piece, &scenario->piece, sizeof (boardData)) == 0))) &&
+                     ((scenario->lines < 0) || (result->lines == scenario->lines)) &&
+                     ((scenario->level < 0) || (result->level == scenario->level));
+
+    return result->passed;
+
+}  // End of ScenarioRun()
+
+
+int ScenarioRunAll (const scenarioData scenarios[], int num_scenarios, int num_threads, scenarioResult results[])
+{
+    int ii = 0;  // Loop iterator
+    scenarioJob job;
+    int numChunks = (num_scenarios + RUN_CHUNK_SIZE - 1) / RUN_CHUNK_SIZE;
+    CmtThreadPoolHandle pool = 0;
+    int status = 0;
+    void *workerData[SCENARIO_MAX_THREADS] = {NULL};
+
+    memset (&job, 0, sizeof (scenarioJob));
+    job.scenarios = scenarios;
+    job.results = results;
+    job.num_scenarios = num_scenarios;
+
+    if (num_threads <= 0)
+    {
+        num_threads = GetNumProcessors ();
+    }
+    if (num_threads > SCENARIO_MAX_THREADS)
+    {
+        num_threads = SCENARIO_MAX_THREADS;
+    }
+    if (num_threads > numChunks)
+    {
+        num_threads = numChunks;
+    }
+
+    // Small runs are not worth the thread pool
+    if (num_threads <= 1)
+    {
+        ScenarioWorker (&job);
+        return job.failed;
+    }
+
+    if (CmtNewThreadPool (num_threads, &pool) < 0)
+    {
+        return -1;
+    }
+
+    // Every worker takes chunks from the shared job
+    for (ii=0; ii<num_threads; ii++)
+    {
+        workerData[ii] = &job;
+    }
+    status = ThreadPoolRun (pool, ScenarioWorker, workerData, num_threads);
+
+    CmtDiscardThreadPool (pool);
+
+    return (status == 0) ? job.failed : -1;
+
+}  // End of ScenarioRunAll()
+
+
+static int AppendRows (char text[BOARD_TEXT_SIZE], const char *rows)
+{
+    size_t length = strlen (text);
+
+    if (length + strlen (rows) + 2 > BOARD_TEXT_SIZE)
+    {
+        return -1;
+    }
+
+    if (length > 0)
+    {
+        text[length++] = '/';
+    }
+    strcpy (text + length, rows);
+
+    return 0;
+
+}  // End of AppendRows()
+
+
+static int FinishScenario (scenarioData *scenario, const char *board_text, const char *expect_text)
+{
+    int ii = 0;  // Loop iterator
+    char pieceText[BOARD_TEXT_SIZE] = "\0";
+    char stackText[BOARD_TEXT_SIZE] = "\0";
+
+    if ((scenario->pieces[0] == '\0') || (BoardParse (&scenario->board, board_text) != 0))
+    {
+        return -1;
+    }
+
+    if (expect_text[0] == '\0')
+    {
+        return 0;
+    }
+
+    // Split the expected rows into the stack and the active block
+    for (ii=0; expect_text[ii] != '\0'; ii++)
+    {
+        stackText[ii] = (expect_text[ii] == '@') ? '.' : expect_text[ii];
+        pieceText[ii] = (expect_text[ii] == '@') ? '#' : ((expect_text[ii] == '/') ? '/' : '.');
+    }
+    stackText[ii] = '\0';
+    pieceText[ii] = '\0';
+
+    if ((BoardParse (&scenario->stack, stackText) != 0) || (BoardParse (&scenario->piece, pieceText) != 0))
+    {
+        return -1;
+    }
+    scenario->check_board = 1;
+
+    return 0;
+
+}  // End of FinishScenario()
+
+
+static int CVICALLBACK ScenarioWorker (void *functionData)
+{
+    int chunk = 0;
+    int ii = 0;  // Loop iterator
+    scenarioJob *job = (scenarioJob *)functionData;
+
+    for (chunk=InterlockedIncrement (&job->next_chunk) - 1; chunk * RUN_CHUNK_SIZE < job->num_scenarios;
+         chunk=InterlockedIncrement (&job->next_chunk) - 1)
+    {
+        for (ii=chunk*RUN_CHUNK_SIZE; (ii < (chunk + 1) * RUN_CHUNK_SIZE) && (ii < job->num_scenarios); ii++)
+        {
+            if (ScenarioRun (&job->scenarios[ii], &job->results[ii]) == 0)
+            {
+                InterlockedIncrement (&job->failed);
+            }
+        }
+    }
+
+    return 0;
+
+}  // End of ScenarioWorker()
+
+
+static void SpawnNextPiece (gameData *game, const char *pieces, int *next)
+{
+    int numLineClears = 0;
+
+    // Lock the active block, except before the first one
+    if (*next > 0)
+    {
+        numLineClears = BoardLockPiece (&game->board, &game->piece);
+
+        // Same level progression as GamePlace()
+        game->lines += numLineClears;
+        game->level = (game->lines / 10) + 1;
+    }
+
+    // Stop once the blocks run out
+    if (pieces[*next] == '\0')
+    {
+        game->game_status = GAME_END;
+        return;
+    }
+
+    PieceSpawn (PieceTypeIndex (pieces[*next]), &game->piece);
+    game->pieces++;
+    (*next)++;
+
+    if (PieceFits (&game->board, &game->piece) == 0)
+    {
+        game->game_status = GAME_END;
+    }
+
+}  // End of SpawnNextPiece()
+
+
+static void StepScenario (gameData *game, char input, const char *pieces, int *next)
+{
+    switch (input)
+    {
+        case SCENARIO_INPUT_LEFT:
+            PieceMove (&game->board, &game->piece, -1, 0);
+            break;
+        case SCENARIO_INPUT_RIGHT:
+            PieceMove (&game->board, &game->piece, 1, 0);
+            break;
+        case SCENARIO_INPUT_CW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CW);
+            break;
+        case SCENARIO_INPUT_CCW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CCW);
+            break;
+        case SCENARIO_INPUT_DOWN:
+            PieceMove (&game->board, &game->piece, 0, 1);
+            break;
+        case SCENARIO_INPUT_DROP:
+            game->piece.y += PieceDropDistance (&game->board, &game->piece);
+            SpawnNextPiece (game, pieces, next);
+            return;
+    }
+
+    // Gravity, the block locks where it is once it cannot fall
+    if (PieceMove (&game->board, &game->piece, 0, 1) == 0)
+    {
+        SpawnNextPiece (game, pieces, next);
+    }
+
+}  // End of StepScenario()
@@ -0,0 +1,89 @@
+//==============================================================================
+//
+// Title:       blockdrop_scenario.h
+// Purpose:     Scripted game scenarios run on the headless engine.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_scenario_H__
+#define __blockdrop_scenario_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define SCENARIO_MAX_NAME       48
+#define SCENARIO_MAX_PIECES     32
+#define SCENARIO_MAX_INPUTS     256
+#define SCENARIO_MAX_THREADS    64
+
+// Inputs, one per tick. Every input but SCENARIO_INPUT_DROP is followed by
+// gravity moving the block down one row, or locking it when it cannot fall.
+#define SCENARIO_INPUT_NONE     '.'
+#define SCENARIO_INPUT_LEFT     'L'
+#define SCENARIO_INPUT_RIGHT    'R'
+#define SCENARIO_INPUT_CW       'C'
+#define SCENARIO_INPUT_CCW      'A'
+#define SCENARIO_INPUT_DOWN     'D'
+#define SCENARIO_INPUT_DROP     'H'     // Hard drop and lock
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    char name[SCENARIO_MAX_NAME];
+    boardData board;                        // Stack before the first block
+    char pieces[SCENARIO_MAX_PIECES + 1];   // Blocks in order, e.g. "IJL"
+    int use_start;                          // Nonzero when the first block starts at start
+    placementData start;                    // Instead of the spawn position
+    char inputs[SCENARIO_MAX_INPUTS + 1];   // SCENARIO_INPUT_ per tick
+    int check_board;                        // Nonzero when stack and piece are compared
+    boardData stack;                        // Expected stack after the last tick
+    boardData piece;                        // Expected cells of the active block
+    int lines;                              // Expected lines, -1 when not compared
+    int level;                              // Expected level, -1 when not compared
+} scenarioData;
+
+typedef struct
+{
+    int passed;
+    int ticks;                              // Inputs used before the blocks ran out or the game ended
+    boardData stack;
+    boardData piece;                        // Cells of the active block, empty when there is none
+    int lines;
+    int level;
+    int game_status;
+} scenarioResult;
+
+//==============================================================================
+// External variables
+
+extern const char g_rotationScenarios[];
+
+//==============================================================================
+// Global functions
+
+int ScenarioLoad (const char *path, scenarioData **scenarios, int *num_scenarios, int *error_line);
+
+int ScenarioParse (const char *text, scenarioData **scenarios, int *num_scenarios, int *error_line);
+
+int ScenarioRun (const scenarioData *scenario, scenarioResult *result);
+
+int ScenarioRunAll (const scenarioData scenarios[], int num_scenarios, int num_threads, scenarioResult results[]);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_scenario_H__ */
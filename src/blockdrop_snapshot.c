@@ -0,0 +1,369 @@
+//==============================================================================
+//
+// Title:       blockdrop_snapshot.c
+// Purpose:     Binary snapshots of a running game with background autosave.
+//
+//              A snapshotData holds everything needed to continue a game in
+//              under 400 bytes: the locked cells as row masks and block types,
+//              the active block in packed form, the block generator, counters
+//              and the drop timer interval. The game keeps its snapshot up to
+//              date as blocks lock, so taking one is a memory copy.
+//
+//              A snapshotWriter owns one thread that saves the newest snapshot
+//              every few seconds when it has changed. Each save writes a new
+//              file next to the old one and moves it over the old one in a
+//              single step, so a crash during a save keeps the previous one.
+//              The game never waits for the disk: SnapshotWriterUpdate() and
+//              the thread only hold the lock to copy the snapshot.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_snapshot.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+struct snapshotWriter
+{
+    char path[MAX_PATHNAME_LEN];
+    double period;                      // Seconds
+    CmtThreadLockHandle lock;           // Guards latest and sequence
+    CmtThreadPoolHandle pool;           // One thread that writes the file
+    CmtThreadFunctionID write_id;
+    HANDLE stop_event;
+    snapshotData latest;
+    unsigned int sequence;              // Updates so far
+    int status;                         // First write error
+
+    // Only used by the thread that writes
+    snapshotData saved;
+    unsigned int saved_sequence;
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static unsigned int Checksum (const snapshotData *snapshot);
+
+static int CVICALLBACK WriterThread (void *functionData);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int SnapshotLockBlock (snapshotData *snapshot, const blockData *block)
+{
+    int ii = 0;  // Loop iterator
+    int numLineClears = 0;
+    packedPiece packed = g_noPiece;
+    int row = GRID_NUM_ROWS - 1;
+    int x = 0;
+    int y = 0;
+
+    if (BlockPack (block, &packed) != 0)
+    {
+        return -1;
+    }
+
+    // Reject the whole block before changing anything if a cell is off the grid
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        if ((block->position[ii].x < 1) || (block->position[ii].x > GRID_NUM_COLS) ||
+            (block->position[ii].y < 1) || (block->position[ii].y > GRID_NUM_ROWS))
+        {
+            return -1;
+        }
+    }
+
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        x = block->position[ii].x - 1;
+        y = block->position[ii].y - 1;
+        snapshot->board.rows[y] |= (unsigned short)(1 << x);
+        snapshot->cells[y][x] = (unsigned char)(packed.type_index + 1);
+    }
+
+    // Same as CheckForLineClears(), the rows above a full row drop down
+    for (ii=GRID_NUM_ROWS-1; ii>=0; ii--)
+    {
+        if (snapshot->board.rows[ii] == FULL_ROW_MASK)
+        {
+            numLineClears++;
+            continue;
+        }
+
+        if (row != ii)
+        {
+            snapshot->board.rows[row] = snapshot->board.rows[ii];
+            memcpy (snapshot->cells[row], snapshot->cells[ii], GRID_NUM_COLS);
+        }
+        row--;
+    }
+
+    for (ii=row; ii>=0; ii--)
+    {
+        snapshot->board.rows[ii] = 0;
+        memset (snapshot->cells[ii], 0, GRID_NUM_COLS);
+    }
+
+    snapshot->lines += numLineClears;
+    snapshot->level = (snapshot->lines / 10) + 1;
+    snapshot->pieces++;
+
+    return numLineClears;
+
+}  // End of SnapshotLockBlock()
+
+
+int SnapshotRead (const char *path, snapshotData *snapshot)
+{
+    FILE *file = NULL;
+    size_t numRead = 0;
+
+    memset (snapshot, 0, sizeof (snapshotData));
+
+    file = fopen (path, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    numRead = fread (snapshot, sizeof (snapshotData), 1, file);
+    fclose (file);
+
+    if ((numRead != 1) || (snapshot->magic != SNAPSHOT_MAGIC) || (snapshot->version != SNAPSHOT_VERSION) ||
+        (snapshot->size != sizeof (snapshotData)) || (snapshot->checksum != Checksum (snapshot)))
+    {
+        memset (snapshot, 0, sizeof (snapshotData));
+        return -1;
+    }
+
+    return 0;
+
+}  // End of SnapshotRead()
+
+
+void SnapshotReset (snapshotData *snapshot)
+{
+    memset (snapshot, 0, sizeof (snapshotData));
+
+    snapshot->magic = SNAPSHOT_MAGIC;
+    snapshot->version = SNAPSHOT_VERSION;
+    snapshot->size = sizeof (snapshotData);
+    snapshot->piece = g_noPiece;
+    snapshot->game_status = GAME_RUN;
+    snapshot->level = 1;
+
+}  // End of SnapshotReset()
+
+
+int SnapshotWrite (const char *path, const snapshotData *snapshot)
+{
+    FILE *file = NULL;
+    snapshotData header = *snapshot;
+    char tempPath[MAX_PATHNAME_LEN] = "\0";
+
+    if (strlen (path) + 5 > sizeof (tempPath))
+    {
+        return -1;
+    }
+    sprintf (tempPath, "%s.tmp", path);
+
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.size = sizeof (snapshotData);
+    header.checksum = Checksum (&header);
+
+    file = fopen (tempPath, "wb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if (fwrite (&header, sizeof (snapshotData), 1, file) != 1)
+    {
+        fclose (file);
+        return -1;
+    }
+
+    if (fclose (file) != 0)
+    {
+        return -1;
+    }
+
+    // Replaces the old file in one step, there is no moment without a save
+    return MoveFileEx (tempPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+
+}  // End of SnapshotWrite()
+
+
+int SnapshotWriterClose (snapshotWriter *writer)
+{
+    int status = 0;
+
+    if (writer == NULL)
+    {
+        return 0;
+    }
+
+    // The thread saves the newest snapshot once more before it returns
+    if (writer->write_id != 0)
+    {
+        SetEvent (writer->stop_event);
+        CmtWaitForThreadPoolFunctionCompletion (writer->pool, writer->write_id, 0);
+        CmtReleaseThreadPoolFunctionID (writer->pool, writer->write_id);
+    }
+
+    if (writer->pool != 0)
+    {
+        CmtDiscardThreadPool (writer->pool);
+    }
+    if (writer->stop_event != NULL)
+    {
+        CloseHandle (writer->stop_event);
+    }
+    if (writer->lock != 0)
+    {
+        CmtDiscardLock (writer->lock);
+    }
+
+    status = writer->status;
+    free (writer);
+
+    return status;
+
+}  // End of SnapshotWriterClose()
+
+
+int SnapshotWriterOpen (const char *path, double period, snapshotWriter **writer)
+{
+    snapshotWriter *newWriter = NULL;
+
+    *writer = NULL;
+
+    if ((period <= 0.0) || (strlen (path) + 5 > MAX_PATHNAME_LEN))
+    {
+        return -1;
+    }
+
+    newWriter = calloc (1, sizeof (snapshotWriter));
+    if (newWriter == NULL)
+    {
+        return -1;
+    }
+
+    strcpy (newWriter->path, path);
+    newWriter->period = period;
+
+    if (CmtNewLock (NULL, 0, &newWriter->lock) < 0)
+    {
+        newWriter->lock = 0;
+        SnapshotWriterClose (newWriter);
+        return -1;
+    }
+
+    newWriter->stop_event = CreateEvent (NULL, TRUE, FALSE, NULL);
+    if (newWriter->stop_event == NULL)
+    {
+        SnapshotWriterClose (newWriter);
+        return -1;
+    }
+
+    if (CmtNewThreadPool (1, &newWriter->pool) < 0)
+    {
+        newWriter->pool = 0;
+        SnapshotWriterClose (newWriter);
+        return -1;
+    }
+
+    if (CmtScheduleThreadPoolFunction (newWriter->pool, WriterThread, newWriter, &newWriter->write_id) < 0)
+    {
+        newWriter->write_id = 0;
+        SnapshotWriterClose (newWriter);
+        return -1;
+    }
+
+    *writer = newWriter;
+
+    return 0;
+
+}  // End of SnapshotWriterOpen()
+
+
+int SnapshotWriterUpdate (snapshotWriter *writer, const snapshotData *snapshot)
+{
+    int gotLock = 0;
+
+    // The thread only holds the lock to copy the snapshot, never while it writes
+    CmtGetLockEx (writer->lock, 0, CMT_WAIT_FOREVER, &gotLock);
+
+    writer->latest = *snapshot;
+    writer->sequence++;
+
+    CmtReleaseLock (writer->lock);
+
+    return writer->status;
+
+}  // End of SnapshotWriterUpdate()
+
+
+static unsigned int Checksum (const snapshotData *snapshot)
+{
+    const unsigned char *bytes = (const unsigned char *)snapshot;
+    unsigned int hash = 2166136261u;
+    size_t ii = 0;  // Loop iterator
+
+    // FNV-1a of everything after the checksum
+    for (ii=offsetof (snapshotData, board); ii<sizeof (snapshotData); ii++)
+    {
+        hash = (hash ^ bytes[ii]) * 16777619u;
+    }
+
+    return hash;
+
+}  // End of Checksum()
+
+
+static int CVICALLBACK WriterThread (void *functionData)
+{
+    snapshotWriter *writer = (snapshotWriter *)functionData;
+    int changed = 0;
+    int gotLock = 0;
+    int stop = 0;
+
+    while (stop == 0)
+    {
+        stop = (WaitForSingleObject (writer->stop_event, (DWORD)(writer->period * 1000.0)) == WAIT_OBJECT_0);
+
+        CmtGetLockEx (writer->lock, 0, CMT_WAIT_FOREVER, &gotLock);
+        changed = (writer->sequence != writer->saved_sequence);
+        if (changed)
+        {
+            writer->saved = writer->latest;
+            writer->saved_sequence = writer->sequence;
+        }
+        CmtReleaseLock (writer->lock);
+
+        // The disk is written without the lock
+        if (changed && (SnapshotWrite (writer->path, &writer->saved) != 0))
+        {
+            writer->status = -1;
+        }
+    }
+
+    return 0;
+
+}  // End of WriterThread()
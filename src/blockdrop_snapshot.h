@@ -0,0 +1,77 @@
+//==============================================================================
+//
+// Title:       blockdrop_snapshot.h
+// Purpose:     Binary snapshots of a running game with background autosave.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_snapshot_H__
+#define __blockdrop_snapshot_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_piece.h"
+
+//==============================================================================
+// Constants
+
+#define SNAPSHOT_MAGIC          0x53534442  // "BDSS"
+#define SNAPSHOT_VERSION        1
+#define SNAPSHOT_DEFAULT_FILE   "autosave.bss"
+#define SNAPSHOT_DEFAULT_PERIOD 3.0         // Seconds between autosaves
+
+//==============================================================================
+// Types
+
+// Little endian, written to disk as is
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int size;                                  // sizeof (snapshotData)
+    unsigned int checksum;                              // Of the bytes after it
+    boardData board;                                    // Locked cells, the active block is not included
+    unsigned char cells[GRID_NUM_ROWS][GRID_NUM_COLS];  // Block type index + 1 of each locked cell, 0 when empty
+    packedPiece piece;                                  // Active block
+    rngData rng;                                        // Generator of the next blocks
+    int game_status;                                    // GAME_RUN or GAME_END
+    int level;
+    int lines;
+    int pieces;                                         // Blocks locked
+    double speed;                                       // Drop timer interval, seconds
+} snapshotData;
+
+typedef struct snapshotWriter snapshotWriter;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int SnapshotLockBlock (snapshotData *snapshot, const blockData *block);
+
+int SnapshotRead (const char *path, snapshotData *snapshot);
+
+void SnapshotReset (snapshotData *snapshot);
+
+int SnapshotWrite (const char *path, const snapshotData *snapshot);
+
+int SnapshotWriterClose (snapshotWriter *writer);
+
+int SnapshotWriterOpen (const char *path, double period, snapshotWriter **writer);
+
+int SnapshotWriterUpdate (snapshotWriter *writer, const snapshotData *snapshot);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_snapshot_H__ */
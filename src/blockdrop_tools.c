@@ -0,0 +1,1690 @@
+//==============================================================================
+//
+// Title:       blockdrop_tools.c
+// Purpose:     Command line tools built on the headless block drop engine.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_bench.h"
+#include "blockdrop_dataset.h"
+#include "blockdrop_finesse.h"
+#include "blockdrop_fuzz.h"
+#include "blockdrop_journal.h"
+#include "blockdrop_metrics.h"
+#include "blockdrop_neural.h"
+#include "blockdrop_perfect.h"
+#include "blockdrop_perft.h"
+#include "blockdrop_puzzle.h"
+#include "blockdrop_regress.h"
+#include "blockdrop_ring.h"
+#include "blockdrop_scenario.h"
+#include "blockdrop_tuner.h"
+#include "blockdrop_variant.h"
+#include "blockdrop_vecenv.h"
+
+//==============================================================================
+// Constants
+
+#define FUZZ_MAX_INPUT_BYTES    1024
+#define JOURNAL_CHECK_GAMES     20
+#define MAX_FILE_TEXT           4096
+#define MAX_LINE_TEXT           1024
+#define NEURAL_BENCH_BOARDS     4096
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int CheckRecord (const datasetRecord *record, void *data);
+
+static void PrintScenarioFailure (const scenarioData *scenario, const scenarioResult *result);
+
+static int ReadBoardFile (const char *path, boardData *board);
+
+static int RunBench (int argc, char *argv[]);
+
+static int RunDataset (int argc, char *argv[]);
+
+static int RunDatasetCheck (const char *path);
+
+static int RunFinesse (int argc, char *argv[]);
+
+static int RunFinesseTable (void);
+
+static int RunFuzz (int argc, char *argv[]);
+
+static int RunJournalCheck (void);
+
+static int RunMetrics (int argc, char *argv[]);
+
+static int RunNeural (int argc, char *argv[]);
+
+static int RunNeuralBench (const neuralNet *net);
+
+static int RunPerfect (int argc, char *argv[]);
+
+static int RunPerfectBench (int num_games, int num_preview);
+
+static int RunPerft (int argc, char *argv[]);
+
+static int RunPerftCheck (void);
+
+static int RunPuzzle (int argc, char *argv[]);
+
+static int RunPuzzleCheck (void);
+
+static int RunRegress (int argc, char *argv[]);
+
+static int RunRing (int argc, char *argv[]);
+
+static int RunRingConsumer (const char *name);
+
+static int RunRingProducer (const char *name, int num_envs, int num_batches);
+
+static int RunScenario (int argc, char *argv[]);
+
+static int RunTune (int argc, char *argv[]);
+
+static int RunVariant (int argc, char *argv[]);
+
+static int RunVecEnv (int argc, char *argv[]);
+
+static void ShowUsage (void);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int main (int argc, char *argv[])
+{
+    if (InitCVIRTE (0, argv, 0) == 0)
+    {
+        return -1;    /* out of memory */
+    }
+
+    if (argc < 2)
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (strcmp (argv[1], "bench") == 0)
+    {
+        return RunBench (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "dataset") == 0)
+    {
+        return RunDataset (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "finesse") == 0)
+    {
+        return RunFinesse (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "fuzz") == 0)
+    {
+        return RunFuzz (argc - 2, argv + 2);
+    }
+
+    if ((argc == 3) && (strcmp (argv[1], "journal") == 0) && (strcmp (argv[2], "check") == 0))
+    {
+        return RunJournalCheck ();
+    }
+
+    if (strcmp (argv[1], "metrics") == 0)
+    {
+        return RunMetrics (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "neural") == 0)
+    {
+        return RunNeural (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "perfect") == 0)
+    {
+        return RunPerfect (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "perft") == 0)
+    {
+        return RunPerft (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "puzzle") == 0)
+    {
+        return RunPuzzle (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "regress") == 0)
+    {
+        return RunRegress (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "ring") == 0)
+    {
+        return RunRing (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "scenario") == 0)
+    {
+        return RunScenario (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "tune") == 0)
+    {
+        return RunTune (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "variant") == 0)
+    {
+        return RunVariant (argc - 2, argv + 2);
+    }
+
+    if (strcmp (argv[1], "vecenv") == 0)
+    {
+        return RunVecEnv (argc - 2, argv + 2);
+    }
+
+    ShowUsage ();
+
+    return -1;
+
+}  // End of main()
+
+
+static int CheckRecord (const datasetRecord *record, void *data)
+{
+    long long *totals = (long long *)data;  // Records, invalid records, lines, outcome
+    boardData board = {0};
+    int lines = 0;
+    int outcome = 0;
+    pieceData placed = {0};
+
+    totals[0]++;
+    if (DatasetUnpackRecord (record, &board, &placed, &lines, &outcome) != 0)
+    {
+        totals[1]++;
+        return 0;
+    }
+
+    totals[2] += lines;
+    totals[3] += outcome;
+
+    return 0;
+
+}  // End of CheckRecord()
+
+
+static void PrintScenarioFailure (const scenarioData *scenario, const scenarioResult *result)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    char expected[GRID_NUM_COLS + 1] = "\0";
+    char got[GRID_NUM_COLS + 1] = "\0";
+
+    printf ("FAIL %s: %d ticks, lines %d, level %d\n", scenario->name, result->ticks, result->lines, result->level);
+
+    if (scenario->check_board == 0)
+    {
+        return;
+    }
+
+    // Expected and actual rows side by side, the active block as '@'
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        if ((scenario->stack.rows[ii] | scenario->piece.rows[ii] | result->stack.rows[ii] |
+             result->piece.rows[ii]) == 0)
+        {
+            continue;
+        }
+
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            expected[jj] = (scenario->piece.rows[ii] & (1 << jj)) ? '@' :
+                           ((scenario->stack.rows[ii] & (1 << jj)) ? '#' : '.');
+            got[jj] = (result->piece.rows[ii] & (1 << jj)) ? '@' : ((result->stack.rows[ii] & (1 << jj)) ? '#' : '.');
+        }
+        printf ("  %2d  %s  %s\n", ii, expected, got);
+    }
+
+}  // End of PrintScenarioFailure()
+
+
+static int ReadBoardFile (const char *path, boardData *board)
+{
+    FILE *file = NULL;
+    size_t length = 0;
+    char text[MAX_FILE_TEXT] = "\0";
+
+    file = fopen (path, "r");
+    if (file == NULL)
+    {
+        printf ("Unable to open %s\n", path);
+        return -1;
+    }
+
+    length = fread (text, 1, sizeof (text) - 1, file);
+    text[length] = '\0';
+    fclose (file);
+
+    if (BoardParse (board, text) != 0)
+    {
+        printf ("Invalid board in %s\n", path);
+        return -1;
+    }
+
+    return 0;
+
+}  // End of ReadBoardFile()
+
+
+static int RunBench (int argc, char *argv[])
+{
+    benchConfig config;
+    int ii = 0;  // Loop iterator
+    int numResults = 0;
+    benchResult *results = NULL;
+
+    if (argc > 3)
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    BenchDefaultConfig (&config);
+    if (argc >= 2)
+    {
+        config.num_samples = atoi (argv[1]);
+    }
+    if (argc == 3)
+    {
+        config.cpu = atoi (argv[2]);
+    }
+
+    results = calloc (BENCH_MAX_RESULTS, sizeof (benchResult));
+    if (results == NULL)
+    {
+        return -1;
+    }
+
+    numResults = BenchRunAll (&config, results, BENCH_MAX_RESULTS);
+    if (numResults < 0)
+    {
+        printf ("Invalid benchmark settings\n");
+        free (results);
+        return -1;
+    }
+
+    printf ("%-20s %12s %10s %10s %10s %10s\n", "benchmark", "iterations", "median ns", "p99 ns", "iqr ns",
+            "cycles");
+    for (ii=0; ii<numResults; ii++)
+    {
+        printf ("%-20s %12lld %10.2f %10.2f %10.2f %10.1f\n", results[ii].name, results[ii].iterations,
+                results[ii].median_ns, results[ii].p99_ns, results[ii].iqr_ns, results[ii].median_cycles);
+    }
+
+    if ((argc >= 1) && (BenchWriteJson (argv[0], &config, results, numResults) != 0))
+    {
+        printf ("Unable to write %s\n", argv[0]);
+        free (results);
+        return -1;
+    }
+
+    free (results);
+
+    return 0;
+
+}  // End of RunBench()
+
+
+static int RunDataset (int argc, char *argv[])
+{
+    datasetConfig config;
+    int ii = 0;  // Loop iterator
+    datasetStats stats;
+
+    if ((argc == 2) && (strcmp (argv[0], "check") == 0))
+    {
+        return RunDatasetCheck (argv[1]);
+    }
+
+    if (argc < 2)
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    DatasetDefaultConfig (&config);
+    config.prefix = argv[0];
+    config.num_games = atoi (argv[1]);
+    for (ii=2; ii<argc; ii++)
+    {
+        if (strcmp (argv[ii], "random") == 0)
+        {
+            config.policy = DATASET_POLICY_RANDOM;
+        }
+        else if (strcmp (argv[ii], "compress") == 0)
+        {
+            config.flags |= DATASET_COMPRESSED;
+        }
+    }
+
+    if (DatasetGenerate (&config, &stats) != 0)
+    {
+        printf ("Unable to write the shards for %s\n", config.prefix);
+        return -1;
+    }
+
+    printf ("%lld games, %lld records, %d shards, %.1f MB (%.1f bytes per record)\n", stats.games,
+            stats.records, stats.shards, stats.bytes / 1e6,
+            (stats.records > 0) ? (double)stats.bytes / stats.records : 0.0);
+    printf ("%.3f s, %.0f records/s, %.1f MB/s\n", stats.seconds,
+            (stats.seconds > 0.0) ? stats.records / stats.seconds : 0.0,
+            (stats.seconds > 0.0) ? stats.bytes / stats.seconds / 1e6 : 0.0);
+
+    return 0;
+
+}  // End of RunDataset()
+
+
+static int RunDatasetCheck (const char *path)
+{
+    long long totals[4] = {0};
+
+    if (DatasetReadShard (path, CheckRecord, totals) < 0)
+    {
+        printf ("Unable to read %s\n", path);
+        return -1;
+    }
+
+    printf ("%lld records, %lld invalid, %.3f lines per record, %.1f mean outcome\n", totals[0], totals[1],
+            (totals[0] > 0) ? (double)totals[2] / totals[0] : 0.0,
+            (totals[0] > 0) ? (double)totals[3] / totals[0] : 0.0);
+
+    return (totals[1] == 0) ? 0 : -1;
+
+}  // End of RunDatasetCheck()
+
+
+static int RunFinesse (int argc, char *argv[])
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    char line[MAX_LINE_TEXT] = "\0";
+    double seconds = 0.0;
+    double start = 0.0;
+    finesseStats stats;
+
+    if (argc < 1)
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (FinesseBuildTable () != 0)
+    {
+        printf ("Unable to build the finesse table\n");
+        return -1;
+    }
+
+    if ((argc == 1) && (strcmp (argv[0], "table") == 0))
+    {
+        return RunFinesseTable ();
+    }
+
+    FinesseReset (&stats);
+    start = Timer ();
+
+    // Stream every replay file one line at a time
+    for (ii=0; ii<argc; ii++)
+    {
+        file = fopen (argv[ii], "r");
+        if (file == NULL)
+        {
+            printf ("Unable to open %s\n", argv[ii]);
+            return -1;
+        }
+
+        while (fgets (line, sizeof (line), file) != NULL)
+        {
+            FinesseAnalyzeLine (&stats, line);
+        }
+        fclose (file);
+
+        // Replays do not continue across files
+        FinesseAnalyzeLine (&stats, "");
+    }
+
+    seconds = Timer () - start;
+
+    printf ("%lld replays, %lld pieces, %lld errors\n", stats.replays, stats.pieces, stats.errors);
+    printf ("%lld presses, %lld minimum, %lld wasted (%.1f%%)\n", stats.presses, stats.minimum,
+            stats.presses - stats.minimum,
+            (stats.presses > 0) ? 100.0 * (stats.presses - stats.minimum) / stats.presses : 0.0);
+    printf ("%lld pieces with wasted presses (%.1f%%), %lld needed a search\n", stats.faults,
+            (stats.pieces > 0) ? 100.0 * stats.faults / stats.pieces : 0.0, stats.searches);
+    printf ("%.3f s, %.0f replays/s, %.0f pieces/s\n", seconds,
+            (seconds > 0.0) ? stats.replays / seconds : 0.0, (seconds > 0.0) ? stats.pieces / seconds : 0.0);
+
+    return (stats.errors == 0) ? 0 : -1;
+
+}  // End of RunFinesse()
+
+
+static int RunFinesseTable (void)
+{
+    const finesseEntry *entry = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+
+    // One line per block type and orientation, one column per grid column
+    for (ii=0; ii<NUM_BLOCKS_TYPES; ii++)
+    {
+        for (jj=0; jj<NUM_ORIENTATIONS; jj++)
+        {
+            if (g_finesseTable[ii][jj][0].presses < 0)
+            {
+                continue;
+            }
+
+            printf ("%c%d", PieceBlockType (ii), jj);
+            for (kk=0; kk<GRID_NUM_COLS; kk++)
+            {
+                entry = &g_finesseTable[ii][jj][kk];
+                printf (" %-6s", (entry->presses < 0) ? "-" : (entry->presses == 0) ? "." : entry->inputs);
+            }
+            printf ("\n");
+        }
+    }
+
+    return 0;
+
+}  // End of RunFinesseTable()
+
+
+static int RunFuzz (int argc, char *argv[])
+{
+    unsigned char data[FUZZ_SEED_SIZE + FUZZ_MAX_INPUT_BYTES];
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    char line[GRID_NUM_COLS + 1] = "\0";
+    int numIterations = 0;
+    const char *path = "fuzz_failure.txt";
+    fuzzReport report;
+    rngData rng;
+    double seconds = 0.0;
+    size_t size = 0;
+    long long totalTicks = 0;
+
+    if ((argc < 1) || (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    numIterations = atoi (argv[0]);
+    RngSeed (&rng, (argc >= 2) ? strtoull (argv[1], NULL, 10) : (unsigned long long)time (NULL));
+    if (argc == 3)
+    {
+        path = argv[2];
+    }
+
+    // Random seeds and input streams of random length
+    seconds = Timer ();
+    for (ii=0; ii<numIterations; ii++)
+    {
+        size = FUZZ_SEED_SIZE + RngRange (&rng, FUZZ_MAX_INPUT_BYTES);
+        for (jj=0; jj<(int)size; jj++)
+        {
+            data[jj] = (unsigned char)RngNext (&rng);
+        }
+
+        if (FuzzCompare (data, size, &report) == 0)
+        {
+            break;
+        }
+        totalTicks += report.num_ticks;
+    }
+    seconds = Timer () - seconds;
+
+    printf ("%d inputs, %lld ticks, %.0f ticks/s\n", ii, totalTicks, (seconds > 0.0) ? totalTicks / seconds : 0.0);
+
+    if (ii == numIterations)
+    {
+        return 0;
+    }
+
+    FuzzMinimize (data, &size);
+    FuzzCompare (data, size, &report);
+
+    printf ("Mismatch at tick %d of a %d tick input: lines %d/%d, status %d/%d (engine/reference)\n", report.tick,
+            (int)size - FUZZ_SEED_SIZE, report.engine_lines, report.reference_lines, report.engine_status,
+            report.reference_status);
+
+    for (jj=0; jj<GRID_NUM_ROWS; jj++)
+    {
+        if ((report.engine.rows[jj] | report.reference.rows[jj]) == 0)
+        {
+            continue;
+        }
+
+        for (kk=0; kk<GRID_NUM_COLS; kk++)
+        {
+            line[kk] = (report.engine.rows[jj] & (1 << kk)) ? '#' : '.';
+        }
+        printf ("  %2d  %s", jj, line);
+        for (kk=0; kk<GRID_NUM_COLS; kk++)
+        {
+            line[kk] = (report.reference.rows[jj] & (1 << kk)) ? '#' : '.';
+        }
+        printf ("  %s\n", line);
+    }
+
+    if (FuzzWriteScenario (path, data, size) == 0)
+    {
+        printf ("Replay written to %s, run it with the scenario command\n", path);
+    }
+
+    return -1;
+
+}  // End of RunFuzz()
+
+
+static int RunJournalCheck (void)
+{
+    int failed = 0;
+    gameData game;
+    int ii = 0;  // Loop iterator
+    journalData *journal = NULL;
+    int jj = 0;  // Loop iterator
+    int numFailed = 0;
+    int numPlaced = 0;
+    placementData placement = {0};
+    gameData *states = NULL;
+
+    journal = malloc (sizeof (journalData));
+    states = malloc ((JOURNAL_MAX_ENTRIES + 1) * sizeof (gameData));
+    if ((journal == NULL) || (states == NULL))
+    {
+        free (journal);
+        free (states);
+        return -1;
+    }
+
+    // Place N blocks, undo all N and redo all N, comparing every game state
+    // with the one saved on the way in
+    for (ii=0; ii<JOURNAL_CHECK_GAMES; ii++)
+    {
+        GameReset (&game, ii + 1);
+        JournalReset (journal);
+        states[0] = game;
+
+        for (numPlaced=0; (numPlaced<JOURNAL_MAX_ENTRIES) && (game.game_status != GAME_END); numPlaced++)
+        {
+            if ((ChooseGreedyPlacement (&game.board, game.piece.type_index, &g_defaultWeights, &placement) == 0) ||
+                (JournalPlace (journal, &game, &placement) < 0))
+            {
+                break;
+            }
+            states[numPlaced+1] = game;
+        }
+
+        failed = 0;
+        for (jj=numPlaced-1; (jj>=0) && (failed == 0); jj--)
+        {
+            if ((JournalUndo (journal, &game) != 0) || (memcmp (&game, &states[jj], sizeof (gameData)) != 0))
+            {
+                failed = 1;
+            }
+        }
+
+        // Nothing is left to undo before the first placement
+        if ((failed == 0) && (JournalUndo (journal, &game) == 0))
+        {
+            failed = 1;
+        }
+
+        for (jj=1; (jj<=numPlaced) && (failed == 0); jj++)
+        {
+            if ((JournalRedo (journal, &game) != 0) || (memcmp (&game, &states[jj], sizeof (gameData)) != 0))
+            {
+                failed = 1;
+            }
+        }
+
+        if ((failed == 0) && (JournalRedo (journal, &game) == 0))
+        {
+            failed = 1;
+        }
+
+        numFailed += failed;
+
+        printf ("seed %-3d %4d placements undone and redone %s\n", ii + 1, numPlaced, (failed == 0) ? "OK" : "FAIL");
+    }
+
+    printf ("%d of %d games failed\n", numFailed, JOURNAL_CHECK_GAMES);
+
+    free (journal);
+    free (states);
+
+    return (numFailed == 0) ? 0 : -1;
+
+}  // End of RunJournalCheck()
+
+
+static int RunMetrics (int argc, char *argv[])
+{
+    metricsData *metrics = NULL;
+    const char *name = METRICS_DEFAULT_NAME;
+    metricsSnapshot snapshot = {0};
+    int status = 0;
+    char *text = NULL;
+
+    if (argc > 1)
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (argc == 1)
+    {
+        name = argv[0];
+    }
+
+    if (MetricsOpen (name, &metrics) != 0)
+    {
+        printf ("No running game publishes metrics as %s\n", name);
+        return -1;
+    }
+
+    text = malloc (METRICS_TEXT_SIZE);
+    if (text == NULL)
+    {
+        MetricsClose (metrics);
+        return -1;
+    }
+
+    // One scrape, e.g. for the textfile collector of node_exporter
+    status = MetricsRead (metrics, &snapshot);
+    if (status != 0)
+    {
+        printf ("Metrics of %s kept changing while being read\n", name);
+    }
+    else
+    {
+        status = MetricsFormatPrometheus (&snapshot, text, METRICS_TEXT_SIZE);
+        printf ("%s", text);
+    }
+
+    free (text);
+    MetricsClose (metrics);
+
+    return status;
+
+}  // End of RunMetrics()
+
+
+static int RunNeural (int argc, char *argv[])
+{
+    int hidden1 = 64;
+    int hidden2 = 32;
+    neuralNet *net = NULL;
+    int status = 0;
+
+    if ((argc >= 2) && (argc <= 4) && (strcmp (argv[0], "init") == 0))
+    {
+        if (argc >= 3)
+        {
+            hidden1 = atoi (argv[2]);
+        }
+        if (argc == 4)
+        {
+            hidden2 = atoi (argv[3]);
+        }
+
+        if ((NeuralCreateRandom (hidden1, hidden2, 1, &net) != 0) || (NeuralSave (net, argv[1]) != 0))
+        {
+            printf ("Unable to write %s\n", argv[1]);
+            status = -1;
+        }
+
+        NeuralDiscard (net);
+        return status;
+    }
+
+    if ((argc < 1) || (argc > 2) || (strcmp (argv[0], "bench") != 0))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    // Without a weights file, time an untrained network of the default size
+    status = (argc == 2) ? NeuralLoad (argv[1], &net) : NeuralCreateRandom (hidden1, hidden2, 1, &net);
+    if (status != 0)
+    {
+        printf ("Unable to load %s\n", (argc == 2) ? argv[1] : "network");
+        return -1;
+    }
+
+    status = RunNeuralBench (net);
+    NeuralDiscard (net);
+
+    return status;
+
+}  // End of RunNeural()
+
+
+static int RunNeuralBench (const neuralNet *net)
+{
+    boardData *boards = NULL;
+    double checksum = 0.0;
+    gameData game;
+    int ii = 0;  // Loop iterator
+    int *lines = NULL;
+    int numBoards = 0;
+    int numPlacements = 0;
+    placementData placement = {0};
+    placementData placements[MAX_PLACEMENTS];
+    double scores[MAX_PLACEMENTS];
+    double seconds = 0.0;
+    double *values = NULL;
+
+    boards = malloc (NEURAL_BENCH_BOARDS * sizeof (boardData));
+    lines = malloc (NEURAL_BENCH_BOARDS * sizeof (int));
+    values = malloc (NEURAL_BENCH_BOARDS * sizeof (double));
+    if ((boards == NULL) || (lines == NULL) || (values == NULL))
+    {
+        free (boards);
+        free (lines);
+        free (values);
+        return -1;
+    }
+
+    // Boards from a greedy game, so the cell counts are realistic
+    GameReset (&game, 1);
+    for (ii=0; ii<NEURAL_BENCH_BOARDS; ii++)
+    {
+        if (game.game_status == GAME_END)
+        {
+            GameReset (&game, ii + 1);
+        }
+
+        boards[ii] = game.board;
+        lines[ii] = 0;
+
+        if (ChooseGreedyPlacement (&game.board, game.piece.type_index, &g_defaultWeights, &placement) == 0)
+        {
+            GameReset (&game, ii + 1);
+            continue;
+        }
+        GamePlace (&game, &placement);
+    }
+
+    printf ("Network %u-%u-%u-1\n", net->header.num_inputs, net->header.hidden1, net->header.hidden2);
+
+    seconds = Timer ();
+    for (ii=0; ii<100; ii++)
+    {
+        NeuralEvaluateBatch (net, boards, lines, NEURAL_BENCH_BOARDS, values);
+        checksum += values[ii];
+    }
+    seconds = Timer () - seconds;
+    numBoards = 100 * NEURAL_BENCH_BOARDS;
+    printf ("Batch:      %.1f ns per board\n", (seconds * 1e9) / numBoards);
+
+    // Candidate placements share the first layer of the board they start from
+    numBoards = 0;
+    seconds = Timer ();
+    for (ii=0; ii<NEURAL_BENCH_BOARDS*10; ii++)
+    {
+        numPlacements = EnumeratePlacements (&boards[ii % NEURAL_BENCH_BOARDS], ii % NUM_BLOCKS_TYPES, placements);
+        NeuralEvaluatePlacements (net, &boards[ii % NEURAL_BENCH_BOARDS], ii % NUM_BLOCKS_TYPES, placements,
+                                  numPlacements, scores);
+        numBoards += numPlacements;
+        checksum += scores[0];
+    }
+    seconds = Timer () - seconds;
+    printf ("Placements: %.1f ns per board, including enumeration (checksum %g)\n",
+            (numBoards > 0) ? (seconds * 1e9) / numBoards : 0.0, checksum);
+
+    free (boards);
+    free (lines);
+    free (values);
+
+    return 0;
+
+}  // End of RunNeuralBench()
+
+
+static int RunPerfect (int argc, char *argv[])
+{
+    boardData board = {0};
+    int ii = 0;  // Loop iterator
+    int numTypes = 0;
+    double seconds = 0.0;
+    perfectSolution solution;
+    perfectSolver *solver = NULL;
+    int status = 0;
+    int types[PERFECT_MAX_PIECES];
+
+    if ((argc >= 2) && (argc <= 3) && (strcmp (argv[0], "bench") == 0))
+    {
+        return RunPerfectBench (atoi (argv[1]), (argc == 3) ? atoi (argv[2]) : PERFECT_MAX_PIECES - 1);
+    }
+
+    if ((argc < 1) || (argc > 2))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if ((argc == 2) && (ReadBoardFile (argv[1], &board) != 0))
+    {
+        return -1;
+    }
+
+    for (ii=0; (argv[0][ii] != '\0') && (numTypes < PERFECT_MAX_PIECES); ii++)
+    {
+        types[numTypes++] = PieceTypeIndex (argv[0][ii]);
+    }
+
+    if (PerfectClearCreate (PERFECT_DEFAULT_TABLE_BITS, 0, &solver) != 0)
+    {
+        return -1;
+    }
+
+    seconds = Timer ();
+    status = PerfectClearFind (solver, &board, types, numTypes, &solution);
+    seconds = Timer () - seconds;
+    PerfectClearDiscard (solver);
+
+    if (status < 0)
+    {
+        printf ("Sequence must be blocks of IJLOTSZ\n");
+        return -1;
+    }
+
+    printf ("%s, %.3f ms\n", (status == 1) ? "Perfect clear" : "No perfect clear", seconds * 1000.0);
+    for (ii=0; ii<solution.num_pieces; ii++)
+    {
+        printf ("%2d. %c orientation %d column %d row %d\n", ii + 1, PieceBlockType (solution.types[ii]),
+                solution.placements[ii].orientation, solution.placements[ii].x, solution.placements[ii].y);
+    }
+
+    return (status == 1) ? 0 : -1;
+
+}  // End of RunPerfect()
+
+
+static int RunPerfectBench (int num_games, int num_preview)
+{
+    int cleared = 0;
+    gameData game;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    double maxSeconds = 0.0;
+    int numPerfect = 0;
+    placementData placement = {0};
+    double seconds = 0.0;
+    perfectSolver *solver = NULL;
+    perfectStats stats;
+    double totalSeconds = 0.0;
+
+    if (PerfectClearCreate (PERFECT_DEFAULT_TABLE_BITS, PERFECT_DEFAULT_MAX_NODES, &solver) != 0)
+    {
+        return -1;
+    }
+
+    // Greedy games that follow a perfect clear whenever the preview allows one
+    for (ii=0; ii<num_games; ii++)
+    {
+        GameReset (&game, ii + 1);
+
+        for (jj=0; (jj < 200) && (game.game_status != GAME_END); jj++)
+        {
+            seconds = Timer ();
+            if (ChoosePerfectClearPlacement (solver, &game, num_preview, &placement) == 0)
+            {
+                ChooseGreedyPlacement (&game.board, game.piece.type_index, &g_defaultWeights, &placement);
+            }
+            seconds = Timer () - seconds;
+
+            totalSeconds += seconds;
+            maxSeconds = (seconds > maxSeconds) ? seconds : maxSeconds;
+
+            cleared = GamePlace (&game, &placement);
+            if ((cleared > 0) && (game.board.rows[GRID_NUM_ROWS-1] == 0))
+            {
+                numPerfect++;
+            }
+        }
+    }
+
+    PerfectClearGetStats (solver, &stats);
+    PerfectClearDiscard (solver);
+
+    printf ("%d games, %d perfect clears, %lld queries, %.1f us per query (max %.3f ms)\n", num_games, numPerfect,
+            stats.queries, (stats.queries > 0) ? totalSeconds * 1e6 / stats.queries : 0.0, maxSeconds * 1000.0);
+    printf ("%lld nodes, %lld table hits, %lld queries stopped at the node limit\n", stats.nodes, stats.table_hits,
+            stats.gave_up);
+
+    return 0;
+
+}  // End of RunPerfectBench()
+
+
+static int RunPerft (int argc, char *argv[])
+{
+    boardData board = {0};
+    int depth = 0;
+    int ii = 0;  // Loop iterator
+    perftResult result;
+
+    if ((argc == 1) && (strcmp (argv[0], "check") == 0))
+    {
+        return RunPerftCheck ();
+    }
+
+    if ((argc < 2) || (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if ((argc == 3) && (ReadBoardFile (argv[2], &board) != 0))
+    {
+        return -1;
+    }
+
+    depth = atoi (argv[1]);
+
+    // Report every depth up to the requested one, like chess perft tools
+    for (ii=1; ii<=depth; ii++)
+    {
+        if (Perft (&board, argv[0], ii, &result) != 0)
+        {
+            printf ("Depth must be between 1 and the sequence length (max %d)\n", PERFT_MAX_DEPTH);
+            return -1;
+        }
+
+        printf ("perft %d: %lld leaves, %lld nodes, %.3f s, %.0f nodes/s\n", ii, result.leaves,
+                result.nodes, result.seconds, (result.seconds > 0.0) ? result.nodes / result.seconds : 0.0);
+    }
+
+    return 0;
+
+}  // End of RunPerft()
+
+
+static int RunPerftCheck (void)
+{
+    boardData board = {0};
+    int ii = 0;  // Loop iterator
+    int numFailed = 0;
+    perftResult result;
+    long long totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    for (ii=0; ii<g_numPerftPositions; ii++)
+    {
+        if (BoardParse (&board, g_perftPositions[ii].board) != 0)
+        {
+            printf ("%-12s invalid board\n", g_perftPositions[ii].name);
+            numFailed++;
+            continue;
+        }
+
+        Perft (&board, g_perftPositions[ii].sequence, g_perftPositions[ii].depth, &result);
+
+        totalNodes += result.nodes;
+        totalSeconds += result.seconds;
+
+        if (result.leaves != g_perftPositions[ii].leaves)
+        {
+            numFailed++;
+        }
+
+        printf ("%-12s %-6s depth %d: %lld leaves (expected %lld) %s\n", g_perftPositions[ii].name,
+                g_perftPositions[ii].sequence, g_perftPositions[ii].depth, result.leaves,
+                g_perftPositions[ii].leaves, (result.leaves == g_perftPositions[ii].leaves) ? "OK" : "FAIL");
+    }
+
+    printf ("%d of %d positions failed, %.0f nodes/s\n", numFailed, g_numPerftPositions,
+            (totalSeconds > 0.0) ? totalNodes / totalSeconds : 0.0);
+
+    return (numFailed == 0) ? 0 : -1;
+
+}  // End of RunPerftCheck()
+
+
+static int RunPuzzle (int argc, char *argv[])
+{
+    boardData board = {0};
+    puzzleConfig config;
+    int ii = 0;  // Loop iterator
+    char inputs[REACH_NUM_STATES + 1] = "\0";
+    int jj = 0;  // Loop iterator
+    int length = 0;
+    pieceData piece = {0};
+    reachData reach;
+    puzzleResult result;
+
+    if ((argc == 1) && (strcmp (argv[0], "check") == 0))
+    {
+        return RunPuzzleCheck ();
+    }
+
+    if ((argc < 1) || (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if ((argc >= 2) && (ReadBoardFile (argv[1], &board) != 0))
+    {
+        return -1;
+    }
+
+    PuzzleDefaultConfig (&config);
+    if (argc == 3)
+    {
+        config.num_threads = atoi (argv[2]);
+    }
+
+    if (PuzzleSolve (&board, argv[0], &config, &result) != 0)
+    {
+        printf ("Sequence must be 1 to %d blocks of IJLOTSZ\n", PUZZLE_MAX_PIECES);
+        return -1;
+    }
+
+    printf ("%s: %lld nodes, %lld table hits, %lld pruned, %lld KB scratch, %.3f s\n",
+            (result.status == PUZZLE_SOLVED) ? "Solved" : (result.status == PUZZLE_IMPOSSIBLE) ? "Impossible" : "Unknown",
+            result.nodes, result.table_hits, result.pruned, result.scratch_bytes / 1024, result.seconds);
+
+    // Replay the solution to show the inputs for each block
+    for (ii=0; (result.status == PUZZLE_SOLVED) && (ii<result.num_pieces); ii++)
+    {
+        PieceSpawn (result.placements[ii].type_index, &piece);
+        ReachSearch (&board, &piece, &reach);
+
+        for (jj=0; jj<reach.num_locks; jj++)
+        {
+            ReachLockPiece (&reach, jj, &piece);
+            if (memcmp (&piece, &result.placements[ii], sizeof (pieceData)) == 0)
+            {
+                break;
+            }
+        }
+
+        length = ReachInputSequence (&reach, jj, inputs, REACH_NUM_STATES);
+        inputs[(length < 0) ? 0 : length] = '\0';
+
+        printf ("%2d. %c orientation %d column %d row %d: %s\n", ii + 1,
+                PieceBlockType (result.placements[ii].type_index), result.placements[ii].orientation,
+                result.placements[ii].x, result.placements[ii].y, inputs);
+
+        BoardLockPiece (&board, &result.placements[ii]);
+    }
+
+    return (result.status == PUZZLE_SOLVED) ? 0 : -1;
+
+}  // End of RunPuzzle()
+
+
+static int RunPuzzleCheck (void)
+{
+    boardData board = {0};
+    puzzleConfig config;
+    int failed = 0;
+    int ii = 0;  // Loop iterator
+    int numFailed = 0;
+    puzzleResult result;
+    const char *status = NULL;
+
+    for (ii=0; ii<g_numPuzzlePositions; ii++)
+    {
+        if (BoardParse (&board, g_puzzlePositions[ii].board) != 0)
+        {
+            printf ("%-12s invalid board\n", g_puzzlePositions[ii].name);
+            numFailed++;
+            continue;
+        }
+
+        // Stopped at the node budget counts as a failure too
+        PuzzleDefaultConfig (&config);
+        config.max_nodes = g_puzzlePositions[ii].max_nodes;
+        PuzzleSolve (&board, g_puzzlePositions[ii].sequence, &config, &result);
+
+        failed = (result.status != g_puzzlePositions[ii].status) ||
+                 (result.seconds > g_puzzlePositions[ii].max_seconds);
+        numFailed += failed;
+
+        status = (result.status == PUZZLE_SOLVED) ? "solved" :
+                 (result.status == PUZZLE_IMPOSSIBLE) ? "impossible" : "unknown";
+
+        printf ("%-12s %-10s %s (expected %s), %lld nodes, %.3f s (max %.1f s) %s\n", g_puzzlePositions[ii].name,
+                g_puzzlePositions[ii].sequence, status,
+                (g_puzzlePositions[ii].status == PUZZLE_SOLVED) ? "solved" : "impossible", result.nodes,
+                result.seconds, g_puzzlePositions[ii].max_seconds, failed ? "FAIL" : "OK");
+    }
+
+    printf ("%d of %d puzzles failed\n", numFailed, g_numPuzzlePositions);
+
+    return (numFailed == 0) ? 0 : -1;
+
+}  // End of RunPuzzleCheck()
+
+
+static int RunRegress (int argc, char *argv[])
+{
+    int numSamples = 0;
+    int record = 0;
+    const char *report = NULL;
+
+    if ((argc < 2) || (argc > 4) || ((strcmp (argv[0], "record") != 0) && (strcmp (argv[0], "compare") != 0)))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    record = (strcmp (argv[0], "record") == 0);
+    if (record && (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (argc == (record ? 3 : 4))
+    {
+        numSamples = atoi (argv[argc-1]);
+        if (numSamples < 1)
+        {
+            printf ("Samples must be at least 1\n");
+            return -1;
+        }
+    }
+    if (!record && (argc >= 3))
+    {
+        report = argv[2];
+    }
+
+    return RegressRun (record, argv[1], report, numSamples);
+
+}  // End of RunRegress()
+
+
+static int RunRing (int argc, char *argv[])
+{
+    if ((argc == 4) && (strcmp (argv[0], "publish") == 0))
+    {
+        return RunRingProducer (argv[1], atoi (argv[2]), atoi (argv[3]));
+    }
+
+    if ((argc == 2) && (strcmp (argv[0], "consume") == 0))
+    {
+        return RunRingConsumer (argv[1]);
+    }
+
+    ShowUsage ();
+
+    return -1;
+
+}  // End of RunRing()
+
+
+static int RunRingConsumer (const char *name)
+{
+    double bytes = 0.0;
+    unsigned long long checksum = 0;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numBatches = 0;
+    int numEpisodes = 0;
+    ringData *ring = NULL;
+    ringSlot slot = {0};
+    double start = 0.0;
+    int status = 0;
+    double seconds = 0.0;
+
+    if (RingOpen (name, &ring) != 0)
+    {
+        printf ("No ring named %s\n", name);
+        return -1;
+    }
+
+    // Reference consumer, reads every byte of every batch in place
+    while ((status = RingReceive (ring, 10.0, &slot)) == 0)
+    {
+        if (numBatches == 0)
+        {
+            start = Timer ();
+        }
+
+        for (ii=0; ii<slot.num_envs; ii++)
+        {
+            for (jj=0; jj<GRID_NUM_ROWS; jj++)
+            {
+                checksum += slot.obs[ii].rows[jj];
+            }
+            checksum += (unsigned long long)slot.obs[ii].legal + slot.obs[ii].type_index + slot.actions[ii];
+            numEpisodes += slot.dones[ii];
+        }
+
+        bytes += slot.num_envs * (sizeof (vecObservation) + sizeof (int) + sizeof (float) + 1);
+        numBatches++;
+
+        RingRelease (ring);
+    }
+    seconds = (numBatches > 0) ? Timer () - start : 0.0;
+
+    RingClose (ring);
+
+    printf ("%d batches, %d games finished, checksum %llx\n", numBatches, numEpisodes, checksum);
+    printf ("%.3f s, %.0f batches/s, %.1f MB/s\n", seconds, (seconds > 0.0) ? numBatches / seconds : 0.0,
+            (seconds > 0.0) ? bytes / seconds / 1e6 : 0.0);
+
+    return (status == RING_ERR_CLOSED) ? 0 : -1;
+
+}  // End of RunRingConsumer()
+
+
+static int RunRingProducer (const char *name, int num_envs, int num_batches)
+{
+    int action = 0;
+    vecEnvConfig config;
+    vecEnvData *env = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    ringSlot previous = {0};
+    ringData *ring = NULL;
+    rngData rng;
+    ringSlot slot = {0};
+
+    VecEnvDefaultConfig (&config);
+    config.num_envs = num_envs;
+
+    if (RingCreate (name, num_envs, 8, &ring) != 0)
+    {
+        printf ("Unable to create ring %s\n", name);
+        return -1;
+    }
+    if (VecEnvCreate (&config, &env) != 0)
+    {
+        RingClose (ring);
+        return -1;
+    }
+
+    RngSeed (&rng, config.seed);
+
+    // The environment writes every batch straight into the shared memory. The first
+    // one holds the reset observations and counts as one of the num_batches.
+    for (ii=0; ii<num_batches; ii++)
+    {
+        if (RingAcquire (ring, -1.0, &slot) != 0)
+        {
+            break;
+        }
+
+        if (ii == 0)
+        {
+            VecEnvReset (env, slot.obs);
+            memset (slot.actions, 0, num_envs * sizeof (int));
+            memset (slot.rewards, 0, num_envs * sizeof (float));
+            memset (slot.dones, 0, num_envs);
+        }
+        else
+        {
+            // Random legal actions from the batch published before
+            for (jj=0; jj<num_envs; jj++)
+            {
+                action = RngRange (&rng, MAX_PLACEMENTS);
+                while ((previous.obs[jj].legal & (1ULL << action)) == 0)
+                {
+                    action = (action + 1) % MAX_PLACEMENTS;
+                }
+                slot.actions[jj] = action;
+            }
+
+            VecEnvStep (env, slot.actions, slot.obs, slot.rewards, slot.dones);
+        }
+
+        RingPublish (ring);
+        previous = slot;
+    }
+
+    VecEnvDiscard (env);
+    RingClose (ring);
+
+    return 0;
+
+}  // End of RunRingProducer()
+
+
+static int RunScenario (int argc, char *argv[])
+{
+    int errorLine = 0;
+    int ii = 0;  // Loop iterator
+    int numFailed = 0;
+    int numRepeats = 1;
+    int numScenarios = 0;
+    int numThreads = 0;
+    scenarioResult *results = NULL;
+    scenarioData *scenarios = NULL;
+    scenarioData *repeated = NULL;
+    double seconds = 0.0;
+    int status = 0;
+
+    if ((argc < 1) || (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    if (strcmp (argv[0], "check") == 0)
+    {
+        status = ScenarioParse (g_rotationScenarios, &scenarios, &numScenarios, &errorLine);
+    }
+    else
+    {
+        status = ScenarioLoad (argv[0], &scenarios, &numScenarios, &errorLine);
+    }
+
+    if (status != 0)
+    {
+        printf ("Unable to read scenarios from %s, line %d\n", argv[0], errorLine);
+        return -1;
+    }
+
+    if (argc >= 2)
+    {
+        numThreads = atoi (argv[1]);
+    }
+    if (argc == 3)
+    {
+        numRepeats = atoi (argv[2]);
+    }
+
+    // Repeated copies make a run long enough to time
+    if (numRepeats > 1)
+    {
+        repeated = malloc ((size_t)numScenarios * numRepeats * sizeof (scenarioData));
+        if (repeated == NULL)
+        {
+            free (scenarios);
+            return -1;
+        }
+        for (ii=0; ii<numRepeats; ii++)
+        {
+            memcpy (repeated + (size_t)ii * numScenarios, scenarios, numScenarios * sizeof (scenarioData));
+        }
+        free (scenarios);
+        scenarios = repeated;
+        numScenarios *= numRepeats;
+    }
+
+    results = malloc (((numScenarios > 0) ? numScenarios : 1) * sizeof (scenarioResult));
+    if (results == NULL)
+    {
+        free (scenarios);
+        return -1;
+    }
+
+    seconds = Timer ();
+    numFailed = ScenarioRunAll (scenarios, numScenarios, numThreads, results);
+    seconds = Timer () - seconds;
+
+    for (ii=0; (numFailed > 0) && (ii < numScenarios / numRepeats); ii++)
+    {
+        if (results[ii].passed == 0)
+        {
+            PrintScenarioFailure (&scenarios[ii], &results[ii]);
+        }
+    }
+
+    printf ("%d of %d scenarios failed, %.3f ms\n", numFailed, numScenarios, seconds * 1000.0);
+
+    free (scenarios);
+    free (results);
+
+    return (numFailed == 0) ? 0 : -1;
+
+}  // End of RunScenario()
+
+
+static int RunTune (int argc, char *argv[])
+{
+    tunerConfig config;
+    int numGenerations = 0;
+    tunerState state;
+
+    if ((argc < 2) || (argc > 3))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    TunerDefaultConfig (&config);
+    if (argc == 3)
+    {
+        numGenerations = atoi (argv[2]);
+    }
+
+    // Carry on from the checkpoint when there is one
+    if (TunerLoadCheckpoint (&state, argv[0]) == 0)
+    {
+        printf ("Resuming from generation %d\n", state.generation);
+    }
+    else if (TunerCreate (&state, &config) != 0)
+    {
+        return -1;
+    }
+
+    // Without a generation count, run until stopped
+    while ((numGenerations == 0) || (state.generation < numGenerations))
+    {
+        if (TunerRunGeneration (&state, &config) != 0)
+        {
+            printf ("Invalid tuner configuration\n");
+            return -1;
+        }
+
+        printf ("generation %d: %.1f lines (best %.1f), weights %.4f %.4f %.4f %.4f, %.1f s, %.1f games/s\n",
+                state.generation, state.mean_lines, state.best_lines, state.weights[0], state.weights[1],
+                state.weights[2], state.weights[3], state.seconds,
+                (state.seconds > 0.0) ? config.population * config.games / state.seconds : 0.0);
+
+        if ((TunerSaveCheckpoint (&state, argv[0]) != 0) ||
+            (TunerWriteHeader (&state, &config, argv[1]) != 0))
+        {
+            printf ("Unable to write %s or %s\n", argv[0], argv[1]);
+            return -1;
+        }
+    }
+
+    return 0;
+
+}  // End of RunTune()
+
+
+static int RunVariant (int argc, char *argv[])
+{
+    variantConfig config;
+    variantStats stats;
+
+    if ((argc < 2) || (argc > 4))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    VariantDefaultConfig (&config);
+    config.num_cols = atoi (argv[0]);
+    config.num_rows = atoi (argv[1]);
+    if (argc >= 3)
+    {
+        config.num_games = atoi (argv[2]);
+    }
+    if (argc == 4)
+    {
+        config.mode = argv[3];
+    }
+
+    if (config.num_games <= 0)
+    {
+        printf ("Games must be at least 1\n");
+        return -1;
+    }
+
+    if (VariantPlay (&config, &stats) != 0)
+    {
+        printf ("No board model%s%s for %d columns and %d rows\n", (config.mode != NULL) ? " named " : "",
+                (config.mode != NULL) ? config.mode : "", config.num_cols, config.num_rows);
+        return -1;
+    }
+
+    printf ("%dx%d board, %s rows: %lld games, %.1f lines per game, %lld blocks\n", config.num_cols,
+            config.num_rows, stats.mode, stats.games, (double)stats.lines / stats.games, stats.pieces);
+    printf ("%.3f s, %.0f blocks/s\n", stats.seconds, (stats.seconds > 0.0) ? stats.pieces / stats.seconds : 0.0);
+
+    return 0;
+
+}  // End of RunVariant()
+
+
+static int RunVecEnv (int argc, char *argv[])
+{
+    int action = 0;
+    int *actions = NULL;
+    vecEnvConfig config;
+    unsigned char *dones = NULL;
+    vecEnvData *env = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    double lines = 0.0;
+    int numActions = 0;
+    int numEpisodes = 0;
+    int numSteps = 0;
+    vecObservation *obs = NULL;
+    float *rewards = NULL;
+    rngData rng;
+    double seconds = 0.0;
+
+    if ((argc < 3) || (argc > 4))
+    {
+        ShowUsage ();
+        return -1;
+    }
+
+    VecEnvDefaultConfig (&config);
+    config.action_mode = (strcmp (argv[0], "input") == 0) ? VECENV_ACTION_INPUT : VECENV_ACTION_PLACEMENT;
+    config.num_envs = atoi (argv[1]);
+    numSteps = atoi (argv[2]);
+    if (argc == 4)
+    {
+        config.num_threads = atoi (argv[3]);
+    }
+    numActions = VECENV_NUM_ACTIONS (config.action_mode);
+
+    if (VecEnvCreate (&config, &env) != 0)
+    {
+        printf ("Unable to create %s environments\n", argv[1]);
+        return -1;
+    }
+
+    obs = malloc (config.num_envs * sizeof (vecObservation));
+    actions = malloc (config.num_envs * sizeof (int));
+    rewards = malloc (config.num_envs * sizeof (float));
+    dones = malloc (config.num_envs);
+
+    if ((obs != NULL) && (actions != NULL) && (rewards != NULL) && (dones != NULL))
+    {
+        RngSeed (&rng, config.seed);
+        VecEnvReset (env, obs);
+
+        // Random legal actions, the time includes choosing them
+        seconds = Timer ();
+        for (ii=0; ii<numSteps; ii++)
+        {
+            for (jj=0; jj<config.num_envs; jj++)
+            {
+                action = RngRange (&rng, numActions);
+                while ((obs[jj].legal & (1ULL << action)) == 0)
+                {
+                    action = (action + 1) % numActions;
+                }
+                actions[jj] = action;
+            }
+
+            VecEnvStep (env, actions, obs, rewards, dones);
+
+            for (jj=0; jj<config.num_envs; jj++)
+            {
+                lines += rewards[jj];
+                numEpisodes += dones[jj];
+            }
+        }
+        seconds = Timer () - seconds;
+
+        printf ("%d environments, %d steps each, %d games finished, %.2f lines per game\n", config.num_envs,
+                numSteps, numEpisodes, (numEpisodes > 0) ? lines / numEpisodes : 0.0);
+        printf ("%.3f s, %.0f steps/s\n", seconds,
+                (seconds > 0.0) ? (double)config.num_envs * numSteps / seconds : 0.0);
+    }
+
+    VecEnvDiscard (env);
+    free (obs);
+    free (actions);
+    free (rewards);
+    free (dones);
+
+    return (seconds > 0.0) ? 0 : -1;
+
+}  // End of RunVecEnv()
+
+
+static void ShowUsage (void)
+{
+    printf ("Usage:\n");
+    printf ("  blockdrop_tools bench [json_file] [samples] [cpu]\n");
+    printf ("  blockdrop_tools dataset <prefix> <games> [random] [compress]\n");
+    printf ("  blockdrop_tools dataset check <shard_file>\n");
+    printf ("  blockdrop_tools finesse <replay_file> [replay_file ...]\n");
+    printf ("  blockdrop_tools finesse table\n");
+    printf ("  blockdrop_tools fuzz <iterations> [seed] [scenario_file]\n");
+    printf ("  blockdrop_tools journal check\n");
+    printf ("  blockdrop_tools metrics [name]\n");
+    printf ("  blockdrop_tools neural init <weights_file> [hidden1] [hidden2]\n");
+    printf ("  blockdrop_tools neural bench [weights_file]\n");
+    printf ("  blockdrop_tools perfect <sequence> [board_file]\n");
+    printf ("  blockdrop_tools perfect bench <games> [preview]\n");
+    printf ("  blockdrop_tools perft <sequence> <depth> [board_file]\n");
+    printf ("  blockdrop_tools perft check\n");
+    printf ("  blockdrop_tools puzzle <sequence> [board_file] [threads]\n");
+    printf ("  blockdrop_tools puzzle check\n");
+    printf ("  blockdrop_tools regress record <baseline_file> [samples]\n");
+    printf ("  blockdrop_tools regress compare <baseline_file> [report_file] [samples]\n");
+    printf ("  blockdrop_tools ring publish <name> <num_envs> <batches>\n");
+    printf ("  blockdrop_tools ring consume <name>\n");
+    printf ("  blockdrop_tools scenario <scenario_file|check> [threads] [repeat]\n");
+    printf ("  blockdrop_tools tune <checkpoint_file> <header_file> [generations]\n");
+    printf ("  blockdrop_tools variant <columns> <rows> [games] [standard|uint16|uint32|uint64]\n");
+    printf ("  blockdrop_tools vecenv <placement|input> <num_envs> <steps> [threads]\n");
+
+}  // End of ShowUsage()
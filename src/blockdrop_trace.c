@@ -0,0 +1,226 @@
+//==============================================================================
+//
+// Title:       blockdrop_trace.c
+// Purpose:     Trace zones of the game and user interface, written as a
+//              Chrome Trace Event file.
+//
+//              Every thread appends to its own buffer, found through a thread
+//              local slot, so recording takes no locks. A thread claims its
+//              buffer with one interlocked increment on its first event.
+//              TraceWrite() reads all buffers and must run after the other
+//              threads have stopped recording, e.g. when the game quits.
+//
+//              A full buffer drops whole zones: a begin is only recorded when
+//              there is room left for its end and the ends of all zones still
+//              open, and the end of a dropped begin is dropped with it.
+//
+//              The file opens in chrome://tracing and in the Perfetto UI.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_trace.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const char *name;
+    unsigned long long ns;
+    char phase;                 // 'B' begin or 'E' end
+} traceEvent;
+
+typedef struct
+{
+    DWORD thread_id;
+    int num_events;
+    int num_dropped;
+    int num_open;               // Zones begun and recorded, room is kept for their ends
+    int num_skipped;            // Zones begun and dropped, their ends are dropped too
+    traceEvent *events;         // NULL when the buffer could not be allocated
+} traceBuffer;
+
+//==============================================================================
+// Static global variables
+
+static traceBuffer g_buffers[TRACE_MAX_THREADS];
+
+static volatile LONG g_numBuffers = 0;
+
+static traceBuffer g_overflow = {0};  // Threads past TRACE_MAX_THREADS, events is NULL
+
+static DWORD g_mainThread = 0;
+
+static unsigned long long g_origin = 0;  // Time of TraceStart(), ns
+
+static DWORD g_tlsIndex = TLS_OUT_OF_INDEXES;
+
+//==============================================================================
+// Static functions
+
+static traceBuffer *ClaimBuffer (void);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+void TraceEvent (const char *name, char phase)
+{
+    traceBuffer *buffer = NULL;
+    traceEvent *event = NULL;
+
+    if (g_tlsIndex == TLS_OUT_OF_INDEXES)
+    {
+        return;
+    }
+
+    buffer = TlsGetValue (g_tlsIndex);
+    if (buffer == NULL)
+    {
+        buffer = ClaimBuffer ();
+    }
+
+    if (phase == 'B')
+    {
+        // Room for this zone and the ends of the open ones, or the zone is dropped whole
+        if ((buffer->events == NULL) || (buffer->num_skipped > 0) ||
+            (buffer->num_events + buffer->num_open + 2 > TRACE_BUFFER_EVENTS))
+        {
+            buffer->num_skipped++;
+            buffer->num_dropped++;
+            return;
+        }
+        buffer->num_open++;
+    }
+    else if (buffer->num_skipped > 0)
+    {
+        buffer->num_skipped--;
+        buffer->num_dropped++;
+        return;
+    }
+    else if ((buffer->events == NULL) || (buffer->num_open == 0))
+    {
+        // An end without a recorded begin
+        buffer->num_dropped++;
+        return;
+    }
+    else
+    {
+        buffer->num_open--;
+    }
+
+    event = &buffer->events[buffer->num_events];
+    event->name = name;
+    event->ns = LatencyNow ();
+    event->phase = phase;
+    buffer->num_events++;
+
+}  // End of TraceEvent()
+
+
+int TraceStart (void)
+{
+    if (g_tlsIndex != TLS_OUT_OF_INDEXES)
+    {
+        return 0;
+    }
+
+    g_tlsIndex = TlsAlloc ();
+    if (g_tlsIndex == TLS_OUT_OF_INDEXES)
+    {
+        return -1;
+    }
+
+    g_mainThread = GetCurrentThreadId ();
+    g_origin = LatencyNow ();
+
+    return 0;
+
+}  // End of TraceStart()
+
+
+int TraceWrite (const char *path)
+{
+    const traceBuffer *buffer = NULL;
+    int first = 1;
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int numBuffers = g_numBuffers;
+    DWORD pid = GetCurrentProcessId ();
+
+    if (numBuffers > TRACE_MAX_THREADS)
+    {
+        numBuffers = TRACE_MAX_THREADS;
+    }
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf (file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    // Thread names first, then the events in microseconds since TraceStart()
+    for (ii=0; ii<numBuffers; ii++)
+    {
+        buffer = &g_buffers[ii];
+        fprintf (file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":%lu,"
+                 "\"args\":{\"name\":\"%s %lu\",\"dropped\":%d}}", first ? "" : ",", (unsigned long)pid,
+                 (unsigned long)buffer->thread_id, (buffer->thread_id == g_mainThread) ? "main" : "worker",
+                 (unsigned long)buffer->thread_id, buffer->num_dropped);
+        first = 0;
+    }
+
+    for (ii=0; ii<numBuffers; ii++)
+    {
+        buffer = &g_buffers[ii];
+        for (jj=0; jj<buffer->num_events; jj++)
+        {
+            fprintf (file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%lu,\"tid\":%lu}",
+                     buffer->events[jj].name, buffer->events[jj].phase,
+                     (buffer->events[jj].ns - g_origin) / 1000.0, (unsigned long)pid,
+                     (unsigned long)buffer->thread_id);
+        }
+    }
+
+    fprintf (file, "\n]}\n");
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of TraceWrite()
+
+
+static traceBuffer *ClaimBuffer (void)
+{
+    traceBuffer *buffer = NULL;
+    LONG index = InterlockedIncrement (&g_numBuffers) - 1;
+
+    if (index < TRACE_MAX_THREADS)
+    {
+        // Without events every event of the thread counts as dropped, under its own thread id
+        buffer = &g_buffers[index];
+        buffer->thread_id = GetCurrentThreadId ();
+        buffer->events = malloc (TRACE_BUFFER_EVENTS * sizeof (traceEvent));
+    }
+    else
+    {
+        buffer = &g_overflow;
+    }
+
+    TlsSetValue (g_tlsIndex, buffer);
+
+    return buffer;
+
+}  // End of ClaimBuffer()
@@ -0,0 +1,65 @@
+//==============================================================================
+//
+// Title:       blockdrop_trace.h
+// Purpose:     Trace zones of the game and user interface, written as a
+//              Chrome Trace Event file.
+//
+//              The zones are compiled in only when BLOCKDROP_TRACE is
+//              defined, otherwise the TRACE_ macros are empty.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_trace_H__
+#define __blockdrop_trace_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_latency.h"
+
+//==============================================================================
+// Constants
+
+#define TRACE_MAX_THREADS       64
+#define TRACE_BUFFER_EVENTS     65536   // Per thread, later events are dropped
+#define TRACE_FILE              "blockdrop_trace.json"
+
+// Zone names are kept as pointers, so they must be string literals
+#ifdef BLOCKDROP_TRACE
+    #define TRACE_BEGIN(name)   TraceEvent ((name), 'B')
+    #define TRACE_END(name)     TraceEvent ((name), 'E')
+    #define TRACE_START()       TraceStart ()
+    #define TRACE_WRITE(path)   TraceWrite (path)
+#else
+    #define TRACE_BEGIN(name)
+    #define TRACE_END(name)
+    #define TRACE_START()
+    #define TRACE_WRITE(path)
+#endif
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+void TraceEvent (const char *name, char phase);
+
+int TraceStart (void);
+
+int TraceWrite (const char *path);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_trace_H__ */
@@ -0,0 +1,513 @@
+//==============================================================================
+//
+// Title:       blockdrop_tuner.c
+// Purpose:     Cross-entropy tuning of the greedy policy weights.
+//
+//              Every generation samples candidate weight vectors from a normal
+//              distribution, plays the same seeded headless games with each of
+//              them and refits the distribution to the best candidates. The
+//              current mean is always candidate 0, so its score is measured on
+//              the same games as the samples. Games are handed out one at a
+//              time through an interlocked counter, so the threads never wait
+//              on each other and throughput grows with the number of cores.
+//
+//              Weight vectors are scaled to unit length since the greedy policy
+//              only compares scores and does not depend on their scale.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_tuner.h"
+
+//==============================================================================
+// Constants
+
+#define MAX_LINE_TEXT           256
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    const tunerConfig *config;
+    int num_candidates;
+    int num_items;                                          // One item per candidate and game
+    volatile LONG next_item;
+    weightData weights[TUNER_MAX_POPULATION];
+    unsigned long long seeds[TUNER_MAX_GAMES];
+    int lines[TUNER_MAX_POPULATION * TUNER_MAX_GAMES];
+} tunerJob;
+
+//==============================================================================
+// Static global variables
+
+static tunerJob tunerSharedJob;
+
+//==============================================================================
+// Static functions
+
+static void Normalize (double values[TUNER_NUM_WEIGHTS]);
+
+static int PlayGame (const weightData *weights, unsigned long long seed, int max_pieces);
+
+static double RngNormal (rngData *rng);
+
+static void ToWeights (const double values[TUNER_NUM_WEIGHTS], weightData *weights);
+
+static int CVICALLBACK TunerWorker (void *functionData);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int TunerCreate (tunerState *state, const tunerConfig *config)
+{
+    int ii = 0;  // Loop iterator
+
+    memset (state, 0, sizeof (tunerState));
+
+    // Start from the compiled in weights
+    state->mean[0] = g_defaultWeights.height;
+    state->mean[1] = g_defaultWeights.lines;
+    state->mean[2] = g_defaultWeights.holes;
+    state->mean[3] = g_defaultWeights.bumpiness;
+    Normalize (state->mean);
+
+    for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+    {
+        state->sigma[ii] = config->initial_sigma;
+        state->weights[ii] = state->mean[ii];
+        state->best_weights[ii] = state->mean[ii];
+    }
+    state->best_fitness = -1.0;  // Nothing played yet
+
+    RngSeed (&state->rng, config->seed);
+
+    return 0;
+
+}  // End of TunerCreate()
+
+
+void TunerDefaultConfig (tunerConfig *config)
+{
+    memset (config, 0, sizeof (tunerConfig));
+
+    config->population = TUNER_DEFAULT_POPULATION;
+    config->num_elite = TUNER_DEFAULT_ELITE;
+    config->games = TUNER_DEFAULT_GAMES;
+    config->max_pieces = TUNER_DEFAULT_MAX_PIECES;
+    config->initial_sigma = TUNER_DEFAULT_SIGMA;
+    config->extra_noise = TUNER_DEFAULT_NOISE;
+    config->seed = 1;
+
+}  // End of TunerDefaultConfig()
+
+
+int TunerLoadCheckpoint (tunerState *state, const char *path)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    char line[MAX_LINE_TEXT] = "\0";
+    int numFields = 0;
+    double *values = NULL;
+
+    file = fopen (path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    memset (state, 0, sizeof (tunerState));
+
+    // One "name value ..." line per field, see TunerSaveCheckpoint()
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        values = NULL;
+
+        if (sscanf (line, "generation %d", &state->generation) == 1)
+        {
+            numFields++;
+        }
+        else if (sscanf (line, "rng %llx", &state->rng.state) == 1)
+        {
+            numFields++;
+        }
+        else if (sscanf (line, "games %lld", &state->games_played) == 1)
+        {
+            numFields++;
+        }
+        else if (sscanf (line, "lines %lf %lf", &state->mean_lines, &state->best_lines) == 2)
+        {
+            numFields++;
+        }
+        else if (sscanf (line, "fitness %lf", &state->best_fitness) == 1)
+        {
+            numFields++;
+        }
+        else if (strncmp (line, "mean ", 5) == 0)
+        {
+            values = state->mean;
+        }
+        else if (strncmp (line, "sigma ", 6) == 0)
+        {
+            values = state->sigma;
+        }
+        else if (strncmp (line, "weights ", 8) == 0)
+        {
+            values = state->weights;
+        }
+        else if (strncmp (line, "best ", 5) == 0)
+        {
+            values = state->best_weights;
+        }
+
+        if ((values != NULL) &&
+            (sscanf (strchr (line, ' '), "%lf %lf %lf %lf", &values[0], &values[1], &values[2], &values[3]) ==
+             TUNER_NUM_WEIGHTS))
+        {
+            numFields++;
+        }
+    }
+
+    fclose (file);
+
+    if (numFields != 9)
+    {
+        return -1;
+    }
+
+    for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+    {
+        if (state->sigma[ii] <= 0.0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+
+}  // End of TunerLoadCheckpoint()
+
+
+int TunerRunGeneration (tunerState *state, const tunerConfig *config)
+{
+    double fitness[TUNER_MAX_POPULATION] = {0.0};
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    int kk = 0;  // Loop iterator
+    double mean = 0.0;
+    int numThreads = config->num_threads;
+    int order[TUNER_MAX_POPULATION] = {0};
+    CmtThreadPoolHandle pool = 0;
+    rngData seedRng;
+    double start = Timer ();
+    int status = 0;
+    int swap = 0;
+    double values[TUNER_MAX_POPULATION][TUNER_NUM_WEIGHTS];
+    double variance = 0.0;
+    void *workerData[TUNER_MAX_THREADS] = {NULL};
+
+    if ((config->population < 2) || (config->population > TUNER_MAX_POPULATION) ||
+        (config->num_elite < 1) || (config->num_elite > config->population) ||
+        (config->games < 1) || (config->games > TUNER_MAX_GAMES))
+    {
+        return -1;
+    }
+
+    // Candidate 0 is the mean, the rest are samples around it
+    for (ii=0; ii<config->population; ii++)
+    {
+        for (jj=0; jj<TUNER_NUM_WEIGHTS; jj++)
+        {
+            values[ii][jj] = state->mean[jj];
+            if (ii > 0)
+            {
+                values[ii][jj] += state->sigma[jj] * RngNormal (&state->rng);
+            }
+        }
+        Normalize (values[ii]);
+        ToWeights (values[ii], &tunerSharedJob.weights[ii]);
+    }
+
+    // Every candidate plays the same games, and the games change every generation
+    RngSeed (&seedRng, config->seed ^ (0x9E3779B97F4A7C15ULL * (state->generation + 1)));
+    for (ii=0; ii<config->games; ii++)
+    {
+        tunerSharedJob.seeds[ii] = ((unsigned long long)RngNext (&seedRng) << 32) | RngNext (&seedRng);
+    }
+
+    tunerSharedJob.config = config;
+    tunerSharedJob.num_candidates = config->population;
+    tunerSharedJob.num_items = config->population * config->games;
+    tunerSharedJob.next_item = 0;
+
+    if (numThreads <= 0)
+    {
+        numThreads = GetNumProcessors ();
+    }
+    if (numThreads > TUNER_MAX_THREADS)
+    {
+        numThreads = TUNER_MAX_THREADS;
+    }
+    if (numThreads > tunerSharedJob.num_items)
+    {
+        numThreads = tunerSharedJob.num_items;
+    }
+
+    if (CmtNewThreadPool (numThreads, &pool) < 0)
+    {
+        return -1;
+    }
+
+    // Every worker takes games from the shared job
+    for (ii=0; ii<numThreads; ii++)
+    {
+        workerData[ii] = &tunerSharedJob;
+    }
+    status = ThreadPoolRun (pool, TunerWorker, workerData, numThreads);
+
+    CmtDiscardThreadPool (pool);
+
+    if (status != 0)
+    {
+        return -1;
+    }
+
+    // Mean lines per candidate, then rank the candidates best first
+    for (ii=0; ii<tunerSharedJob.num_items; ii++)
+    {
+        fitness[ii % config->population] += tunerSharedJob.lines[ii];
+    }
+    for (ii=0; ii<config->population; ii++)
+    {
+        fitness[ii] /= config->games;
+        order[ii] = ii;
+
+        for (jj=ii; (jj > 0) && (fitness[order[jj]] > fitness[order[jj-1]]); jj--)
+        {
+            swap = order[jj];
+            order[jj] = order[jj-1];
+            order[jj-1] = swap;
+        }
+    }
+
+    for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+    {
+        state->weights[ii] = values[0][ii];
+    }
+    state->mean_lines = fitness[0];
+    state->best_lines = fitness[order[0]];
+
+    // The header gets the best candidate seen, not the mean the search is at
+    if (state->best_lines > state->best_fitness)
+    {
+        for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+        {
+            state->best_weights[ii] = values[order[0]][ii];
+        }
+        state->best_fitness = state->best_lines;
+    }
+
+    // Refit the distribution to the elite, with extra noise so it does not collapse early
+    for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+    {
+        mean = 0.0;
+        for (kk=0; kk<config->num_elite; kk++)
+        {
+            mean += values[order[kk]][ii];
+        }
+        mean /= config->num_elite;
+
+        variance = 0.0;
+        for (kk=0; kk<config->num_elite; kk++)
+        {
+            variance += (values[order[kk]][ii] - mean) * (values[order[kk]][ii] - mean);
+        }
+        variance /= config->num_elite;
+
+        state->mean[ii] = mean;
+        state->sigma[ii] = sqrt (variance) + config->extra_noise / (state->generation + 1);
+    }
+    Normalize (state->mean);
+
+    state->generation++;
+    state->games_played += tunerSharedJob.num_items;
+    state->seconds = Timer () - start;
+
+    return 0;
+
+}  // End of TunerRunGeneration()
+
+
+int TunerSaveCheckpoint (const tunerState *state, const char *path)
+{
+    FILE *file = NULL;
+    int ii = 0;  // Loop iterator
+    const char *names[4] = {"mean", "sigma", "weights", "best"};
+    const double *values[4] = {state->mean, state->sigma, state->weights, state->best_weights};
+    char tempPath[MAX_PATHNAME_LEN] = "\0";
+
+    // Write a new file and swap it in, so an interrupted save keeps the last checkpoint
+    if (strlen (path) + 5 > sizeof (tempPath))
+    {
+        return -1;
+    }
+    sprintf (tempPath, "%s.tmp", path);
+
+    file = fopen (tempPath, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf (file, "generation %d\n", state->generation);
+    fprintf (file, "rng %016llx\n", state->rng.state);
+    fprintf (file, "games %lld\n", state->games_played);
+    fprintf (file, "lines %.17g %.17g\n", state->mean_lines, state->best_lines);
+    fprintf (file, "fitness %.17g\n", state->best_fitness);
+    for (ii=0; ii<4; ii++)
+    {
+        fprintf (file, "%s %.17g %.17g %.17g %.17g\n", names[ii],
+                 values[ii][0], values[ii][1], values[ii][2], values[ii][3]);
+    }
+
+    if (fclose (file) != 0)
+    {
+        return -1;
+    }
+
+    // Replaces the old checkpoint in one step, there is no moment without one
+    return MoveFileEx (tempPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+
+}  // End of TunerSaveCheckpoint()
+
+
+int TunerWriteHeader (const tunerState *state, const tunerConfig *config, const char *path)
+{
+    FILE *file = NULL;
+
+    file = fopen (path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    fprintf (file, "//==============================================================================\n");
+    fprintf (file, "//\n");
+    fprintf (file, "// Title:       blockdrop_weights.h\n");
+    fprintf (file, "// Purpose:     Greedy policy weights used by BoardEvaluate().\n");
+    fprintf (file, "//\n");
+    fprintf (file, "//              Written by blockdrop_tools tune after generation %d. The\n",
+             state->generation);
+    fprintf (file, "//              best candidate so far cleared %.1f lines on average over\n",
+             state->best_fitness);
+    fprintf (file, "//              %d games of up to %d blocks.\n", config->games, config->max_pieces);
+    fprintf (file, "//\n");
+    fprintf (file, "//==============================================================================\n");
+    fprintf (file, "\n");
+    fprintf (file, "#ifndef __blockdrop_weights_H__\n");
+    fprintf (file, "#define __blockdrop_weights_H__\n");
+    fprintf (file, "\n");
+    fprintf (file, "//==============================================================================\n");
+    fprintf (file, "// Constants\n");
+    fprintf (file, "\n");
+    fprintf (file, "#define WEIGHT_HEIGHT           %.6f\n", state->best_weights[0]);
+    fprintf (file, "#define WEIGHT_LINES            %.6f\n", state->best_weights[1]);
+    fprintf (file, "#define WEIGHT_HOLES            %.6f\n", state->best_weights[2]);
+    fprintf (file, "#define WEIGHT_BUMPINESS        %.6f\n", state->best_weights[3]);
+    fprintf (file, "\n");
+    fprintf (file, "#endif  /* ndef __blockdrop_weights_H__ */\n");
+
+    return (fclose (file) == 0) ? 0 : -1;
+
+}  // End of TunerWriteHeader()
+
+
+static void Normalize (double values[TUNER_NUM_WEIGHTS])
+{
+    int ii = 0;  // Loop iterator
+    double length = 0.0;
+
+    for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+    {
+        length += values[ii] * values[ii];
+    }
+    length = sqrt (length);
+
+    if (length > 0.0)
+    {
+        for (ii=0; ii<TUNER_NUM_WEIGHTS; ii++)
+        {
+            values[ii] /= length;
+        }
+    }
+
+}  // End of Normalize()
+
+
+static int PlayGame (const weightData *weights, unsigned long long seed, int max_pieces)
+{
+    gameData game;
+    placementData placement = {0};
+
+    GameReset (&game, seed);
+
+    while ((game.game_status != GAME_END) && (game.pieces <= max_pieces))
+    {
+        if (ChooseGreedyPlacement (&game.board, game.piece.type_index, weights, &placement) == 0)
+        {
+            break;
+        }
+        GamePlace (&game, &placement);
+    }
+
+    return game.lines;
+
+}  // End of PlayGame()
+
+
+static double RngNormal (rngData *rng)
+{
+    double u1 = (RngNext (rng) + 0.5) / 4294967296.0;
+    double u2 = (RngNext (rng) + 0.5) / 4294967296.0;
+
+    // Box-Muller transform
+    return sqrt (-2.0 * log (u1)) * cos (2.0 * 3.14159265358979323846 * u2);
+
+}  // End of RngNormal()
+
+
+static void ToWeights (const double values[TUNER_NUM_WEIGHTS], weightData *weights)
+{
+    weights->height = values[0];
+    weights->lines = values[1];
+    weights->holes = values[2];
+    weights->bumpiness = values[3];
+
+}  // End of ToWeights()
+
+
+static int CVICALLBACK TunerWorker (void *functionData)
+{
+    tunerJob *job = (tunerJob *)functionData;
+    int candidate = 0;
+    int item = 0;
+
+    // Take the next game until none are left
+    for (item=InterlockedIncrement (&job->next_item) - 1; item < job->num_items;
+         item=InterlockedIncrement (&job->next_item) - 1)
+    {
+        candidate = item % job->num_candidates;
+        job->lines[item] = PlayGame (&job->weights[candidate], job->seeds[item / job->num_candidates],
+                                     job->config->max_pieces);
+    }
+
+    return 0;
+
+}  // End of TunerWorker()
@@ -0,0 +1,89 @@
+//==============================================================================
+//
+// Title:       blockdrop_tuner.h
+// Purpose:     Cross-entropy tuning of the greedy policy weights.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_tuner_H__
+#define __blockdrop_tuner_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define TUNER_NUM_WEIGHTS       4       // Members of weightData
+#define TUNER_MAX_THREADS       256
+#define TUNER_MAX_POPULATION    256
+#define TUNER_MAX_GAMES         1024
+
+#define TUNER_DEFAULT_POPULATION    32
+#define TUNER_DEFAULT_ELITE         8
+#define TUNER_DEFAULT_GAMES         16
+#define TUNER_DEFAULT_MAX_PIECES    20000   // Rarely reached, so the lines still rank the candidates
+#define TUNER_DEFAULT_SIGMA         0.25
+#define TUNER_DEFAULT_NOISE         0.05    // Added to sigma, shrinks every generation
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_threads;            // 0 uses one thread per processor
+    int population;             // Candidates per generation, including the current mean
+    int num_elite;              // Best candidates the next distribution is fitted to
+    int games;                  // Games per candidate, the same seeds for every candidate
+    int max_pieces;             // Blocks per game before it is stopped
+    double initial_sigma;
+    double extra_noise;
+    unsigned long long seed;
+} tunerConfig;
+
+typedef struct
+{
+    int generation;                         // Generations completed
+    rngData rng;                            // Samples the candidates
+    double mean[TUNER_NUM_WEIGHTS];         // Same order as weightData
+    double sigma[TUNER_NUM_WEIGHTS];
+    double weights[TUNER_NUM_WEIGHTS];      // Mean played in the last generation
+    double mean_lines;                      // Mean lines of those weights
+    double best_lines;                      // Mean lines of the best candidate in the last generation
+    double best_weights[TUNER_NUM_WEIGHTS]; // Best candidate of all generations
+    double best_fitness;                    // Mean lines of those weights, on the games of their generation
+    long long games_played;
+    double seconds;                         // Time spent in the last generation
+} tunerState;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int TunerCreate (tunerState *state, const tunerConfig *config);
+
+void TunerDefaultConfig (tunerConfig *config);
+
+int TunerLoadCheckpoint (tunerState *state, const char *path);
+
+int TunerRunGeneration (tunerState *state, const tunerConfig *config);
+
+int TunerSaveCheckpoint (const tunerState *state, const char *path);
+
+int TunerWriteHeader (const tunerState *state, const tunerConfig *config, const char *path);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_tuner_H__ */
@@ -0,0 +1,203 @@
+//==============================================================================
+//
+// Title:       blockdrop_variant.c
+// Purpose:     Board size variants with a row mask type chosen per width.
+//
+//              The board functions are generated from blockdrop_board.h. The
+//              engine is its instance for the standard board, unsigned short
+//              rows at the fixed GRID_NUM_COLS by GRID_NUM_ROWS size, and plays
+//              that board. Other sizes are played by the instances generated
+//              through blockdrop_variant_board.h, one per row mask type: 16,
+//              32 and 64 bit rows for boards up to 16, 32 and 64 columns.
+//              Every row of a board is one mask of the narrowest type it fits
+//              in, so fits, locks, line clears and evaluation stay single mask
+//              operations per row on any size.
+//
+//              VariantSelect() picks the instance at run time from the board
+//              size, preferring the engine for the standard board, and
+//              VariantPlay() plays greedy games with it.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_variant.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static int BitCount (unsigned long long value);
+
+static int PlayStandardGame (const variantConfig *config, int game_index, variantStats *stats);
+
+// Board models, see blockdrop_variant_board.h
+
+#define VARIANT_ROW             unsigned short
+#define VARIANT_BITS            16
+#define VARIANT_NAME(name)      name##16
+#include "blockdrop_variant_board.h"
+#undef VARIANT_ROW
+#undef VARIANT_BITS
+#undef VARIANT_NAME
+
+#define VARIANT_ROW             unsigned int
+#define VARIANT_BITS            32
+#define VARIANT_NAME(name)      name##32
+#include "blockdrop_variant_board.h"
+#undef VARIANT_ROW
+#undef VARIANT_BITS
+#undef VARIANT_NAME
+
+#define VARIANT_ROW             unsigned long long
+#define VARIANT_BITS            64
+#define VARIANT_NAME(name)      name##64
+#include "blockdrop_variant_board.h"
+#undef VARIANT_ROW
+#undef VARIANT_BITS
+#undef VARIANT_NAME
+
+//==============================================================================
+// Global variables
+
+// Searched in order, the first one that holds the board plays it
+const boardVariant g_boardVariants[] =
+{
+    {"standard", GRID_NUM_COLS, GRID_NUM_ROWS,    1, PlayStandardGame},
+    {"uint16",   16,            VARIANT_MAX_ROWS, 0, PlayGame16},
+    {"uint32",   32,            VARIANT_MAX_ROWS, 0, PlayGame32},
+    {"uint64",   64,            VARIANT_MAX_ROWS, 0, PlayGame64}
+};
+
+const int g_numBoardVariants = sizeof (g_boardVariants) / sizeof (g_boardVariants[0]);
+
+//==============================================================================
+// Global functions
+
+void VariantDefaultConfig (variantConfig *config)
+{
+    memset (config, 0, sizeof (variantConfig));
+
+    config->num_cols = GRID_NUM_COLS;
+    config->num_rows = GRID_NUM_ROWS;
+    config->num_games = 100;
+    config->max_pieces = 1000;
+    config->seed = 1;
+    config->weights = g_defaultWeights;
+
+}  // End of VariantDefaultConfig()
+
+
+int VariantPlay (const variantConfig *config, variantStats *stats)
+{
+    int ii = 0;  // Loop iterator
+    const boardVariant *variant = NULL;
+
+    memset (stats, 0, sizeof (variantStats));
+
+    variant = VariantSelect (config->num_cols, config->num_rows, config->mode);
+    if ((variant == NULL) || (config->num_games < 1) || (config->max_pieces < 1))
+    {
+        return -1;
+    }
+
+    stats->mode = variant->name;
+    stats->seconds = Timer ();
+    for (ii=0; ii<config->num_games; ii++)
+    {
+        variant->play_game (config, ii, stats);
+        stats->games++;
+    }
+    stats->seconds = Timer () - stats->seconds;
+
+    return 0;
+
+}  // End of VariantPlay()
+
+
+const boardVariant *VariantSelect (int num_cols, int num_rows, const char *mode)
+{
+    int ii = 0;  // Loop iterator
+    const boardVariant *variant = NULL;
+
+    if ((num_cols < VARIANT_MIN_COLS) || (num_rows < VARIANT_MIN_ROWS))
+    {
+        return NULL;
+    }
+
+    for (ii=0; ii<g_numBoardVariants; ii++)
+    {
+        variant = &g_boardVariants[ii];
+        if ((mode != NULL) && (strcmp (mode, variant->name) != 0))
+        {
+            continue;
+        }
+
+        if (variant->exact)
+        {
+            if ((num_cols == variant->max_cols) && (num_rows == variant->max_rows))
+            {
+                return variant;
+            }
+        }
+        else if ((num_cols <= variant->max_cols) && (num_rows <= variant->max_rows))
+        {
+            return variant;
+        }
+    }
+
+    return NULL;
+
+}  // End of VariantSelect()
+
+
+static int BitCount (unsigned long long value)
+{
+    int count = 0;
+
+    while (value != 0)
+    {
+        value &= value - 1;
+        count++;
+    }
+
+    return count;
+
+}  // End of BitCount()
+
+
+static int PlayStandardGame (const variantConfig *config, int game_index, variantStats *stats)
+{
+    gameData game;
+    int numPieces = 0;
+    placementData placement = {0};
+
+    GameReset (&game, config->seed + game_index);
+
+    while ((game.game_status == GAME_RUN) && (numPieces < config->max_pieces))
+    {
+        if (ChooseGreedyPlacement (&game.board, game.piece.type_index, &config->weights, &placement) == 0)
+        {
+            break;
+        }
+
+        stats->lines += GamePlace (&game, &placement);
+        numPieces++;
+    }
+
+    stats->pieces += numPieces;
+
+    return 0;
+
+}  // End of PlayStandardGame()
@@ -0,0 +1,82 @@
+//==============================================================================
+//
+// Title:       blockdrop_variant.h
+// Purpose:     Board size variants with a row mask type chosen per width.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_variant_H__
+#define __blockdrop_variant_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define VARIANT_MIN_COLS        4
+#define VARIANT_MAX_COLS        64
+#define VARIANT_MIN_ROWS        8       // Blocks spawn in the top rows
+#define VARIANT_MAX_ROWS        64
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_cols;
+    int num_rows;
+    const char *mode;           // Instance to play with, NULL picks the fastest one for the size
+    int num_games;
+    int max_pieces;             // Blocks per game before it is stopped
+    unsigned long long seed;    // Game n uses seed + n
+    weightData weights;         // Greedy policy
+} variantConfig;
+
+typedef struct
+{
+    const char *mode;           // Instance that played
+    long long games;
+    long long pieces;           // Blocks locked
+    long long lines;
+    double seconds;
+} variantStats;
+
+typedef struct
+{
+    const char *name;
+    int max_cols;
+    int max_rows;
+    int exact;                  // Only for boards of exactly max_cols by max_rows
+    int (*play_game) (const variantConfig *config, int game_index, variantStats *stats);
+} boardVariant;
+
+//==============================================================================
+// External variables
+
+extern const boardVariant g_boardVariants[];
+
+extern const int g_numBoardVariants;
+
+//==============================================================================
+// Global functions
+
+void VariantDefaultConfig (variantConfig *config);
+
+int VariantPlay (const variantConfig *config, variantStats *stats);
+
+const boardVariant *VariantSelect (int num_cols, int num_rows, const char *mode);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_variant_H__ */
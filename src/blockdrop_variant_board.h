@@ -0,0 +1,160 @@
+//==============================================================================
+//
+// Title:       blockdrop_variant_board.h
+// Purpose:     Greedy games on a board instantiated once per row mask type.
+//
+//              Included by blockdrop_variant.c with these macros defined, and
+//              therefore without an include guard:
+//
+//                  VARIANT_ROW         Unsigned type of a row mask
+//                  VARIANT_BITS        Bits in VARIANT_ROW, the widest board
+//                  VARIANT_NAME(name)  name with the instance suffix appended
+//
+//              The board functions are generated from blockdrop_board.h, the
+//              same template the engine functions are, with the board size
+//              taken from the board instead of GRID_NUM_COLS and GRID_NUM_ROWS.
+//              This adds the greedy policy and the game loop on top. Blocks
+//              spawn centered on the board at the spawn row of the engine, so a
+//              10 column instance plays the same games as the engine.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+typedef struct
+{
+    VARIANT_ROW rows[VARIANT_MAX_ROWS];
+    VARIANT_ROW full;                   // Mask of a full row
+    int num_cols;
+    int num_rows;
+} VARIANT_NAME (variantBoard);
+
+
+// BoardClearLines(), BoardEvaluate(), BoardLockPiece() and PieceFits() of the instance, see blockdrop_board.h
+
+#define BOARD_ROW               VARIANT_ROW
+#define BOARD_TYPE              VARIANT_NAME (variantBoard)
+#define BOARD_NAME(name)        VARIANT_NAME (name)
+#define BOARD_LINKAGE           static
+#define BOARD_COLS(board)       ((board)->num_cols)
+#define BOARD_ROWS(board)       ((board)->num_rows)
+#define BOARD_FULL(board)       ((board)->full)
+#define BOARD_MAX_COLS          VARIANT_MAX_COLS
+#include "blockdrop_board.h"
+#undef BOARD_ROW
+#undef BOARD_TYPE
+#undef BOARD_NAME
+#undef BOARD_LINKAGE
+#undef BOARD_COLS
+#undef BOARD_ROWS
+#undef BOARD_FULL
+#undef BOARD_MAX_COLS
+
+
+static int VARIANT_NAME (PieceSpawn) (const VARIANT_NAME (variantBoard) *board, int type_index, pieceData *piece)
+{
+    PieceSpawn (type_index, piece);
+
+    // Same distance from the center as on the standard board
+    piece->x += (board->num_cols - GRID_NUM_COLS) / 2;
+    if (piece->x < 0)
+    {
+        piece->x = 0;
+    }
+
+    return 0;
+
+}  // End of PieceSpawn()
+
+
+static int VARIANT_NAME (ChooseGreedyPlacement) (const VARIANT_NAME (variantBoard) *board, int type_index,
+                                                 const weightData *weights, pieceData *best)
+{
+    VARIANT_NAME (variantBoard) after;
+    double bestScore = 0.0;
+    int jj = 0;  // Loop iterator
+    int linesCleared = 0;
+    int numPlacements = 0;
+    pieceData piece = {0};
+    pieceData rotated = {0};
+    double score = 0.0;
+    int top = 0;
+
+    // Same order as EnumeratePlacements(): rotate at the spawn row, then shift and drop straight down
+    VARIANT_NAME (PieceSpawn) (board, type_index, &rotated);
+    do
+    {
+        piece = rotated;
+        top = (rotated.y < 0) ? 0 : rotated.y;
+
+        for (jj=0; jj<=board->num_cols-g_pieceShapes[type_index][piece.orientation].width; jj++)
+        {
+            piece.x = jj;
+            piece.y = top;
+            if (VARIANT_NAME (PieceFits) (board, &piece) == 0)
+            {
+                continue;
+            }
+
+            do
+            {
+                piece.y++;
+            } while (VARIANT_NAME (PieceFits) (board, &piece) == 1);
+            piece.y--;
+
+            after = *board;
+            linesCleared = VARIANT_NAME (BoardLockPiece) (&after, &piece);
+            score = VARIANT_NAME (BoardEvaluate) (&after, linesCleared, weights);
+
+            if ((numPlacements == 0) || (score > bestScore))
+            {
+                bestScore = score;
+                *best = piece;
+            }
+            numPlacements++;
+        }
+    } while ((PieceRotateShape (&rotated, ROTATE_CW) == 1) && (rotated.orientation != 0));
+
+    return numPlacements;
+
+}  // End of ChooseGreedyPlacement()
+
+
+static int VARIANT_NAME (PlayGame) (const variantConfig *config, int game_index, variantStats *stats)
+{
+    VARIANT_NAME (variantBoard) board;
+    int numPieces = 0;
+    pieceData piece = {0};
+    pieceData placed = {0};
+    rngData rng;
+    int type_index = 0;
+
+    memset (&board, 0, sizeof (board));
+    board.num_cols = config->num_cols;
+    board.num_rows = config->num_rows;
+    board.full = (VARIANT_ROW)((VARIANT_ROW)~(VARIANT_ROW)0 >> (VARIANT_BITS - config->num_cols));
+
+    // Same block sequence as GameReset() and GameSpawnPiece()
+    RngSeed (&rng, config->seed + game_index);
+    type_index = RngRange (&rng, NUM_BLOCKS_TYPES - 2);
+
+    while (numPieces < config->max_pieces)
+    {
+        VARIANT_NAME (PieceSpawn) (&board, type_index, &piece);
+        if ((VARIANT_NAME (PieceFits) (&board, &piece) == 0) ||
+            (VARIANT_NAME (ChooseGreedyPlacement) (&board, type_index, &config->weights, &placed) == 0))
+        {
+            break;
+        }
+
+        stats->lines += VARIANT_NAME (BoardLockPiece) (&board, &placed);
+        numPieces++;
+
+        type_index = RngRange (&rng, NUM_BLOCKS_TYPES);
+    }
+
+    stats->pieces += numPieces;
+
+    return 0;
+
+}  // End of PlayGame()
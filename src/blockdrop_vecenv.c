@@ -0,0 +1,401 @@
+//==============================================================================
+//
+// Title:       blockdrop_vecenv.c
+// Purpose:     Batched headless games for reinforcement learning.
+//
+//              VecEnvStep() advances every game by one action and writes the
+//              observations, rewards and done flags straight into the arrays
+//              of the caller. Games are split into one contiguous shard per
+//              thread. A finished game is reset right away, so its done flag
+//              comes with the first observation of the next game, like the
+//              vectorized environments of the common RL libraries.
+//
+//              The reward is the number of lines cleared by the step. A
+//              placement that is not in the legal mask ends the game.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_vecenv.h"
+
+//==============================================================================
+// Constants
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    gameData game;
+    rngData seeder;                         // Seeds each new game of this slot
+    int steps;
+    signed char drop_rows[MAX_PLACEMENTS];  // Landing row per placement action, -1 when not legal
+} vecSlot;
+
+typedef struct
+{
+    vecEnvData *env;
+    int first;
+    int last;
+    char padding[64];  // Keep shards on separate cache lines
+} vecShard;
+
+struct vecEnvData
+{
+    vecEnvConfig config;
+    int num_threads;
+    CmtThreadPoolHandle pool;
+    vecSlot *slots;
+    vecShard shards[VECENV_MAX_THREADS];
+
+    // Arguments of the current call, actions is NULL for a reset
+    const int *actions;
+    vecObservation *obs;
+    float *rewards;
+    unsigned char *dones;
+};
+
+//==============================================================================
+// Static global variables
+
+//==============================================================================
+// Static functions
+
+static void ResetSlot (vecSlot *slot);
+
+static int RunShards (vecEnvData *env);
+
+static int StepInput (gameData *game, int action);
+
+static void StepSlot (vecEnvData *env, int index);
+
+static int CVICALLBACK VecEnvWorker (void *functionData);
+
+static void WriteObservation (const vecEnvData *env, vecSlot *slot, vecObservation *obs);
+
+//==============================================================================
+// Global variables
+
+//==============================================================================
+// Global functions
+
+int VecEnvCreate (const vecEnvConfig *config, vecEnvData **env)
+{
+    int ii = 0;  // Loop iterator
+    vecEnvData *newEnv = NULL;
+    int numThreads = config->num_threads;
+
+    *env = NULL;
+
+    if ((config->num_envs < 1) ||
+        ((config->action_mode != VECENV_ACTION_PLACEMENT) && (config->action_mode != VECENV_ACTION_INPUT)))
+    {
+        return -1;
+    }
+
+    newEnv = calloc (1, sizeof (vecEnvData));
+    if (newEnv == NULL)
+    {
+        return -1;
+    }
+
+    newEnv->config = *config;
+    newEnv->slots = calloc (config->num_envs, sizeof (vecSlot));
+    if (newEnv->slots == NULL)
+    {
+        free (newEnv);
+        return -1;
+    }
+
+    // Seeds depend on the slot only, so results do not change with the thread count
+    for (ii=0; ii<config->num_envs; ii++)
+    {
+        RngSeed (&newEnv->slots[ii].seeder, config->seed + ii);
+    }
+
+    if (numThreads <= 0)
+    {
+        numThreads = GetNumProcessors ();
+    }
+    if (numThreads > VECENV_MAX_THREADS)
+    {
+        numThreads = VECENV_MAX_THREADS;
+    }
+    if (numThreads > config->num_envs)
+    {
+        numThreads = config->num_envs;
+    }
+    newEnv->num_threads = numThreads;
+
+    for (ii=0; ii<numThreads; ii++)
+    {
+        newEnv->shards[ii].env = newEnv;
+        newEnv->shards[ii].first = (int)((long long)config->num_envs * ii / numThreads);
+        newEnv->shards[ii].last = (int)((long long)config->num_envs * (ii + 1) / numThreads);
+    }
+
+    // A single shard runs on the calling thread
+    if ((numThreads > 1) && (CmtNewThreadPool (numThreads, &newEnv->pool) < 0))
+    {
+        free (newEnv->slots);
+        free (newEnv);
+        return -1;
+    }
+
+    *env = newEnv;
+
+    return 0;
+
+}  // End of VecEnvCreate()
+
+
+void VecEnvDefaultConfig (vecEnvConfig *config)
+{
+    memset (config, 0, sizeof (vecEnvConfig));
+
+    config->num_envs = 256;
+    config->action_mode = VECENV_ACTION_PLACEMENT;
+    config->seed = 1;
+
+}  // End of VecEnvDefaultConfig()
+
+
+void VecEnvDiscard (vecEnvData *env)
+{
+    if (env == NULL)
+    {
+        return;
+    }
+
+    if (env->pool != 0)
+    {
+        CmtDiscardThreadPool (env->pool);
+    }
+
+    free (env->slots);
+    free (env);
+
+}  // End of VecEnvDiscard()
+
+
+int VecEnvReset (vecEnvData *env, vecObservation obs[])
+{
+    env->actions = NULL;
+    env->obs = obs;
+    env->rewards = NULL;
+    env->dones = NULL;
+
+    return RunShards (env);
+
+}  // End of VecEnvReset()
+
+
+int VecEnvStep (vecEnvData *env, const int actions[], vecObservation obs[], float rewards[],
+                unsigned char dones[])
+{
+    env->actions = actions;
+    env->obs = obs;
+    env->rewards = rewards;
+    env->dones = dones;
+
+    return RunShards (env);
+
+}  // End of VecEnvStep()
+
+
+static void ResetSlot (vecSlot *slot)
+{
+    unsigned long long seed = 0;
+
+    seed = ((unsigned long long)RngNext (&slot->seeder) << 32) | RngNext (&slot->seeder);
+    GameReset (&slot->game, seed);
+    slot->steps = 0;
+
+}  // End of ResetSlot()
+
+
+static int RunShards (vecEnvData *env)
+{
+    int ii = 0;  // Loop iterator
+    void *shardData[VECENV_MAX_THREADS] = {NULL};
+
+    if (env->num_threads == 1)
+    {
+        return VecEnvWorker (&env->shards[0]);
+    }
+
+    for (ii=0; ii<env->num_threads; ii++)
+    {
+        shardData[ii] = &env->shards[ii];
+    }
+
+    return ThreadPoolRun (env->pool, VecEnvWorker, shardData, env->num_threads);
+
+}  // End of RunShards()
+
+
+static int StepInput (gameData *game, int action)
+{
+    placementData placement = {0};
+
+    switch (action)
+    {
+        case VECENV_INPUT_LEFT:
+            PieceMove (&game->board, &game->piece, -1, 0);
+            break;
+        case VECENV_INPUT_RIGHT:
+            PieceMove (&game->board, &game->piece, 1, 0);
+            break;
+        case VECENV_INPUT_CW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CW);
+            break;
+        case VECENV_INPUT_CCW:
+            PieceRotate (&game->board, &game->piece, ROTATE_CCW);
+            break;
+        case VECENV_INPUT_DOWN:
+            PieceMove (&game->board, &game->piece, 0, 1);
+            break;
+    }
+
+    // Gravity, the block locks where it is once it cannot fall
+    if (PieceMove (&game->board, &game->piece, 0, 1) == 1)
+    {
+        return 0;
+    }
+
+    placement.orientation = game->piece.orientation;
+    placement.x = game->piece.x;
+    placement.y = game->piece.y;
+
+    return GamePlace (game, &placement);
+
+}  // End of StepInput()
+
+
+static void StepSlot (vecEnvData *env, int index)
+{
+    int action = env->actions[index];
+    int lines = 0;
+    placementData placement = {0};
+    vecSlot *slot = &env->slots[index];
+
+    if (env->config.action_mode == VECENV_ACTION_PLACEMENT)
+    {
+        if ((action < 0) || (action >= MAX_PLACEMENTS) || (slot->drop_rows[action] < 0))
+        {
+            slot->game.game_status = GAME_END;
+        }
+        else
+        {
+            placement.orientation = action / GRID_NUM_COLS;
+            placement.x = action % GRID_NUM_COLS;
+            placement.y = slot->drop_rows[action];
+            lines = GamePlace (&slot->game, &placement);
+        }
+    }
+    else
+    {
+        lines = StepInput (&slot->game, action);
+    }
+
+    slot->steps++;
+    env->rewards[index] = (float)lines;
+    env->dones[index] = 0;
+
+    if ((slot->game.game_status == GAME_END) ||
+        ((env->config.max_steps > 0) && (slot->steps >= env->config.max_steps)))
+    {
+        env->dones[index] = 1;
+        ResetSlot (slot);
+    }
+
+}  // End of StepSlot()
+
+
+static int CVICALLBACK VecEnvWorker (void *functionData)
+{
+    vecShard *shard = (vecShard *)functionData;
+    vecEnvData *env = shard->env;
+    int ii = 0;  // Loop iterator
+
+    for (ii=shard->first; ii<shard->last; ii++)
+    {
+        if (env->actions == NULL)
+        {
+            ResetSlot (&env->slots[ii]);
+        }
+        else
+        {
+            StepSlot (env, ii);
+        }
+
+        WriteObservation (env, &env->slots[ii], &env->obs[ii]);
+    }
+
+    return 0;
+
+}  // End of VecEnvWorker()
+
+
+static void WriteObservation (const vecEnvData *env, vecSlot *slot, vecObservation *obs)
+{
+    int action = 0;
+    const gameData *game = &slot->game;
+    int ii = 0;  // Loop iterator
+    int numPlacements = 0;
+    placementData placements[MAX_PLACEMENTS];
+    pieceData piece = game->piece;
+    rngData preview = game->rng;
+
+    obs->legal = 0;
+    obs->lines = game->lines;
+    obs->pieces = game->pieces;
+    obs->level = game->level;
+    obs->steps = slot->steps;
+    memcpy (obs->rows, game->board.rows, sizeof (obs->rows));
+    obs->type_index = (signed char)piece.type_index;
+    obs->orientation = (signed char)piece.orientation;
+    obs->x = (signed char)piece.x;
+    obs->y = (signed char)piece.y;
+
+    // The next blocks come from the same generator as GameSpawnPiece()
+    for (ii=0; ii<VECENV_NUM_PREVIEW; ii++)
+    {
+        obs->preview[ii] = (signed char)RngRange (&preview, NUM_BLOCKS_TYPES);
+    }
+
+    if (env->config.action_mode == VECENV_ACTION_PLACEMENT)
+    {
+        memset (slot->drop_rows, -1, sizeof (slot->drop_rows));
+
+        numPlacements = EnumeratePlacements (&game->board, piece.type_index, placements);
+        for (ii=0; ii<numPlacements; ii++)
+        {
+            action = placements[ii].orientation * GRID_NUM_COLS + placements[ii].x;
+            slot->drop_rows[action] = (signed char)placements[ii].y;
+            obs->legal |= 1ULL << action;
+        }
+    }
+    else
+    {
+        // Doing nothing is always possible, the other inputs only when the block can move
+        obs->legal = 1ULL << VECENV_INPUT_NONE;
+        for (ii=VECENV_INPUT_LEFT; ii<=VECENV_INPUT_DOWN; ii++)
+        {
+            piece = game->piece;
+            if (((ii == VECENV_INPUT_LEFT) && PieceMove (&game->board, &piece, -1, 0)) ||
+                ((ii == VECENV_INPUT_RIGHT) && PieceMove (&game->board, &piece, 1, 0)) ||
+                ((ii == VECENV_INPUT_CW) && PieceRotate (&game->board, &piece, ROTATE_CW)) ||
+                ((ii == VECENV_INPUT_CCW) && PieceRotate (&game->board, &piece, ROTATE_CCW)) ||
+                ((ii == VECENV_INPUT_DOWN) && PieceMove (&game->board, &piece, 0, 1)))
+            {
+                obs->legal |= 1ULL << ii;
+            }
+        }
+    }
+
+}  // End of WriteObservation()
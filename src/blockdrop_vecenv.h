@@ -0,0 +1,93 @@
+//==============================================================================
+//
+// Title:       blockdrop_vecenv.h
+// Purpose:     Batched headless games for reinforcement learning.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_vecenv_H__
+#define __blockdrop_vecenv_H__
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+//==============================================================================
+// Include files
+
+#include "blockdrop_engine.h"
+
+//==============================================================================
+// Constants
+
+#define VECENV_MAX_THREADS      64
+#define VECENV_NUM_PREVIEW      4       // Upcoming blocks in each observation
+
+// Action modes
+#define VECENV_ACTION_PLACEMENT 0       // orientation * GRID_NUM_COLS + x, then drop straight down
+#define VECENV_ACTION_INPUT     1       // One VECENV_INPUT_ per step, then gravity moves one row
+
+// Actions in VECENV_ACTION_INPUT mode
+#define VECENV_INPUT_NONE       0
+#define VECENV_INPUT_LEFT       1
+#define VECENV_INPUT_RIGHT      2
+#define VECENV_INPUT_CW         3
+#define VECENV_INPUT_CCW        4
+#define VECENV_INPUT_DOWN       5
+
+#define VECENV_NUM_ACTIONS(mode)    (((mode) == VECENV_ACTION_PLACEMENT) ? MAX_PLACEMENTS : 6)
+
+//==============================================================================
+// Types
+
+typedef struct
+{
+    int num_envs;
+    int num_threads;            // 0 uses one thread per processor
+    int action_mode;            // VECENV_ACTION_PLACEMENT or VECENV_ACTION_INPUT
+    int max_steps;              // Steps before a game is cut off, 0 for no limit
+    unsigned long long seed;
+} vecEnvConfig;
+
+// Fixed 80 byte layout so learners can map an array of them directly
+typedef struct
+{
+    unsigned long long legal;               // Bit per action that can be taken
+    int lines;
+    int pieces;
+    int level;
+    int steps;                              // Steps since the game was reset
+    unsigned short rows[GRID_NUM_ROWS];     // Stack without the active block, see boardData
+    signed char type_index;                 // Active block, see pieceData
+    signed char orientation;
+    signed char x;
+    signed char y;
+    signed char preview[VECENV_NUM_PREVIEW];
+} vecObservation;
+
+typedef struct vecEnvData vecEnvData;
+
+//==============================================================================
+// External variables
+
+//==============================================================================
+// Global functions
+
+int VecEnvCreate (const vecEnvConfig *config, vecEnvData **env);
+
+void VecEnvDefaultConfig (vecEnvConfig *config);
+
+void VecEnvDiscard (vecEnvData *env);
+
+int VecEnvReset (vecEnvData *env, vecObservation obs[]);
+
+int VecEnvStep (vecEnvData *env, const int actions[], vecObservation obs[], float rewards[],
+                unsigned char dones[]);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* ndef __blockdrop_vecenv_H__ */
@@ -0,0 +1,24 @@
+//==============================================================================
+//
+// Title:       blockdrop_weights.h
+// Purpose:     Greedy policy weights used by BoardEvaluate().
+//
+//              Hand picked values. Run blockdrop_tools tune to replace this
+//              file with tuned weights.
+//
+// Created on:  10/19/2026
+//
+//==============================================================================
+
+#ifndef __blockdrop_weights_H__
+#define __blockdrop_weights_H__
+
+//==============================================================================
+// Constants
+
+#define WEIGHT_HEIGHT           -0.510066
+#define WEIGHT_LINES            0.760666
+#define WEIGHT_HOLES            -0.35663
+#define WEIGHT_BUMPINESS        -0.184483
+
+#endif  /* ndef __blockdrop_weights_H__ */
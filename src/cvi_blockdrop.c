@@ -11,10 +11,21 @@
 // Include files
 
 #include "cvi_blockdrop.h"
+#include "blockdrop_latency.h"
+#include "blockdrop_lockstat.h"
+#include "blockdrop_metrics.h"
+#include "blockdrop_montecarlo.h"
+#include "blockdrop_piece.h"
+#include "blockdrop_snapshot.h"
+#include "blockdrop_trace.h"
 
 //==============================================================================
 // Constants
 
+#define LATENCY_DUMP_FILE       "latency.txt"
+#define LATENCY_OVERLAY_PERIOD  0.25  // seconds between overlay updates
+#define METRICS_PUBLISH_PERIOD  0.5   // seconds between metrics snapshots
+
 //==============================================================================
 // Types
 
@@ -24,17 +35,51 @@ static int main_ph = 0;  // Main panel handle
 
 static blockData block = {0};
 
-static CmtThreadLockHandle threadLock = 0;
+static statLock threadLock;  // Guards block, records wait and hold times per call site
 
 static int g_keydown = 0;
 
+static unsigned long long g_keyTime = 0;  // Arrival of the key press the next move or rotation is for, 0 for none
+
 static double g_speed = NORMAL_SPEED;
 
 static int g_startBlock = BLOCK_RANDOM;  // Normally BLOCK_RANDOM
 
+static int g_latencyOverlay = 0;  // Latency overlay control, 0 when hidden
+
+static metricsData *g_metrics = NULL;  // Shared memory for monitors, NULL when not published
+
+static metricsSnapshot g_counters = {0};
+
+static double g_lastTick = 0.0;  // Time of the last timer tick, 0 after the timer was started
+
+static rngData g_rng = {0};  // Block generator, saved with the game
+
+static snapshotWriter *g_autosave = NULL;  // Saves the game in the background, NULL when not saved
+
+static snapshotData g_snapshot = {0};  // Locked cells and counters, kept up to date as blocks lock
+
 //==============================================================================
 // Static functions
 
+static int DrawGrid (unsigned long long input_time);
+
+static int DumpLatency (void);
+
+static int GetGameState (gameData *game);
+
+static int PublishMetrics (int force);
+
+static int RecordKeyInput (unsigned long long key_time);
+
+static int RestoreGame (void);
+
+static int ShowHint (void);
+
+static int ToggleLatencyOverlay (void);
+
+static int UpdateAutosave (void);
+
 //==============================================================================
 // Global variables
 
@@ -50,8 +95,14 @@ int main (int argc, char *argv[])
     {
         return -1;    /* out of memory */
     }
+    
+    TRACE_START ();
+    
+    // Monitors are optional, the game runs the same without them
+    g_counters.game_status = GAME_END;
+    MetricsCreate (METRICS_DEFAULT_NAME, &g_metrics);
         
-    status = CmtNewLock (NULL, 0, &threadLock);
+    status = StatLockCreate (&threadLock);
     if (status != 0)
     {
         MessagePopup ("Error", "Unable to create a new thread lock.");
@@ -76,6 +127,10 @@ int main (int argc, char *argv[])
         return -1;   
     }
     
+    // Continue a game the last run did not finish, e.g. after a crash
+    RestoreGame ();
+    SnapshotWriterOpen (SNAPSHOT_DEFAULT_FILE, SNAPSHOT_DEFAULT_PERIOD, &g_autosave);
+    
     RunUserInterface ();
         
     if (main_ph > 0)
@@ -94,18 +149,27 @@ int AdvanceBlock (void)
     int block_stop = 0;  // Flag to stop the active block
     int color = VAL_WHITE;
     int game_status = GAME_RUN;
-    int gotLock = 0;
     int ii = 0;  // Loop iterator
+    unsigned long long start = LatencyNow ();
     int status = 0;
         
-    status = CmtGetLockEx (threadLock, 0, CMT_WAIT_FOREVER, &gotLock);
+    TRACE_BEGIN ("AdvanceBlock");
+    
+    status = STAT_LOCK_GET (&threadLock);
     if (status != 0)
     {
+        LatencyRecord (LATENCY_STAGE_STEP, start);
+        TRACE_END ("AdvanceBlock");
         MessagePopup ("Error", "Unable to get thread lock.");
         return -1;
     }
+    
+    g_counters.ticks++;
         
-    // Check for block stop conditions
+    // Check for block stop conditions. The block falls one row per tick, so
+    // this reads only the cells under its low points. The table is the only
+    // copy of the board here, a column view would have to be built from it
+    // first and cost more than these few cells.
     for (ii=0; ii<block.num_low_points; ii++)
     {        
         // Active block reached the bottom
@@ -132,6 +196,7 @@ int AdvanceBlock (void)
         // Turn off timer
         SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_ENABLED, 0);
         
+        SnapshotLockBlock (&g_snapshot, &block);
         CheckForLineClears ();
         
         // Spawn a new block       
@@ -145,7 +210,10 @@ int AdvanceBlock (void)
             // Show game over text
             SetCtrlAttribute (main_ph, PNLMAIN_TEXTGAMEOVER, ATTR_VISIBLE, 1);
             
+            TRACE_BEGIN ("PlaySound");
             PlaySound (SFX_GAME_OVER, NULL, SND_FILENAME | SND_ASYNC);
+            TRACE_END ("PlaySound");
+            g_counters.sounds++;
           
             // Dim buttons
             SetCtrlAttribute (main_ph, PNLMAIN_BTNPAUSE, ATTR_DIMMED, 1);
@@ -182,13 +250,18 @@ int AdvanceBlock (void)
         }              
     }
     
-    status = CmtReleaseLock (threadLock);
+    status = StatLockRelease (&threadLock);
     if (status != 0)
     {
+        LatencyRecord (LATENCY_STAGE_STEP, start);
+        TRACE_END ("AdvanceBlock");
         MessagePopup ("Error", "Unable to release thread lock.");
         return -1;
     }    
     
+    LatencyRecord (LATENCY_STAGE_STEP, start);
+    TRACE_END ("AdvanceBlock");
+
     return 0;    
 
 }  // End of AdvanceBlock()
@@ -226,18 +299,24 @@ int CVICALLBACK CB_BtnMoveLeft (int panel, int control, int event,
                                 void *callbackData, int eventData1, int eventData2)
 {
     int colors[NUM_SQUARES_PER_BLOCK] = { VAL_WHITE, VAL_WHITE, VAL_WHITE, VAL_WHITE };
-    int gotLock = 0;
     int ii = 0;  // Loop iterator
     int jj = 0;  // Loop iterator
+    unsigned long long keyTime = 0;
     int matchFound = 0;
     int moveBlock = 1;
     int new_xvals[NUM_SQUARES_PER_BLOCK] = {0};
     int new_yvals[NUM_SQUARES_PER_BLOCK] = {0};
+    unsigned long long start = 0;
     int status = 0;
     
     switch (event)
     {
         case EVENT_COMMIT:
+
+            start = LatencyNow ();
+            keyTime = g_keyTime;  // 0 for a mouse click
+            g_keyTime = 0;
+            TRACE_BEGIN ("CB_BtnMoveLeft");
                         
             // Stop movement at the edge of the grid                 
             if ((block.position[0].x == 1) ||
@@ -245,6 +324,7 @@ int CVICALLBACK CB_BtnMoveLeft (int panel, int control, int event,
                 (block.position[2].x == 1) ||
                 (block.position[3].x == 1))
             {
+                TRACE_END ("CB_BtnMoveLeft");
                 break;
             }
                        
@@ -262,12 +342,15 @@ int CVICALLBACK CB_BtnMoveLeft (int panel, int control, int event,
             
             if (moveBlock == 0)
             {
+              TRACE_END ("CB_BtnMoveLeft");
               break;
             }
             
-            status = CmtGetLockEx (threadLock, 0, CMT_WAIT_FOREVER, &gotLock);
+            status = STAT_LOCK_GET (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnMoveLeft");
                 MessagePopup ("Error", "Unable to get thread lock.");
                 return -1;
             }  
@@ -319,13 +402,19 @@ int CVICALLBACK CB_BtnMoveLeft (int panel, int control, int event,
                 block.right_points[ii] = MakePoint (block.right_points[ii].x-1, block.right_points[ii].y);
             }
             
-            status = CmtReleaseLock (threadLock);
+            status = StatLockRelease (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnMoveLeft");
                 MessagePopup ("Error", "Unable to release thread lock.");
                 return -1;
             }    
 
+            LatencyRecord (LATENCY_STAGE_COMMAND, start);
+            RecordKeyInput (keyTime);
+            TRACE_END ("CB_BtnMoveLeft");
+
             break;
     }
     return 0;
@@ -337,18 +426,24 @@ int CVICALLBACK CB_BtnMoveRight (int panel, int control, int event,
                                  void *callbackData, int eventData1, int eventData2)
 {
     int colors[NUM_SQUARES_PER_BLOCK] = { VAL_WHITE, VAL_WHITE, VAL_WHITE, VAL_WHITE };
-    int gotLock = 0;
     int ii = 0;  // Loop iterator
     int jj = 0;  // Loop iterator
+    unsigned long long keyTime = 0;
     int matchFound = 0;
     int moveBlock = 1;
     int new_xvals[NUM_SQUARES_PER_BLOCK] = {0};
     int new_yvals[NUM_SQUARES_PER_BLOCK] = {0};
+    unsigned long long start = 0;
     int status = 0;
     
     switch (event)
     {
         case EVENT_COMMIT:            
+
+            start = LatencyNow ();
+            keyTime = g_keyTime;  // 0 for a mouse click
+            g_keyTime = 0;
+            TRACE_BEGIN ("CB_BtnMoveRight");
             
             // Stop movement at the edge of the grid            
             if ((block.position[0].x == GRID_NUM_COLS) ||
@@ -356,6 +451,7 @@ int CVICALLBACK CB_BtnMoveRight (int panel, int control, int event,
                 (block.position[2].x == GRID_NUM_COLS) ||
                 (block.position[3].x == GRID_NUM_COLS))
             {
+                TRACE_END ("CB_BtnMoveRight");
                 break;
             }
             
@@ -373,12 +469,15 @@ int CVICALLBACK CB_BtnMoveRight (int panel, int control, int event,
             
             if (moveBlock == 0)
             {
+              TRACE_END ("CB_BtnMoveRight");
               break;
             }
                 
-            status = CmtGetLockEx (threadLock, 0, CMT_WAIT_FOREVER, &gotLock);
+            status = STAT_LOCK_GET (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnMoveRight");
                 MessagePopup ("Error", "Unable to get thread lock.");
                 return -1;
             }            
@@ -430,13 +529,19 @@ int CVICALLBACK CB_BtnMoveRight (int panel, int control, int event,
                 block.right_points[ii] = MakePoint (block.right_points[ii].x+1, block.right_points[ii].y);
             }
             
-            status = CmtReleaseLock (threadLock);
+            status = StatLockRelease (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnMoveRight");
                 MessagePopup ("Error", "Unable to release thread lock.");
                 return -1;
             }    
 
+            LatencyRecord (LATENCY_STAGE_COMMAND, start);
+            RecordKeyInput (keyTime);
+            TRACE_END ("CB_BtnMoveRight");
+
             break;
     }
     return 0;
@@ -474,6 +579,7 @@ int CVICALLBACK CB_BtnPause (int panel, int control, int event,
             else
             {
                 SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_ENABLED, 1);
+                g_lastTick = 0.0;
                 
                 // Show block control buttons
                 SetCtrlAttribute (main_ph, PNLMAIN_BTNROTATECCW, ATTR_DIMMED, 0);
@@ -503,7 +609,20 @@ int CVICALLBACK CB_BtnQuit (int panel, int control, int event,
         case EVENT_COMMIT:
             SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_ENABLED, 0);
             QuitUserInterface (0);
-            CmtDiscardLock (threadLock);
+            MonteCarloDiscard ();
+            TRACE_WRITE (TRACE_FILE);
+            StatLockDiscard (&threadLock);
+            MetricsClose (g_metrics);
+            g_metrics = NULL;
+            
+            // A game left with Quit is not continued on the next start, only one cut short by a crash
+            if (g_autosave != NULL)
+            {
+                g_snapshot.game_status = GAME_END;
+                SnapshotWriterUpdate (g_autosave, &g_snapshot);
+            }
+            SnapshotWriterClose (g_autosave);
+            g_autosave = NULL;
             break;
     }
     return 0;
@@ -544,17 +663,25 @@ int CVICALLBACK CB_BtnRotateCCW (int panel, int control, int event,
 {
     char msg[512] = "\0";
     int colors[NUM_SQUARES_PER_BLOCK] = { VAL_WHITE, VAL_WHITE, VAL_WHITE, VAL_WHITE };
-    int gotLock = 0;
     int ii = 0;  // Loop iterator
+    unsigned long long keyTime = 0;
+    unsigned long long start = 0;
     int status = 0;
     
     switch (event)
     {
         case EVENT_COMMIT:
+
+            start = LatencyNow ();
+            keyTime = g_keyTime;  // 0 for a mouse click
+            g_keyTime = 0;
+            TRACE_BEGIN ("CB_BtnRotateCCW");
             
-            status = CmtGetLockEx (threadLock, 0, CMT_WAIT_FOREVER, &gotLock);
+            status = STAT_LOCK_GET (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnRotateCCW");
                 MessagePopup ("Error", "Unable to get thread lock.");
                 return -1;
             }            
@@ -877,10 +1004,14 @@ int CVICALLBACK CB_BtnRotateCCW (int panel, int control, int event,
                     
                     if (block.orientation == ORIENTATION_1)
                     {
-                        // No need to check for grid edge clearances for this orientation
+                        // Check for grid edge clearances
+                        if (block.position[2].y == GRID_NUM_ROWS)
+                        {
+                            break;
+                        }
                         
                         // Check for clearances around other blocks
-                        GetTableCellAttribute (main_ph, PNLMAIN_GRID, MakePoint (block.position[2].x, block.position[2].y-1), 
+                        GetTableCellAttribute (main_ph, PNLMAIN_GRID, MakePoint (block.position[2].x, block.position[2].y+1), 
                                                ATTR_TEXT_BGCOLOR, &colors[0]); 
                         if (colors[0] != VAL_WHITE)
                         {
@@ -1027,14 +1158,23 @@ int CVICALLBACK CB_BtnRotateCCW (int panel, int control, int event,
                 SetTableCellAttribute (main_ph, PNLMAIN_GRID, block.position[ii], ATTR_TEXT_BGCOLOR, block.color);
             }     
             
-            status = CmtReleaseLock (threadLock);
+            status = StatLockRelease (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnRotateCCW");
                 MessagePopup ("Error", "Unable to release thread lock.");
                 return -1;
             }       
             
-            PlaySound (SFX_ROTATE, NULL, SND_FILENAME | SND_ASYNC); 
+            TRACE_BEGIN ("PlaySound");
+            PlaySound (SFX_ROTATE, NULL, SND_FILENAME | SND_ASYNC);
+            TRACE_END ("PlaySound");
+            g_counters.sounds++;
+
+            LatencyRecord (LATENCY_STAGE_COMMAND, start);
+            RecordKeyInput (keyTime);
+            TRACE_END ("CB_BtnRotateCCW");
 
             break;
     }
@@ -1048,17 +1188,25 @@ int CVICALLBACK CB_BtnRotateCW (int panel, int control, int event,
 {
     char msg[512] = "\0";
     int colors[NUM_SQUARES_PER_BLOCK] = { VAL_WHITE, VAL_WHITE, VAL_WHITE, VAL_WHITE };
-    int gotLock = 0;
     int ii = 0;  // Loop iterator
+    unsigned long long keyTime = 0;
+    unsigned long long start = 0;
     int status = 0;
     
     switch (event)
     {
         case EVENT_COMMIT:
+
+            start = LatencyNow ();
+            keyTime = g_keyTime;  // 0 for a mouse click
+            g_keyTime = 0;
+            TRACE_BEGIN ("CB_BtnRotateCW");
             
-            status = CmtGetLockEx (threadLock, 0, CMT_WAIT_FOREVER, &gotLock);
+            status = STAT_LOCK_GET (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnRotateCW");
                 MessagePopup ("Error", "Unable to get thread lock.");
                 return -1;
             }            
@@ -1541,7 +1689,11 @@ int CVICALLBACK CB_BtnRotateCW (int panel, int control, int event,
                     
                     if (block.orientation == ORIENTATION_1)
                     {
-                        // No need to check for grid edge clearances for this orientation
+                        // Check for grid edge clearances
+                        if (block.position[2].y == GRID_NUM_ROWS)
+                        {
+                            break;
+                        }
                         
                         // Check for clearances around other blocks
                         GetTableCellAttribute (main_ph, PNLMAIN_GRID, MakePoint (block.position[2].x, block.position[2].y+1), 
@@ -1767,14 +1919,23 @@ int CVICALLBACK CB_BtnRotateCW (int panel, int control, int event,
                 SetTableCellAttribute (main_ph, PNLMAIN_GRID, block.position[ii], ATTR_TEXT_BGCOLOR, block.color);
             }     
             
-            status = CmtReleaseLock (threadLock);
+            status = StatLockRelease (&threadLock);
             if (status != 0)
             {
+                LatencyRecord (LATENCY_STAGE_COMMAND, start);
+                TRACE_END ("CB_BtnRotateCW");
                 MessagePopup ("Error", "Unable to release thread lock.");
                 return -1;
             }       
             
-            PlaySound (SFX_ROTATE, NULL, SND_FILENAME | SND_ASYNC); 
+            TRACE_BEGIN ("PlaySound");
+            PlaySound (SFX_ROTATE, NULL, SND_FILENAME | SND_ASYNC);
+            TRACE_END ("PlaySound");
+            g_counters.sounds++;
+
+            LatencyRecord (LATENCY_STAGE_COMMAND, start);
+            RecordKeyInput (keyTime);
+            TRACE_END ("CB_BtnRotateCW");
 
             break;
     }
@@ -1791,6 +1952,7 @@ int CVICALLBACK CB_BtnStart (int panel, int control, int event,
         case EVENT_COMMIT:
 
             ClearGrid ();     
+            SnapshotReset (&g_snapshot);
             
             // Clear log
             DeleteTextBoxLines (main_ph, PNLMAIN_TEXTLOG, 0, -1);
@@ -1811,6 +1973,7 @@ int CVICALLBACK CB_BtnStart (int panel, int control, int event,
             
             SetCtrlVal (main_ph, PNLMAIN_LEVEL, 1);
             SetCtrlVal (main_ph, PNLMAIN_NUMCLEARED, 0);
+            g_counters.level = 1;
             
             SpawnBlock (FIRST_BLOCK_YES);
             
@@ -1820,6 +1983,7 @@ int CVICALLBACK CB_BtnStart (int panel, int control, int event,
             
             // Start advancing blocks
             SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_ENABLED, 1);
+            g_lastTick = 0.0;
             
             SetActiveCtrl (main_ph, PNLMAIN_BTNPAUSE);
 
@@ -1833,6 +1997,8 @@ int CVICALLBACK CB_BtnStart (int panel, int control, int event,
 int CVICALLBACK CB_KeyDown (int panelHandle, int message, unsigned int* wParam, 
                             unsigned int* lParam, void* callbackData)
 {
+    unsigned long long start = LatencyNow ();  // Arrival of the key press
+
     // Monitor down-arrow key for press
     if ((g_keydown == 0) && (*wParam == VK_DOWN))
     {      
@@ -1843,16 +2009,42 @@ int CVICALLBACK CB_KeyDown (int panelHandle, int message, unsigned int* wParam,
 
         g_keydown = 1;
     }   
+    // Monitor for moves and the up-arrow rotation, the buttons run them next as their shortcut keys
+    else if ((*wParam == VK_LEFT) || (*wParam == VK_RIGHT) || (*wParam == VK_UP))
+    {
+        g_keyTime = start;
+        return 0;
+    }
     // Monitor for CCW rotation
     else if ((g_keydown == 0) && ((*wParam == 'Z') || (*wParam == VK_CONTROL)))
     {
+        g_keyTime = start;
         CallCtrlCallback (main_ph, PNLMAIN_BTNROTATECCW, EVENT_COMMIT, 0, 0, 0);            
     }
     // Monitor for CW rotation
     else if ((g_keydown == 0) && (*wParam == 'X'))
     {
+        g_keyTime = start;
         CallCtrlCallback (main_ph, PNLMAIN_BTNROTATECW, EVENT_COMMIT, 0, 0, 0);            
     }    
+    // Monitor for placement hint, the rollouts are not input latency
+    else if ((g_keydown == 0) && (*wParam == 'H'))
+    {
+        ShowHint ();
+    }
+    // Monitor for latency dump
+    else if (*wParam == VK_F2)
+    {
+        return DumpLatency ();
+    }
+    // Monitor for latency overlay
+    else if (*wParam == VK_F3)
+    {
+        return ToggleLatencyOverlay ();
+    }
+    
+    // The rotation callbacks have run, a blocked one changed nothing and is not recorded
+    g_keyTime = 0;
     
     return 0;
 }  // End of CB_KeyDown()
@@ -1878,10 +2070,31 @@ int CVICALLBACK CB_KeyUp (int panelHandle, int message, unsigned int* wParam,
 int CVICALLBACK CB_TimerAdvanceBlock (int panel, int control, int event,
                                       void *callbackData, int eventData1, int eventData2)
 {
+    double due = 0.0;
+    static double lastInterval = 0.0;
+    double interval = 0.0;
+    double now = 0.0;
+    
     switch (event)
     {
         case EVENT_TIMER_TICK:
+            
+            // A tick due one interval ago or earlier means a dropped frame. The longer of both intervals
+            // covers a soft drop starting or ending in between.
+            now = Timer ();
+            GetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_INTERVAL, &interval);
+            due = (lastInterval > interval) ? lastInterval : interval;
+            if ((g_lastTick > 0.0) && (now - g_lastTick >= due + interval))
+            {
+                g_counters.frame_drops++;
+            }
+            g_lastTick = now;
+            lastInterval = interval;
+            
             AdvanceBlock ();
+            DrawGrid (0);
+            PublishMetrics (g_counters.game_status == GAME_END);
+            UpdateAutosave ();
             break;
     }
     
@@ -1903,6 +2116,8 @@ int CheckForLineClears (void)
     int numLineClearsTotal = 0;
     int numLineClears = 0;
     
+    TRACE_BEGIN ("CheckForLineClears");
+    
     sprintf (msg, "Line check start\n");
     SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, msg);    
     
@@ -1946,11 +2161,17 @@ int CheckForLineClears (void)
     {
         if (numLineClears == 4)
         {            
-            PlaySound (SFX_CLEAR_4LINES, NULL, SND_FILENAME | SND_ASYNC);     
+            TRACE_BEGIN ("PlaySound");
+            PlaySound (SFX_CLEAR_4LINES, NULL, SND_FILENAME | SND_ASYNC);
+            TRACE_END ("PlaySound");
+            g_counters.sounds++;
         }
         else
         {
+            TRACE_BEGIN ("PlaySound");
             PlaySound (SFX_CLEAR_LINE, NULL, SND_FILENAME | SND_ASYNC);
+            TRACE_END ("PlaySound");
+            g_counters.sounds++;
         }
         
         // Begin loop through all rows to be cleared
@@ -1987,10 +2208,12 @@ int CheckForLineClears (void)
     GetCtrlVal (main_ph, PNLMAIN_NUMCLEARED, &numLineClearsTotal);    
     numLineClearsTotal += numLineClears;    
     SetCtrlVal (main_ph, PNLMAIN_NUMCLEARED, numLineClearsTotal);
+    g_counters.lines += numLineClears;
     
     // Update level
     level = (numLineClearsTotal / 10) + 1;
     SetCtrlVal (main_ph, PNLMAIN_LEVEL, level);
+    g_counters.level = level;
     
     // Update block speed
     g_speed = NORMAL_SPEED - ((level - 1) * LEVEL_SPEEDUP);
@@ -1999,6 +2222,8 @@ int CheckForLineClears (void)
     sprintf (msg, "Line check done\n");
     SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, msg);
     
+    TRACE_END ("CheckForLineClears");
+    
     return 0;
     
 }  // End of CheckForLineClears()
@@ -2028,14 +2253,19 @@ int SpawnBlock (int first_block)
     int game_status = GAME_RUN;
     int ii = 0;  // Loop iterator    
       
+    TRACE_BEGIN ("SpawnBlock");
+    
+    // Start pseudo randomly, also when the first block is selected for debug
+    if (first_block == FIRST_BLOCK_YES)
+    {
+        RngSeed (&g_rng, (unsigned long long)time (NULL));
+    }
+    
     // Random first block
     if ((first_block == FIRST_BLOCK_YES) && (g_startBlock == BLOCK_RANDOM))
     {   
-        // Start pseudo randomly
-        srand (time (NULL));  
-        
         // Avoid S and Z blocks on the first block
-        block_index = rand () % (NUM_BLOCKS_TYPES - 2);
+        block_index = RngRange (&g_rng, NUM_BLOCKS_TYPES - 2);
     }
     // Selective first block, for debug purposes
     else if (first_block == FIRST_BLOCK_YES)
@@ -2064,6 +2294,7 @@ int SpawnBlock (int first_block)
                 block_index = 6;
                 break;                   
             default:
+                TRACE_END ("SpawnBlock");
                 MessagePopup ("Error", "Unknown start block");
                 return -1; 
         }
@@ -2072,7 +2303,7 @@ int SpawnBlock (int first_block)
     else
     {
         // Generate a random block
-        block_index = rand () % NUM_BLOCKS_TYPES;
+        block_index = RngRange (&g_rng, NUM_BLOCKS_TYPES);
     }
     block.type = blocks[block_index];
 
@@ -2252,6 +2483,350 @@ int SpawnBlock (int first_block)
         SetTableCellAttribute (main_ph, PNLMAIN_GRID, block.position[ii], ATTR_TEXT_BGCOLOR, block.color);
     }    
     
+    g_counters.pieces++;
+    g_counters.game_status = game_status;
+    
+    TRACE_END ("SpawnBlock");
+    
     return game_status;
     
-}  // End of SpawnBlock()
\ No newline at end of file
+}  // End of SpawnBlock()
+
+
+static int DrawGrid (unsigned long long input_time)
+{
+    static double lastOverlay = 0.0;
+    unsigned long long start = LatencyNow ();
+    char text[1024] = "\0";
+
+    // Draw now instead of when the callback returns, so the time is measured
+    ProcessDrawEvents ();
+
+    LatencyRecord (LATENCY_STAGE_RENDER, start);
+    if (input_time != 0)
+    {
+        LatencyRecord (LATENCY_STAGE_INPUT_RENDER, input_time);
+    }
+
+    if ((g_latencyOverlay > 0) && (Timer () - lastOverlay >= LATENCY_OVERLAY_PERIOD))
+    {
+        LatencyFormat (text, sizeof (text));
+        SetCtrlVal (main_ph, g_latencyOverlay, text);
+        lastOverlay = Timer ();
+    }
+
+    return 0;
+
+}  // End of DrawGrid()
+
+
+static int DumpLatency (void)
+{
+    FILE *file = NULL;
+    char msg[4096] = "\0";
+
+    // Microseconds
+    LatencyFormat (msg, sizeof (msg));
+    SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, msg);
+
+    if (LatencyDump (LATENCY_DUMP_FILE) != 0)
+    {
+        SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, "Unable to write " LATENCY_DUMP_FILE "\n");
+        return -1;
+    }
+
+    // Which callbacks hold the game lock, and for how long
+    StatLockFormat (&threadLock, msg, sizeof (msg));
+    SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, msg);
+
+    file = fopen (LATENCY_DUMP_FILE, "a");
+    if (file != NULL)
+    {
+        fprintf (file, "\n%s", msg);
+        fclose (file);
+    }
+
+    SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, "Latency histograms written to " LATENCY_DUMP_FILE "\n");
+
+    return 0;
+
+}  // End of DumpLatency()
+
+
+static int GetGameState (gameData *game)
+{
+    int color = VAL_WHITE;
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    packedPiece packed = g_noPiece;
+    int status = 0;
+
+    memset (game, 0, sizeof (gameData));
+
+    status = STAT_LOCK_GET (&threadLock);
+    if (status != 0)
+    {
+        MessagePopup ("Error", "Unable to get thread lock.");
+        return -1;
+    }
+
+    // Copy the grid colors into row masks
+    for (ii=1; ii<=GRID_NUM_ROWS; ii++)
+    {
+        for (jj=1; jj<=GRID_NUM_COLS; jj++)
+        {
+            GetTableCellAttribute (main_ph, PNLMAIN_GRID, MakePoint (jj, ii), ATTR_TEXT_BGCOLOR, &color);
+            if (color != VAL_WHITE)
+            {
+                game->board.rows[ii-1] |= (unsigned short)(1 << (jj-1));
+            }
+        }
+    }
+
+    // Remove the active block from the grid, only its packed state is kept. There is no active block
+    // before the first game or after RestoreGame() found none, and the game is reported as ended.
+    if (BlockPack (&block, &packed) == 0)
+    {
+        for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+        {
+            if ((block.position[ii].x >= 1) && (block.position[ii].x <= GRID_NUM_COLS) &&
+                (block.position[ii].y >= 1) && (block.position[ii].y <= GRID_NUM_ROWS))
+            {
+                game->board.rows[block.position[ii].y-1] &= (unsigned short)~(1 << (block.position[ii].x-1));
+            }
+        }
+    }
+    PieceUnpack (packed, &game->piece);
+
+    status = StatLockRelease (&threadLock);
+    if (status != 0)
+    {
+        MessagePopup ("Error", "Unable to release thread lock.");
+        return -1;
+    }
+
+    GetCtrlVal (main_ph, PNLMAIN_NUMCLEARED, &game->lines);
+    GetCtrlVal (main_ph, PNLMAIN_LEVEL, &game->level);
+    game->game_status = (game->piece.type_index < 0) ? GAME_END : GAME_RUN;
+
+    return 0;
+
+}  // End of GetGameState()
+
+
+static int PublishMetrics (int force)
+{
+    const latencyHistogram *histogram = NULL;
+    int ii = 0;  // Loop iterator
+    static double lastPublish = 0.0;
+    metricsStage *stage = NULL;
+
+    if ((g_metrics == NULL) || ((force == 0) && (Timer () - lastPublish < METRICS_PUBLISH_PERIOD)))
+    {
+        return 0;
+    }
+
+    for (ii=0; ii<LATENCY_NUM_STAGES; ii++)
+    {
+        histogram = LatencyStage (ii);
+        stage = &g_counters.stages[ii];
+        stage->count = histogram->count;
+        stage->p50_ns = LatencyHistogramPercentile (histogram, 50.0);
+        stage->p99_ns = LatencyHistogramPercentile (histogram, 99.0);
+        stage->max_ns = histogram->max_ns;
+        stage->sum_ns = histogram->sum_ns;
+    }
+    g_counters.update_time = (double)time (NULL);
+
+    // A plain memory copy, monitors never make the game wait
+    MetricsPublish (g_metrics, &g_counters);
+    lastPublish = Timer ();
+
+    return 0;
+
+}  // End of PublishMetrics()
+
+
+static int RecordKeyInput (unsigned long long key_time)
+{
+    // Mouse clicks are not timed from a key press
+    if (key_time == 0)
+    {
+        return 0;
+    }
+
+    LatencyRecord (LATENCY_STAGE_INPUT, key_time);
+    DrawGrid (key_time);
+
+    return 0;
+
+}  // End of RecordKeyInput()
+
+
+static int RestoreGame (void)
+{
+    int ii = 0;  // Loop iterator
+    int jj = 0;  // Loop iterator
+    snapshotData snapshot;
+
+    // Only a game that was still running when it was last saved
+    if ((SnapshotRead (SNAPSHOT_DEFAULT_FILE, &snapshot) != 0) || (snapshot.game_status != GAME_RUN) ||
+        (snapshot.speed <= 0.0) || (BlockUnpack (snapshot.piece, &block) != 0))
+    {
+        memset (&block, 0, sizeof (blockData));
+        return -1;
+    }
+
+    g_snapshot = snapshot;
+    g_rng = snapshot.rng;
+
+    ClearGrid ();
+    for (ii=0; ii<GRID_NUM_ROWS; ii++)
+    {
+        for (jj=0; jj<GRID_NUM_COLS; jj++)
+        {
+            if (snapshot.cells[ii][jj] != 0)
+            {
+                SetTableCellAttribute (main_ph, PNLMAIN_GRID, MakePoint (jj+1, ii+1), ATTR_TEXT_BGCOLOR, 
+                                       BlockColor (snapshot.cells[ii][jj] - 1));
+            }
+        }
+    }
+    for (ii=0; ii<NUM_SQUARES_PER_BLOCK; ii++)
+    {
+        SetTableCellAttribute (main_ph, PNLMAIN_GRID, block.position[ii], ATTR_TEXT_BGCOLOR, block.color);
+    }
+
+    // Same as CB_BtnStart(), without a new block
+    SetCtrlAttribute (main_ph, PNLMAIN_GRID, ATTR_DIMMED, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_TEXTGAMEOVER, ATTR_VISIBLE, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNPAUSE, ATTR_DIMMED, 0); 
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNROTATECCW, ATTR_DIMMED, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNROTATECW, ATTR_DIMMED, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNLEFT, ATTR_DIMMED, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNRIGHT, ATTR_DIMMED, 0);
+    SetCtrlAttribute (main_ph, PNLMAIN_BTNDOWN, ATTR_DIMMED, 0);
+
+    SetCtrlVal (main_ph, PNLMAIN_LEVEL, snapshot.level);
+    SetCtrlVal (main_ph, PNLMAIN_NUMCLEARED, snapshot.lines);
+    g_counters.level = snapshot.level;
+    g_counters.lines = snapshot.lines;
+    g_counters.pieces = snapshot.pieces + 1;  // The active block was spawned too
+    g_counters.game_status = GAME_RUN;
+
+    g_speed = snapshot.speed;
+    SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_INTERVAL, g_speed);
+    SetCtrlAttribute (main_ph, PNLMAIN_TIMERADVANCE, ATTR_ENABLED, 1);
+    g_lastTick = 0.0;
+
+    SetActiveCtrl (main_ph, PNLMAIN_BTNPAUSE);
+    SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, "Game restored\n");
+
+    return 0;
+
+}  // End of RestoreGame()
+
+
+static int ShowHint (void)
+{
+    int best_index = -1;
+    mcConfig config;
+    gameData game;
+    char msg[512] = "\0";
+    mcResult results[MAX_PLACEMENTS];
+
+    // No active block before the first game
+    if ((GetGameState (&game) != 0) || (game.game_status == GAME_END))
+    {
+        return 0;
+    }
+
+    MonteCarloDefaultConfig (&config);
+    MonteCarloEvaluate (&game, &config, results, &best_index);
+    if (best_index < 0)
+    {
+        return 0;
+    }
+
+    sprintf (msg, "Hint: orientation %d, column %d (survival %.0f%% +/- %.0f%%, lines %.2f +/- %.2f, %d rollouts)\n",
+             results[best_index].placement.orientation + 1, results[best_index].placement.x + 1,
+             100.0 * results[best_index].survival, 100.0 * results[best_index].survival_ci,
+             results[best_index].lines, results[best_index].lines_ci, results[best_index].rollouts);
+    SetCtrlVal (main_ph, PNLMAIN_TEXTLOG, msg);
+
+    return 0;
+
+}  // End of ShowHint()
+
+
+static int ToggleLatencyOverlay (void)
+{
+    int left = 0;
+    char text[1024] = "\0";
+    int top = 0;
+
+    if (g_latencyOverlay > 0)
+    {
+        DiscardCtrl (main_ph, g_latencyOverlay);
+        g_latencyOverlay = 0;
+        return 0;
+    }
+
+    // Over the top left corner of the grid
+    GetCtrlAttribute (main_ph, PNLMAIN_GRID, ATTR_TOP, &top);
+    GetCtrlAttribute (main_ph, PNLMAIN_GRID, ATTR_LEFT, &left);
+
+    g_latencyOverlay = NewCtrl (main_ph, CTRL_TEXT_MSG, "", top, left);
+    if (g_latencyOverlay < 0)
+    {
+        g_latencyOverlay = 0;
+        return -1;
+    }
+
+    SetCtrlAttribute (main_ph, g_latencyOverlay, ATTR_TEXT_FONT, "Courier New");
+    SetCtrlAttribute (main_ph, g_latencyOverlay, ATTR_TEXT_COLOR, VAL_GREEN);
+    SetCtrlAttribute (main_ph, g_latencyOverlay, ATTR_TEXT_BGCOLOR, VAL_BLACK);
+
+    LatencyFormat (text, sizeof (text));
+    SetCtrlVal (main_ph, g_latencyOverlay, text);
+
+    return 0;
+
+}  // End of ToggleLatencyOverlay()
+
+
+static int UpdateAutosave (void)
+{
+    int status = 0;
+
+    if (g_autosave == NULL)
+    {
+        return 0;
+    }
+
+    status = STAT_LOCK_GET (&threadLock);
+    if (status != 0)
+    {
+        MessagePopup ("Error", "Unable to get thread lock.");
+        return -1;
+    }
+
+    BlockPack (&block, &g_snapshot.piece);
+
+    status = StatLockRelease (&threadLock);
+    if (status != 0)
+    {
+        MessagePopup ("Error", "Unable to release thread lock.");
+        return -1;
+    }
+
+    g_snapshot.rng = g_rng;
+    g_snapshot.game_status = g_counters.game_status;
+    g_snapshot.speed = g_speed;
+
+    // A plain memory copy, the autosave thread writes the file
+    SnapshotWriterUpdate (g_autosave, &g_snapshot);
+
+    return 0;
+
+}  // End of UpdateAutosave()
@@ -18,6 +18,7 @@ char *void;
 //==============================================================================
 // Include files
 
+#ifdef _CVI_
 #include "windows.h"
 #include <mmsystem.h>
 #include "cvidef.h"
@@ -27,6 +28,9 @@ char *void;
 #include <utility.h>
 #include "toolbox.h"
 #include "cvi_blockdrop_UIR.h"
+#else
+#include "blockdrop_platform.h"  // Headless builds without CVI, e.g. the Linux regression gate
+#endif
 
 //==============================================================================
 // Constants